@@ -0,0 +1,124 @@
+#include <bench/bench.hpp>
+#include <djson/json.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <span>
+
+namespace bench {
+namespace {
+auto get_benches() -> std::vector<Bench*>& {
+	static auto ret = std::vector<Bench*>{};
+	return ret;
+}
+
+auto matches(std::string_view const name, std::string_view const filter) -> bool { return filter.empty() || name.find(filter) != std::string_view::npos; }
+
+struct Options {
+	std::string_view filter{};
+	std::string_view json_path{};
+	std::size_t warmup{Context::warmup_v};
+	std::size_t iterations{Context::iterations_v};
+
+	static auto parse(std::span<char const* const> args) -> std::optional<Options> {
+		auto ret = Options{};
+		auto const parse_count = [](char const* arg, std::size_t& out) {
+			if (arg == nullptr) { return false; }
+			auto const text = std::string_view{arg};
+			auto const [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+			return ec == std::errc{} && ptr == text.data() + text.size();
+		};
+		for (std::size_t i = 0; i < args.size(); ++i) {
+			auto const arg = std::string_view{args[i]};
+			auto const* next = i + 1 < args.size() ? args[i + 1] : nullptr;
+			if (arg == "--warmup") {
+				if (!parse_count(next, ret.warmup)) { return {}; }
+				++i;
+			} else if (arg == "--iterations") {
+				if (!parse_count(next, ret.iterations) || ret.iterations == 0) { return {}; }
+				++i;
+			} else if (arg == "--json") {
+				if (next == nullptr) { return {}; }
+				ret.json_path = next;
+				++i;
+			} else if (arg.starts_with("--") || !ret.filter.empty()) {
+				return {};
+			} else {
+				ret.filter = arg;
+			}
+		}
+		return ret;
+	}
+};
+
+auto to_json(dj::Json& out, Sample const& sample) -> void {
+	out["label"] = sample.label;
+	out["median_us"] = sample.median.count();
+	out["p99_us"] = sample.p99.count();
+	out["min_us"] = sample.min.count();
+	out["max_us"] = sample.max.count();
+	out["iterations"] = sample.iterations;
+}
+} // namespace
+
+Bench::Bench() { get_benches().push_back(this); }
+
+auto Context::record(std::string_view const label, std::vector<Duration> durations) -> Sample const& {
+	auto ret = Sample{.label = std::string{label}, .iterations = durations.size()};
+	if (!durations.empty()) {
+		std::sort(durations.begin(), durations.end());
+		auto const p99 = static_cast<std::size_t>(std::ceil(0.99 * static_cast<double>(durations.size())));
+		ret.median = durations[durations.size() / 2];
+		ret.p99 = durations[std::clamp(p99, std::size_t{1}, durations.size()) - 1];
+		ret.min = durations.front();
+		ret.max = durations.back();
+	}
+	std::cout << std::format("  {:<48} median: {:>12.2f}us  p99: {:>12.2f}us  min: {:>12.2f}us  max: {:>12.2f}us\n", ret.label, ret.median.count(),
+							 ret.p99.count(), ret.min.count(), ret.max.count());
+	return m_samples.emplace_back(std::move(ret));
+}
+} // namespace bench
+
+// usage: le-bench [filter] [--warmup <count>] [--iterations <count>] [--json <path>]
+auto main(int argc, char** argv) -> int {
+	auto const args = std::span{argv, static_cast<std::size_t>(argc)}; // NOLINT
+	auto const options = bench::Options::parse(args.subspan(std::min(args.size(), std::size_t{1})));
+	if (!options) {
+		std::cerr << "usage: le-bench [filter] [--warmup <count>] [--iterations <count>] [--json <path>]\n";
+		return EXIT_FAILURE;
+	}
+
+	auto json = dj::Json{};
+	auto& out_benches = json["benches"];
+	for (auto const* bench : bench::get_benches()) {
+		if (!bench::matches(bench->get_name(), options->filter)) { continue; }
+		std::cout << std::format("[{}]\n", bench->get_name());
+		auto context = bench::Context{};
+		context.warmup = options->warmup;
+		context.iterations = options->iterations;
+		bench->run(context);
+
+		auto out_bench = dj::Json{};
+		out_bench["name"] = bench->get_name();
+		auto& out_samples = out_bench["samples"];
+		for (auto const& sample : context.get_samples()) {
+			auto out_sample = dj::Json{};
+			bench::to_json(out_sample, sample);
+			out_samples.push_back(std::move(out_sample));
+		}
+		out_benches.push_back(std::move(out_bench));
+	}
+
+	if (!options->json_path.empty()) {
+		auto const path = std::string{options->json_path};
+		if (!json.to_file(path.c_str())) {
+			std::cerr << std::format("failed to write '{}'\n", path);
+			return EXIT_FAILURE;
+		}
+		std::cout << std::format("results written to '{}'\n", path);
+	}
+}
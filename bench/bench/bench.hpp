@@ -0,0 +1,92 @@
+#pragma once
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bench {
+using Clock = std::chrono::steady_clock;
+using Duration = std::chrono::duration<double, std::micro>;
+
+///
+/// \brief Timing summary of one measured label.
+///
+struct Sample {
+	std::string label{};
+	Duration median{};
+	Duration p99{};
+	Duration min{};
+	Duration max{};
+	std::size_t iterations{};
+};
+
+///
+/// \brief Runs and records measurements for a Bench.
+///
+class Context {
+  public:
+	static constexpr std::size_t warmup_v{3};
+	static constexpr std::size_t iterations_v{21};
+
+	std::size_t warmup{warmup_v};
+	std::size_t iterations{iterations_v};
+
+	///
+	/// \brief Run func warmup times, then time it iterations times.
+	/// \param label Name of this measurement
+	/// \param func Callable to measure
+	///
+	template <typename FuncT>
+	auto measure(std::string_view const label, FuncT func) -> Sample const& {
+		for (std::size_t i = 0; i < warmup; ++i) { func(); }
+		auto durations = std::vector<Duration>{};
+		durations.reserve(iterations);
+		for (std::size_t i = 0; i < iterations; ++i) {
+			auto const start = Clock::now();
+			func();
+			durations.emplace_back(Clock::now() - start);
+		}
+		return record(label, std::move(durations));
+	}
+
+	[[nodiscard]] auto get_samples() const -> std::vector<Sample> const& { return m_samples; }
+
+  private:
+	auto record(std::string_view label, std::vector<Duration> durations) -> Sample const&;
+
+	std::vector<Sample> m_samples{};
+};
+
+class Bench {
+  public:
+	Bench();
+	Bench(Bench const&) = default;
+	Bench(Bench&&) = default;
+	auto operator=(Bench const&) -> Bench& = default;
+	auto operator=(Bench&&) -> Bench& = default;
+
+	virtual ~Bench() = default;
+
+	[[nodiscard]] virtual auto get_name() const -> std::string_view = 0;
+	virtual void run(Context& context) const = 0;
+};
+
+///
+/// \brief Prevent the optimizer from discarding value.
+///
+template <typename Type>
+void do_not_optimize(Type const& value) {
+	// NOLINTNEXTLINE
+	static Type const* volatile s_sink{};
+	s_sink = &value;
+}
+} // namespace bench
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define ADD_BENCH(Class)                                                                                                                                       \
+	struct Bench_##Class : ::bench::Bench {                                                                                                                    \
+		void run(::bench::Context& context) const final;                                                                                                       \
+		auto get_name() const -> std::string_view final { return #Class; }                                                                                     \
+	};                                                                                                                                                         \
+	inline Bench_##Class const g_bench_##Class{};                                                                                                              \
+	inline void Bench_##Class::run([[maybe_unused]] ::bench::Context& context) const
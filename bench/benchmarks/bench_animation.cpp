@@ -0,0 +1,75 @@
+#include <bench/bench.hpp>
+#include <le/graphics/animation/animation.hpp>
+#include <format>
+#include <vector>
+
+namespace {
+using namespace le;
+using namespace le::graphics;
+
+constexpr auto character_count_v = std::size_t{200};
+constexpr auto joint_count_v = std::size_t{64};
+constexpr auto keyframe_count_v = std::size_t{60};
+constexpr auto frame_dt_v = Duration{1.0f / 60.0f};
+
+auto make_skeleton() -> NodeTree {
+	auto ret = NodeTree{};
+	auto parent = std::optional<Id<Node>>{};
+	for (std::size_t i = 0; i < joint_count_v; ++i) {
+		// a spine with a branch every 4 joints.
+		auto const id = ret.add({.name = std::format("joint_{}", i), .parent = parent}).id();
+		if (i % 4 != 3) { parent = id; }
+	}
+	return ret;
+}
+
+// a translate, rotate, and scale channel per joint.
+auto make_animation() -> Animation {
+	auto ret = Animation{};
+	for (std::size_t i = 0; i < joint_count_v; ++i) {
+		auto translate = Animation::Translate{};
+		auto rotate = Animation::Rotate{};
+		auto scale = Animation::Scale{};
+		for (std::size_t k = 0; k < keyframe_count_v; ++k) {
+			auto const key = static_cast<float>(k);
+			auto const timestamp = Duration{(key + 1.0f) / 30.0f};
+			translate.keyframes.push_back({.value = {0.0f, key * 0.01f, 0.0f}, .timestamp = timestamp});
+			rotate.keyframes.push_back({.value = glm::angleAxis(0.05f * key, glm::vec3{1.0f, 0.0f, 0.0f}), .timestamp = timestamp});
+			scale.keyframes.push_back({.value = glm::vec3{1.0f + 0.001f * key}, .timestamp = timestamp});
+		}
+		ret.channels.push_back({.joint_id = i, .storage = std::move(translate)});
+		ret.channels.push_back({.joint_id = i, .storage = std::move(rotate)});
+		ret.channels.push_back({.joint_id = i, .storage = std::move(scale)});
+	}
+	return ret;
+}
+
+// a frame of character_count_v characters playing the same clip, each at its own time.
+ADD_BENCH(AnimationCrowd) {
+	auto const animation = make_animation();
+	auto trees = std::vector<NodeTree>(character_count_v, make_skeleton());
+	auto elapsed = std::vector<Duration>(character_count_v);
+	auto const duration = animation.duration();
+	auto const advance = [&](std::size_t const index) {
+		elapsed[index] += frame_dt_v;
+		if (elapsed[index] >= duration) { elapsed[index] = {}; }
+		return elapsed[index];
+	};
+	auto const label = std::format("[{} x {} channels]", character_count_v, animation.channels.size());
+
+	context.measure(std::format("update(NodeLocator) {}", label), [&] {
+		for (std::size_t i = 0; i < trees.size(); ++i) { animation.update(trees[i], advance(i)); }
+	});
+
+	auto cursors = std::vector<std::vector<KeyframeCursor>>(character_count_v, std::vector<KeyframeCursor>(animation.channels.size()));
+	context.measure(std::format("update(NodeLocator, cursors) {}", label), [&] {
+		for (std::size_t i = 0; i < trees.size(); ++i) { animation.update(trees[i], advance(i), cursors[i]); }
+	});
+
+	auto bindings = std::vector<Animation::Binding>{};
+	for (auto& tree : trees) { bindings.push_back(animation.bind(tree)); }
+	context.measure(std::format("Binding::update() {}", label), [&] {
+		for (std::size_t i = 0; i < bindings.size(); ++i) { bindings[i].update(advance(i)); }
+	});
+}
+} // namespace
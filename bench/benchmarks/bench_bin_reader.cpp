@@ -0,0 +1,47 @@
+#include <bench/bench.hpp>
+#include <le/resources/bin_data.hpp>
+#include <le/resources/primitive_asset.hpp>
+#include <array>
+#include <format>
+
+namespace {
+using namespace le;
+using namespace le::graphics;
+
+constexpr auto vertex_counts_v = std::array<std::size_t, 2>{1024, 256 * 1024};
+
+// mirrors PrimitiveAsset::try_load(), minus file IO and GPU upload.
+auto unpack(std::span<std::byte const> bytes, Geometry& out) -> bool {
+	auto reader = BinReader{bytes};
+	auto sign = BinSign{};
+	if (!reader.read<BinSign>({&sign, 1})) { return false; }
+	auto count = std::uint64_t{};
+	if (!reader.read(std::span{&count, 1})) { return false; }
+	out.vertices.resize(count);
+	if (!reader.read(std::span{out.vertices})) { return false; }
+	if (!reader.read(std::span{&count, 1})) { return false; }
+	out.indices.resize(count);
+	if (!reader.read(std::span{out.indices})) { return false; }
+	if (!reader.read(std::span{&count, 1})) { return false; }
+	out.bones.resize(count);
+	return reader.read(std::span{out.bones});
+}
+
+ADD_BENCH(BinReader) {
+	auto sum = std::size_t{};
+	for (auto const count : vertex_counts_v) {
+		auto geometry = Geometry{};
+		geometry.vertices.resize(count);
+		geometry.indices.resize(count * 3 / 2);
+		geometry.bones.resize(count);
+		auto bytes = std::vector<std::byte>{};
+		PrimitiveAsset::bin_pack_to(bytes, geometry);
+
+		auto unpacked = Geometry{};
+		context.measure(std::format("unpack Geometry [{} vertices, {} KiB]", count, bytes.size() / 1024), [&] {
+			if (unpack(bytes, unpacked)) { sum += unpacked.vertices.size(); }
+		});
+	}
+	bench::do_not_optimize(sum);
+}
+} // namespace
@@ -0,0 +1,33 @@
+#include <bench/bench.hpp>
+#include <le/graphics/geometry.hpp>
+#include <format>
+
+namespace {
+using namespace le;
+using namespace le::graphics;
+
+constexpr auto shape_count_v = std::size_t{1000};
+
+template <typename ShapeT>
+auto measure(bench::Context& context, std::string_view const label, ShapeT const& shape, std::size_t& out_sum) -> void {
+	auto geometry = Geometry{};
+	context.measure(std::format("append({}) [{}]", label, shape_count_v), [&] {
+		geometry.vertices.clear();
+		geometry.indices.clear();
+		for (std::size_t i = 0; i < shape_count_v; ++i) { geometry.append(shape); }
+		out_sum += geometry.vertices.size();
+	});
+}
+
+ADD_BENCH(GeometryAppend) {
+	auto sum = std::size_t{};
+	// Font::Pen::generate_quads() appends one Quad per glyph.
+	measure(context, "Quad", Quad{}, sum);
+	measure(context, "Circle", Circle{}, sum);
+	measure(context, "RoundedQuad", RoundedQuad{}, sum);
+	measure(context, "NineSlice", NineSlice{}, sum);
+	measure(context, "Cube", Cube{}, sum);
+	measure(context, "Sphere", Sphere{}, sum);
+	bench::do_not_optimize(sum);
+}
+} // namespace
@@ -0,0 +1,58 @@
+#include <bench/bench.hpp>
+#include <le/graphics/animation/interpolator.hpp>
+#include <array>
+#include <format>
+
+namespace {
+using namespace le;
+using namespace le::graphics;
+
+constexpr auto keyframe_counts_v = std::array<std::size_t, 4>{4, 64, 1024, 8192};
+constexpr auto sample_count_v = std::size_t{10000};
+
+template <typename Type, typename FuncT>
+auto make_interpolator(std::size_t const count, Interpolation const interpolation, FuncT make_value) -> Interpolator<Type> {
+	auto ret = Interpolator<Type>{.interpolation = interpolation};
+	ret.keyframes.reserve(count);
+	for (std::size_t i = 0; i < count; ++i) { ret.keyframes.push_back({.value = make_value(i), .timestamp = Duration{static_cast<float>(i + 1) * 0.1f}}); }
+	if (interpolation == Interpolation::eCubicSpline) { ret.tangents.resize(count, {.in = make_value(1), .out = make_value(2)}); }
+	return ret;
+}
+
+// samples sweep the whole animation in order, as a playing MeshAnimator would.
+template <typename Type>
+auto measure(bench::Context& context, std::string_view const label, Interpolator<Type> const& interpolator, Type& out_sum) -> void {
+	auto const step = interpolator.duration() / static_cast<float>(sample_count_v);
+	context.measure(std::format("{} [{}] x{}", label, interpolator.keyframes.size(), sample_count_v), [&] {
+		auto elapsed = Duration{};
+		for (std::size_t i = 0; i < sample_count_v; ++i) {
+			if (auto const value = interpolator(elapsed)) { out_sum += *value; }
+			elapsed += step;
+		}
+	});
+	context.measure(std::format("{} cursor [{}] x{}", label, interpolator.keyframes.size(), sample_count_v), [&] {
+		auto elapsed = Duration{};
+		auto cursor = KeyframeCursor{};
+		for (std::size_t i = 0; i < sample_count_v; ++i) {
+			if (auto const value = interpolator(elapsed, cursor)) { out_sum += *value; }
+			elapsed += step;
+		}
+	});
+}
+
+ADD_BENCH(Interpolator) {
+	auto vec3_sum = glm::vec3{};
+	auto quat_sum = glm::quat{};
+	auto const make_vec3 = [](std::size_t const i) { return glm::vec3{static_cast<float>(i), 1.0f, -1.0f}; };
+	auto const make_quat = [](std::size_t const i) { return glm::angleAxis(0.1f * static_cast<float>(i), glm::vec3{0.0f, 1.0f, 0.0f}); };
+	for (auto const count : keyframe_counts_v) {
+		measure(context, "vec3 linear", make_interpolator<glm::vec3>(count, Interpolation::eLinear, make_vec3), vec3_sum);
+		measure(context, "vec3 step", make_interpolator<glm::vec3>(count, Interpolation::eStep, make_vec3), vec3_sum);
+		measure(context, "vec3 cubic", make_interpolator<glm::vec3>(count, Interpolation::eCubicSpline, make_vec3), vec3_sum);
+		measure(context, "quat slerp", make_interpolator<glm::quat>(count, Interpolation::eLinear, make_quat), quat_sum);
+		measure(context, "quat cubic", make_interpolator<glm::quat>(count, Interpolation::eCubicSpline, make_quat), quat_sum);
+	}
+	bench::do_not_optimize(vec3_sum);
+	bench::do_not_optimize(quat_sum);
+}
+} // namespace
@@ -0,0 +1,67 @@
+#include <bench/bench.hpp>
+#include <le/core/mat4_batch.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <format>
+#include <vector>
+
+namespace {
+using namespace le;
+
+// a crowd of skinned meshes: joint matrices of every character in contiguous arrays.
+constexpr auto character_count_v = std::size_t{200};
+constexpr auto joint_count_v = std::size_t{64};
+constexpr auto matrix_count_v = character_count_v * joint_count_v;
+
+auto make_matrices(float const seed) -> std::vector<glm::mat4> {
+	auto ret = std::vector<glm::mat4>{};
+	ret.reserve(matrix_count_v);
+	for (std::size_t i = 0; i < matrix_count_v; ++i) {
+		auto const f = seed + static_cast<float>(i % 97);
+		auto const translate = glm::translate(glm::mat4{1.0f}, glm::vec3{f, 0.5f * f, -f});
+		ret.push_back(glm::scale(translate, glm::vec3{1.0f + 0.01f * f}));
+	}
+	return ret;
+}
+
+// a spine with a branch every 4 joints, per character.
+auto make_parents() -> std::vector<std::uint32_t> {
+	auto ret = std::vector<std::uint32_t>{};
+	ret.reserve(matrix_count_v);
+	for (std::size_t character = 0; character < character_count_v; ++character) {
+		auto parent = mat4_batch::root_v;
+		for (std::size_t joint = 0; joint < joint_count_v; ++joint) {
+			auto const index = static_cast<std::uint32_t>(character * joint_count_v + joint);
+			ret.push_back(parent);
+			if (joint % 4 != 3) { parent = index; }
+		}
+	}
+	return ret;
+}
+
+ADD_BENCH(Mat4Batch) {
+	auto const locals = make_matrices(1.0f);
+	auto const inverse_binds = make_matrices(2.0f);
+	auto const parents = make_parents();
+	auto indices = std::vector<std::uint32_t>(matrix_count_v);
+	for (std::size_t i = 0; i < indices.size(); ++i) { indices[i] = static_cast<std::uint32_t>(i); }
+	auto out = std::vector<glm::mat4>(matrix_count_v);
+
+	auto const label = [](std::string_view const name) { return std::format("{} [{}x{}]", name, character_count_v, joint_count_v); };
+	context.measure(label("concatenate scalar"), [&] {
+		mat4_batch::concatenate_scalar(locals, parents, indices, out);
+		bench::do_not_optimize(out);
+	});
+	context.measure(label("concatenate"), [&] {
+		mat4_batch::concatenate(locals, parents, indices, out);
+		bench::do_not_optimize(out);
+	});
+	context.measure(label("inverse bind scalar"), [&] {
+		mat4_batch::multiply_scalar(locals, inverse_binds, out);
+		bench::do_not_optimize(out);
+	});
+	context.measure(label("inverse bind"), [&] {
+		mat4_batch::multiply(locals, inverse_binds, out);
+		bench::do_not_optimize(out);
+	});
+}
+} // namespace
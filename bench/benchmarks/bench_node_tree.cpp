@@ -0,0 +1,103 @@
+#include <bench/bench.hpp>
+#include <djson/json.hpp>
+#include <le/node/node_tree_serializer.hpp>
+#include <array>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace {
+using namespace le;
+
+constexpr auto node_count_v = std::size_t{10000};
+constexpr auto large_count_v = std::size_t{100000};
+constexpr auto depths_v = std::array<std::size_t, 3>{1, 8, 32};
+
+// count nodes in chains of depth nodes each: every global_transform() walks up to depth ancestors.
+auto make_tree(std::size_t const depth, std::size_t const count = node_count_v) -> NodeTree {
+	auto ret = NodeTree{};
+	auto parent = std::optional<Id<Node>>{};
+	for (std::size_t i = 0; i < count; ++i) {
+		if (i % depth == 0) { parent.reset(); }
+		auto transform = Transform{};
+		transform.set_position({1.0f, static_cast<float>(i % 7), 0.0f});
+		transform.set_orientation(glm::angleAxis(0.1f, glm::vec3{0.0f, 1.0f, 0.0f}));
+		parent = ret.add(NodeCreateInfo{.transform = transform, .name = std::format("node_{}", i), .parent = parent}).id();
+	}
+	return ret;
+}
+
+ADD_BENCH(NodeTreeGlobalTransform) {
+	auto sum = glm::mat4{};
+	for (auto const depth : depths_v) {
+		auto tree = make_tree(depth);
+		context.measure(std::format("global_transform(Id) depth {} [{}]", depth, node_count_v), [&] {
+			for (std::size_t i = 0; i < node_count_v; ++i) { sum += tree.global_transform(Id<Node>{i}); }
+		});
+
+		auto ids = std::vector<Id<Node>>{};
+		for (std::size_t i = 0; i < node_count_v; ++i) { ids.emplace_back(i); }
+		auto out = std::vector<glm::mat4>(node_count_v);
+		context.measure(std::format("global_transforms(ids) depth {} [{}]", depth, node_count_v), [&] {
+			tree.global_transforms(ids, out);
+			sum += out.back();
+		});
+
+		context.measure(std::format("update_transforms() clean, depth {} [{}]", depth, node_count_v), [&] { tree.update_transforms(); });
+		// every subtree dirty: moves all the roots.
+		auto offset = 0.0f;
+		context.measure(std::format("update_transforms() dirty, depth {} [{}]", depth, node_count_v), [&] {
+			offset += 1.0f;
+			for (auto const root : tree.roots()) { tree.get(root).transform.set_position({offset, 0.0f, 0.0f}); }
+			tree.update_transforms();
+		});
+	}
+	bench::do_not_optimize(sum);
+}
+
+ADD_BENCH(NodeTreeFindByName) {
+	auto tree = make_tree(8);
+	auto names = std::vector<std::string>{};
+	for (std::size_t i = 0; i < node_count_v; ++i) { names.push_back(std::format("node_{}", i)); }
+	auto found = std::size_t{};
+	context.measure(std::format("find_by_name() [{}]", node_count_v), [&] {
+		for (auto const& name : names) { found += tree.find_by_name(name) ? 1 : 0; }
+	});
+	context.measure(std::format("find_by_name() miss [{}]", node_count_v), [&] {
+		for (std::size_t i = 0; i < node_count_v; ++i) { found += tree.find_by_name("missing") ? 1 : 0; }
+	});
+	context.measure(std::format("rename() [{}]", node_count_v), [&] {
+		for (std::size_t i = 0; i < node_count_v; ++i) { tree.rename(tree.get(Id<Node>{i}), names[node_count_v - i - 1]); }
+	});
+	bench::do_not_optimize(found);
+}
+
+ADD_BENCH(NodeTreeLarge) {
+	auto tree = make_tree(8, large_count_v);
+	auto offset = 0.0f;
+	context.measure(std::format("update_transforms() dirty [{}]", large_count_v), [&] {
+		offset += 1.0f;
+		for (auto const root : tree.roots()) { tree.get(root).transform.set_position({offset, 0.0f, 0.0f}); }
+		tree.update_transforms();
+	});
+
+	auto sum = glm::vec3{};
+	context.measure(std::format("for_each() [{}]", large_count_v), [&] {
+		tree.for_each([&sum](Node const& node) { sum += node.transform.position(); });
+	});
+
+	context.measure(std::format("serialize [{}]", large_count_v), [&] {
+		auto json = dj::Json{};
+		NodeTree::Serializer::serialize(json, tree);
+		bench::do_not_optimize(json);
+	});
+
+	// reparenting under a later node restores parent-before-child order.
+	context.measure(std::format("reparent() + sort [{}]", large_count_v), [&] {
+		auto const first = tree.roots().front();
+		tree.reparent(tree.get(first), tree.roots().back());
+		tree.reparent(tree.get(first), {});
+	});
+	bench::do_not_optimize(sum);
+}
+} // namespace
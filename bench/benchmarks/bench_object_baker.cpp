@@ -0,0 +1,50 @@
+#include <bench/bench.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <le/graphics/material.hpp>
+#include <le/graphics/object_baker.hpp>
+#include <test/null_primitive.hpp>
+#include <array>
+#include <format>
+
+namespace {
+using namespace le;
+using namespace le::graphics;
+using test::NullPrimitive;
+
+constexpr auto object_counts_v = std::array<std::size_t, 3>{1000, 10000, 100000};
+
+ADD_BENCH(ObjectBaker) {
+	auto const material = UnlitMaterial{};
+	auto const primitive = NullPrimitive{};
+	auto const joints = std::vector<glm::mat4>(16, glm::mat4{1.0f});
+	auto pool = ThreadPool{};
+
+	for (auto const count : object_counts_v) {
+		auto objects = std::vector<RenderObject>{};
+		objects.reserve(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			auto object = RenderObject{.material = &material, .primitive = &primitive};
+			object.parent = glm::translate(glm::mat4{1.0f}, glm::vec3{static_cast<float>(i), 0.0f, 0.0f});
+			if (i % 8 == 0) { object.joints = joints; }
+			objects.push_back(object);
+		}
+
+		auto baker = ObjectBaker{};
+		context.measure(std::format("push batched [{}]", count), [&] {
+			baker.clear();
+			baker.push(objects);
+		});
+
+		baker.batching = false;
+		context.measure(std::format("push [{}]", count), [&] {
+			baker.clear();
+			baker.push(objects);
+		});
+		auto out = std::vector<std::byte>(baker.size_bytes());
+
+		context.measure(std::format("write serial [{}]", count), [&] { baker.write(out); });
+		context.measure(std::format("write parallel x{} [{}]", pool.thread_count() + 1, count), [&] { baker.write(out, &pool); });
+		bench::do_not_optimize(out);
+	}
+}
+} // namespace
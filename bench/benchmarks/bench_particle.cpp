@@ -0,0 +1,33 @@
+#include <bench/bench.hpp>
+#include <le/graphics/particle.hpp>
+#include <array>
+#include <format>
+
+namespace {
+using namespace le;
+using namespace le::graphics;
+
+constexpr auto particle_counts_v = std::array<std::size_t, 3>{10000, 100000, 1000000};
+constexpr auto all_modifiers_v = Particle::Modifiers{Particle::eTranslate | Particle::eRotate | Particle::eScale | Particle::eTint};
+
+ADD_BENCH(ParticleEmitterUpdate) {
+	auto const view = glm::angleAxis(0.5f, glm::vec3{0.0f, 1.0f, 0.0f});
+	auto const dt = Duration{1.0f / 60.0f};
+	auto sum = std::size_t{};
+	for (auto const count : particle_counts_v) {
+		auto emitter = Particle::Emitter{};
+		emitter.config.count = count;
+		emitter.modifiers = all_modifiers_v;
+		emitter.respawn_all(view);
+		context.measure(std::format("update (all modifiers) [{}]", count), [&] {
+			emitter.update(view, dt);
+			sum += emitter.active_particles();
+		});
+		context.measure(std::format("update_scalar (all modifiers) [{}]", count), [&] {
+			emitter.update_scalar(view, dt);
+			sum += emitter.active_particles();
+		});
+	}
+	bench::do_not_optimize(sum);
+}
+} // namespace
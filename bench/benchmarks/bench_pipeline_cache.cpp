@@ -0,0 +1,65 @@
+#include <bench/bench.hpp>
+#include <le/graphics/cache/pipeline_cache.hpp>
+#include <array>
+#include <format>
+#include <unordered_map>
+
+namespace {
+using namespace le;
+using namespace le::graphics;
+using Key = PipelineCache::Key;
+
+constexpr auto key_count_v = std::size_t{64};
+constexpr auto lookup_count_v = std::size_t{10000};
+constexpr auto polygon_modes_v = std::array{vk::PolygonMode::eFill, vk::PolygonMode::eLine};
+
+struct Query {
+	PipelineFormat format{};
+	Shader shader{};
+	PipelineState state{};
+	vk::PolygonMode polygon_mode{};
+};
+
+auto make_queries() -> std::vector<Query> {
+	auto ret = std::vector<Query>{};
+	ret.reserve(key_count_v);
+	for (std::size_t i = 0; i < key_count_v; ++i) {
+		auto query = Query{.format = {.colour = vk::Format::eR8G8B8A8Srgb, .depth = vk::Format::eD32Sfloat}};
+		query.shader = Shader{.vertex = std::format("shaders/material_{}.vert", i / 4), .fragment = std::format("shaders/material_{}.frag", i / 2)};
+		query.state.depth_test_write = i % 2 == 0 ? vk::True : vk::False;
+		query.polygon_mode = polygon_modes_v.at((i / 2) % 2);
+		ret.push_back(std::move(query));
+	}
+	return ret;
+}
+
+// compares the FlatHashMap hot path (hash + predicate) against the previous unordered_map + Key construction.
+ADD_BENCH(PipelineCacheLookup) {
+	auto const queries = make_queries();
+	auto flat = FlatHashMap<Key, std::size_t, PipelineCache::Hasher>{};
+	auto unordered = std::unordered_map<Key, std::size_t, PipelineCache::Hasher>{};
+	for (std::size_t i = 0; i < queries.size(); ++i) {
+		auto const& query = queries[i];
+		auto const key = Key{query.format, query.shader, query.state, query.polygon_mode};
+		flat.insert_or_assign(key, i);
+		unordered.insert_or_assign(key, i);
+	}
+
+	auto sum = std::size_t{};
+	context.measure(std::format("FlatHashMap::find(hash, pred) [{}]", lookup_count_v), [&] {
+		for (std::size_t i = 0; i < lookup_count_v; ++i) {
+			auto const& query = queries[i % queries.size()];
+			auto const hash = Key::make_hash(query.format, query.shader, query.state, query.polygon_mode);
+			auto const* value = flat.find(hash, [&](Key const& key) { return key.matches(query.format, query.shader, query.state, query.polygon_mode); });
+			sum += *value;
+		}
+	});
+	context.measure(std::format("unordered_map::find(Key) [{}]", lookup_count_v), [&] {
+		for (std::size_t i = 0; i < lookup_count_v; ++i) {
+			auto const& query = queries[i % queries.size()];
+			sum += unordered.find(Key{query.format, query.shader, query.state, query.polygon_mode})->second;
+		}
+	});
+	bench::do_not_optimize(sum);
+}
+} // namespace
@@ -0,0 +1,40 @@
+#include <bench/bench.hpp>
+#include <le/core/profiler.hpp>
+#include <format>
+
+namespace {
+using namespace le;
+
+constexpr auto scope_count_v = Profiler::thread_capacity_v / 2;
+
+// per-scope overhead: disabled scopes should cost (almost) nothing over the bare loop.
+ADD_BENCH(ProfilerScope) {
+	auto sum = std::size_t{};
+	auto const work = [&sum](std::size_t const i) { sum += i * i; };
+
+	Profiler::set_enabled(false);
+	context.measure(std::format("no scope [{}]", scope_count_v), [&] {
+		for (std::size_t i = 0; i < scope_count_v; ++i) { work(i); }
+	});
+	context.measure(std::format("LE_PROFILE_SCOPE disabled [{}]", scope_count_v), [&] {
+		for (std::size_t i = 0; i < scope_count_v; ++i) {
+			LE_PROFILE_SCOPE("bench");
+			work(i);
+		}
+	});
+
+	Profiler::set_enabled(true);
+	// drained every run (as next_frame() would) so no events are dropped.
+	context.measure(std::format("LE_PROFILE_SCOPE enabled + collect [{}]", scope_count_v), [&] {
+		for (std::size_t i = 0; i < scope_count_v; ++i) {
+			LE_PROFILE_SCOPE("bench");
+			work(i);
+		}
+		auto const events = Profiler::collect();
+		sum += events.size();
+	});
+	Profiler::set_enabled(false);
+
+	bench::do_not_optimize(sum);
+}
+} // namespace
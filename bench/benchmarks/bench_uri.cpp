@@ -0,0 +1,42 @@
+#include <bench/bench.hpp>
+#include <le/vfs/uri.hpp>
+#include <format>
+#include <memory>
+#include <unordered_map>
+
+namespace {
+using namespace le;
+
+constexpr auto uri_count_v = std::size_t{4096};
+
+auto make_paths() -> std::vector<std::string> {
+	auto ret = std::vector<std::string>{};
+	ret.reserve(uri_count_v);
+	for (std::size_t i = 0; i < uri_count_v; ++i) { ret.push_back(std::format("models/level_{}/props/mesh_{}.json", i / 64, i)); }
+	return ret;
+}
+
+ADD_BENCH(UriHash) {
+	auto const paths = make_paths();
+	auto sum = std::size_t{};
+	context.measure(std::format("Uri(std::string) [{}]", uri_count_v), [&] {
+		for (auto const& path : paths) { sum += Uri{path}.hash(); }
+	});
+
+	// same container as Resources.
+	auto map = std::unordered_map<Uri, std::size_t, Uri::Hasher, std::equal_to<>>{};
+	auto uris = std::vector<Uri>{};
+	uris.reserve(paths.size());
+	for (auto const& path : paths) {
+		map.insert_or_assign(path, map.size());
+		uris.emplace_back(path);
+	}
+	context.measure(std::format("find(Uri) [{}]", uri_count_v), [&] {
+		for (auto const& uri : uris) { sum += map.find(uri)->second; }
+	});
+	context.measure(std::format("find(std::string_view) [{}]", uri_count_v), [&] {
+		for (auto const& path : paths) { sum += map.find(std::string_view{path})->second; }
+	});
+	bench::do_not_optimize(sum);
+}
+} // namespace
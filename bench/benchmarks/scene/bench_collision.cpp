@@ -0,0 +1,32 @@
+#include <bench/bench.hpp>
+#include <le/graphics/defer.hpp>
+#include <le/scene/collision.hpp>
+#include <le/scene/scene.hpp>
+#include <array>
+#include <format>
+
+namespace {
+using namespace le;
+
+constexpr auto collider_counts_v = std::array<std::size_t, 3>{64, 256, 1024};
+
+ADD_BENCH(CollisionTick) {
+	// owns the Collision primitive's deferred resources.
+	auto defer_queue = graphics::DeferQueue{};
+	auto const dt = Duration{1.0f / 60.0f};
+	auto collisions = std::size_t{};
+	for (auto const count : collider_counts_v) {
+		auto scene = Scene{};
+		for (std::size_t i = 0; i < count; ++i) {
+			auto& entity = scene.spawn(std::format("collider_{}", i));
+			// a grid of unit cubes, with every other row overlapping its neighbour.
+			entity.get_transform().set_position({static_cast<float>(i % 32) * 0.75f, static_cast<float>(i / 32) * 2.0f, 0.0f});
+			auto& collider = entity.attach<ColliderAabb>();
+			collider.on_collision = [&collisions](ColliderAabb const& /*other*/) { ++collisions; };
+		}
+		scene.collision.tick(scene, dt);
+		context.measure(std::format("tick [{} colliders]", count), [&] { scene.collision.tick(scene, dt); });
+	}
+	bench::do_not_optimize(collisions);
+}
+} // namespace
@@ -4,6 +4,7 @@ set(core_headers
   ${prefix}/core/enum_array.hpp
   ${prefix}/core/enumerate.hpp
   ${prefix}/core/fixed_string.hpp
+  ${prefix}/core/flat_hash_map.hpp
   ${prefix}/core/hash_combine.hpp
   ${prefix}/core/id.hpp
   ${prefix}/core/inclusive_range.hpp
@@ -14,12 +15,14 @@ set(core_headers
   ${prefix}/core/nvec3.hpp
   ${prefix}/core/offset_span.hpp
   ${prefix}/core/polymorphic.hpp
+  ${prefix}/core/profiler.hpp
   ${prefix}/core/ptr.hpp
   ${prefix}/core/radians.hpp
   ${prefix}/core/random.hpp
   ${prefix}/core/result.hpp
   ${prefix}/core/reverse_view.hpp
   ${prefix}/core/signal.hpp
+  ${prefix}/core/thread_pool.hpp
   ${prefix}/core/time.hpp
   ${prefix}/core/version.hpp
   ${prefix}/core/visitor.hpp
@@ -86,6 +89,7 @@ set(graphics_headers
 
   ${prefix}/graphics/allocator.hpp
   ${prefix}/graphics/bitmap.hpp
+  ${prefix}/graphics/bounds.hpp
   ${prefix}/graphics/buffering.hpp
   ${prefix}/graphics/camera.hpp
   ${prefix}/graphics/command_buffer.hpp
@@ -95,12 +99,15 @@ set(graphics_headers
   ${prefix}/graphics/device.hpp
   ${prefix}/graphics/dynamic_atlas.hpp
   ${prefix}/graphics/fallback.hpp
+  ${prefix}/graphics/frustum.hpp
   ${prefix}/graphics/geometry.hpp
   ${prefix}/graphics/image_file.hpp
   ${prefix}/graphics/image_barrier.hpp
   ${prefix}/graphics/image_view.hpp
   ${prefix}/graphics/lights.hpp
   ${prefix}/graphics/material.hpp
+  ${prefix}/graphics/material_table.hpp
+  ${prefix}/graphics/object_baker.hpp
   ${prefix}/graphics/particle.hpp
   ${prefix}/graphics/pipeline_state.hpp
   ${prefix}/graphics/primitive.hpp
@@ -108,6 +115,7 @@ set(graphics_headers
   ${prefix}/graphics/rgba.hpp
   ${prefix}/graphics/render_frame.hpp
   ${prefix}/graphics/render_object.hpp
+  ${prefix}/graphics/render_sorter.hpp
   ${prefix}/graphics/renderer.hpp
   ${prefix}/graphics/resource.hpp
   ${prefix}/graphics/rgba.hpp
@@ -117,6 +125,7 @@ set(graphics_headers
   ${prefix}/graphics/swapchain.hpp
   ${prefix}/graphics/texture_sampler.hpp
   ${prefix}/graphics/texture.hpp
+  ${prefix}/graphics/upload_queue.hpp
 )
 
 set(audio_headers
@@ -127,6 +136,7 @@ set(audio_headers
 set(console_headers
   ${prefix}/console/console.hpp
   ${prefix}/console/command.hpp
+  ${prefix}/console/profile_trace.hpp
   ${prefix}/console/property.hpp
   ${prefix}/console/trigger.hpp
 )
@@ -154,5 +164,6 @@ set(header_list
   ${prefix}/environment.hpp
   ${prefix}/frame_profile.hpp
   ${prefix}/error.hpp
+  ${prefix}/perf_capture.hpp
   ${prefix}/stats.hpp
 )
@@ -0,0 +1,20 @@
+#pragma once
+#include <le/console/command.hpp>
+#include <cstdint>
+
+namespace le::console {
+///
+/// \brief Capture frames with the scope Profiler: "profile_trace [frames] [path]".
+///
+/// Writes Chrome trace / Perfetto JSON once the capture is complete.
+///
+class ProfileTrace : public Command {
+  public:
+	static constexpr std::uint64_t default_frames_v{60};
+	static constexpr std::string_view default_path_v{"profile_trace.json"};
+
+	explicit ProfileTrace(std::string name = "profile_trace") : Command(std::move(name)) {}
+
+	auto process(std::string_view argument) -> Response override;
+};
+} // namespace le::console
@@ -0,0 +1,104 @@
+#pragma once
+#include <le/core/ptr.hpp>
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace le {
+///
+/// \brief Open-addressing (linear probing) hash map for small, hot, insert-only tables.
+///
+/// Entries are stored densely (in insertion order), slots only store each entry's hash and index.
+/// Lookups compare stored hashes before keys, and can be done without constructing a KeyT (find(hash, predicate)).
+/// HasherT must return a well distributed 64-bit hash (slots are selected from its low bits).
+/// Individual entries cannot be erased.
+///
+template <typename KeyT, typename ValueT, typename HasherT = std::hash<KeyT>>
+class FlatHashMap {
+  public:
+	struct Entry {
+		KeyT key;
+		ValueT value;
+	};
+
+	[[nodiscard]] auto size() const -> std::size_t { return m_entries.size(); }
+	[[nodiscard]] auto is_empty() const -> bool { return m_entries.empty(); }
+	[[nodiscard]] auto entries() const -> std::span<Entry const> { return m_entries; }
+
+	template <std::predicate<KeyT const&> PredT>
+	[[nodiscard]] auto find(std::uint64_t const hash, PredT const& predicate) const -> Ptr<ValueT const> {
+		if (m_slots.empty()) { return {}; }
+		for (auto index = hash & m_mask;; index = (index + 1) & m_mask) {
+			auto const& slot = m_slots[index];
+			if (slot.index == npos_v) { return {}; }
+			if (slot.hash == hash && predicate(m_entries[slot.index].key)) { return &m_entries[slot.index].value; }
+		}
+	}
+
+	template <std::predicate<KeyT const&> PredT>
+	[[nodiscard]] auto find(std::uint64_t const hash, PredT const& predicate) -> Ptr<ValueT> {
+		return const_cast<Ptr<ValueT>>(std::as_const(*this).find(hash, predicate)); // NOLINT
+	}
+
+	[[nodiscard]] auto find(KeyT const& key) const -> Ptr<ValueT const> {
+		return find(get_hash(key), [&key](KeyT const& rhs) { return rhs == key; });
+	}
+
+	[[nodiscard]] auto find(KeyT const& key) -> Ptr<ValueT> {
+		return find(get_hash(key), [&key](KeyT const& rhs) { return rhs == key; });
+	}
+
+	[[nodiscard]] auto contains(KeyT const& key) const -> bool { return find(key) != nullptr; }
+
+	auto insert_or_assign(KeyT key, ValueT value) -> ValueT& {
+		auto const hash = get_hash(key);
+		if (auto* existing = find(hash, [&key](KeyT const& rhs) { return rhs == key; })) {
+			*existing = std::move(value);
+			return *existing;
+		}
+		if (2 * (m_entries.size() + 1) > m_slots.size()) { rehash(std::max(std::size_t{16}, 2 * m_slots.size())); }
+		m_entries.push_back(Entry{.key = std::move(key), .value = std::move(value)});
+		place(hash, static_cast<std::uint32_t>(m_entries.size() - 1));
+		return m_entries.back().value;
+	}
+
+	auto clear() -> void {
+		m_entries.clear();
+		m_slots.clear();
+		m_mask = {};
+	}
+
+  private:
+	static constexpr auto npos_v{std::numeric_limits<std::uint32_t>::max()};
+
+	struct Slot {
+		std::uint64_t hash{};
+		std::uint32_t index{npos_v};
+	};
+
+	[[nodiscard]] static auto get_hash(KeyT const& key) -> std::uint64_t { return static_cast<std::uint64_t>(HasherT{}(key)); }
+
+	auto place(std::uint64_t const hash, std::uint32_t const entry) -> void {
+		auto index = hash & m_mask;
+		while (m_slots[index].index != npos_v) { index = (index + 1) & m_mask; }
+		m_slots[index] = Slot{.hash = hash, .index = entry};
+	}
+
+	auto rehash(std::size_t const slot_count) -> void {
+		auto const previous = std::exchange(m_slots, std::vector<Slot>(std::bit_ceil(slot_count)));
+		m_mask = m_slots.size() - 1;
+		for (auto const& slot : previous) {
+			if (slot.index != npos_v) { place(slot.hash, slot.index); }
+		}
+	}
+
+	std::vector<Entry> m_entries{};
+	std::vector<Slot> m_slots{};
+	std::uint64_t m_mask{};
+};
+} // namespace le
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <functional>
 
 namespace le {
@@ -17,4 +18,21 @@ auto make_combined_hash(Types const&... t) -> std::size_t {
 	hash_combine<Hasher>(ret, t...);
 	return ret;
 }
+
+///
+/// \brief 64-bit finalizer (splitmix64): every input bit affects every output bit.
+///
+constexpr auto hash_mix(std::uint64_t value) -> std::uint64_t {
+	value ^= value >> 30;
+	value *= 0xbf58476d1ce4e5b9;
+	value ^= value >> 27;
+	value *= 0x94d049bb133111eb;
+	value ^= value >> 31;
+	return value;
+}
+
+///
+/// \brief 64-bit hash_combine: use for keys whose hashes are compared / probed directly.
+///
+constexpr void hash_combine_64(std::uint64_t& out_seed, std::uint64_t const hash) { out_seed = hash_mix(out_seed ^ (hash + 0x9e3779b97f4a7c15)); }
 } // namespace le
@@ -0,0 +1,41 @@
+#pragma once
+#include <glm/mat4x4.hpp>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+///
+/// \brief Batched 4x4 matrix products over contiguous arrays (SSE2 where available).
+///
+/// Results are bit-identical to glm's scalar operator*: the same products are summed in the same order.
+///
+namespace le::mat4_batch {
+///
+/// \brief Parent index of roots passed to concatenate().
+///
+inline constexpr auto root_v{std::numeric_limits<std::uint32_t>::max()};
+
+///
+/// \brief out[i] = lhs[i] * rhs[i] for each i in out.
+///
+/// lhs and rhs must be at least out.size() large; out may alias either.
+///
+auto multiply(std::span<glm::mat4 const> lhs, std::span<glm::mat4 const> rhs, std::span<glm::mat4> out) -> void;
+///
+/// \brief Reference implementation of multiply(), always scalar.
+///
+auto multiply_scalar(std::span<glm::mat4 const> lhs, std::span<glm::mat4 const> rhs, std::span<glm::mat4> out) -> void;
+
+///
+/// \brief Concatenate local transforms down a hierarchy: out[i] = out[parents[i]] * locals[i] (locals[i] for roots), for each i in indices.
+///
+/// indices must list parents before their children.
+///
+auto concatenate(std::span<glm::mat4 const> locals, std::span<std::uint32_t const> parents, std::span<std::uint32_t const> indices, std::span<glm::mat4> out)
+	-> void;
+///
+/// \brief Reference implementation of concatenate(), always scalar.
+///
+auto concatenate_scalar(std::span<glm::mat4 const> locals, std::span<std::uint32_t const> parents, std::span<std::uint32_t const> indices,
+						std::span<glm::mat4> out) -> void;
+} // namespace le::mat4_batch
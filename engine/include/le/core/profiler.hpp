@@ -0,0 +1,98 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+///
+/// \brief Profile the enclosing scope (name must be a string literal / have static storage duration).
+///
+#define LE_PROFILE_SCOPE(name) ::le::Profiler::Scope const LE_PROFILE_CONCAT(le_profile_scope_, __LINE__){name}
+
+#define LE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define LE_PROFILE_CONCAT(a, b) LE_PROFILE_CONCAT_IMPL(a, b)
+
+namespace le {
+///
+/// \brief Nested, thread-aware scope profiler.
+///
+/// Each thread records completed scopes into its own lock-free ring buffer, drained once per frame by next_frame().
+/// While disabled, a Scope costs one relaxed atomic load.
+/// Captures span whole frames and are written as Chrome trace / Perfetto JSON (chrome://tracing, ui.perfetto.dev).
+///
+class Profiler {
+  public:
+	struct Event {
+		char const* name{};
+		std::int64_t start_ns{};
+		std::int64_t duration_ns{};
+		std::uint32_t thread{};
+		std::uint32_t depth{};
+	};
+
+	///
+	/// \brief Maximum number of undrained events per thread: further events are dropped.
+	///
+	static constexpr std::size_t thread_capacity_v{16 * 1024};
+
+	class Scope {
+	  public:
+		Scope(Scope const&) = delete;
+		Scope(Scope&&) = delete;
+		auto operator=(Scope const&) -> Scope& = delete;
+		auto operator=(Scope&&) -> Scope& = delete;
+
+		explicit Scope(char const* name) {
+			if (!is_enabled()) { return; }
+			m_name = name;
+			m_start = begin();
+		}
+
+		~Scope() {
+			if (m_name != nullptr) { end(m_name, m_start); }
+		}
+
+	  private:
+		char const* m_name{};
+		std::int64_t m_start{};
+	};
+
+	[[nodiscard]] static auto is_enabled() -> bool { return s_enabled.load(std::memory_order_relaxed); }
+	static auto set_enabled(bool enabled) -> void { s_enabled.store(enabled, std::memory_order_relaxed); }
+
+	///
+	/// \brief Capture the next frames and write them to path.
+	/// \returns false if a capture is already in progress
+	///
+	/// Recording starts on the next call to next_frame().
+	///
+	static auto start_capture(std::uint64_t frames, std::string path) -> bool;
+	[[nodiscard]] static auto is_capturing() -> bool;
+
+	///
+	/// \brief Mark a frame boundary: drain all thread buffers into the capture, if any (called by Engine::next_frame()).
+	///
+	static auto next_frame() -> void;
+
+	///
+	/// \brief Drain all events recorded since the last drain.
+	///
+	[[nodiscard]] static auto collect() -> std::vector<Event>;
+	///
+	/// \brief Obtain (and reset) the number of events dropped due to full thread buffers.
+	///
+	static auto drain_dropped() -> std::uint64_t;
+
+	[[nodiscard]] static auto now_ns() -> std::int64_t;
+	[[nodiscard]] static auto thread_id() -> std::uint32_t;
+
+	static auto write_trace(std::span<Event const> events, char const* path) -> bool;
+
+  private:
+	static auto begin() -> std::int64_t;
+	static auto end(char const* name, std::int64_t start) -> void;
+
+	inline static std::atomic<bool> s_enabled{}; // NOLINT
+};
+} // namespace le
@@ -1,6 +1,10 @@
 #pragma once
+#include <array>
+#include <bit>
 #include <cassert>
 #include <concepts>
+#include <cstdint>
+#include <limits>
 #include <random>
 
 namespace le {
@@ -28,6 +32,60 @@ struct Random {
 	}
 };
 
+///
+/// \brief xoshiro128++: small and fast PRNG for bulk use (eg particles), not suitable for cryptography.
+///
+/// Satisfies UniformRandomBitGenerator (usable with std distributions).
+///
+class Xoshiro128 {
+  public:
+	using result_type = std::uint32_t;
+
+	static constexpr auto min() -> result_type { return 0; }
+	static constexpr auto max() -> result_type { return std::numeric_limits<result_type>::max(); }
+
+	///
+	/// \brief Seed the state via splitmix64 (never all zero).
+	///
+	explicit constexpr Xoshiro128(std::uint64_t seed = 0) {
+		for (std::size_t i = 0; i < m_state.size(); i += 2) {
+			seed += 0x9e3779b97f4a7c15;
+			auto z = seed;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+			z ^= z >> 31;
+			m_state.at(i) = static_cast<std::uint32_t>(z);
+			m_state.at(i + 1) = static_cast<std::uint32_t>(z >> 32);
+		}
+	}
+
+	explicit constexpr Xoshiro128(std::array<std::uint32_t, 4> const& state) : m_state(state) {}
+
+	constexpr auto operator()() -> result_type {
+		auto const ret = std::rotl(m_state[0] + m_state[3], 7) + m_state[0];
+		auto const t = m_state[1] << 9;
+		m_state[2] ^= m_state[0];
+		m_state[3] ^= m_state[1];
+		m_state[1] ^= m_state[2];
+		m_state[0] ^= m_state[3];
+		m_state[2] ^= t;
+		m_state[3] = std::rotl(m_state[3], 11);
+		return ret;
+	}
+
+	///
+	/// \brief Obtain a uniformly distributed float in [0, 1).
+	///
+	constexpr auto next_float() -> float { return static_cast<float>(operator()() >> 8) * 0x1.0p-24f; }
+	///
+	/// \brief Obtain a uniformly distributed float in [lo, hi).
+	///
+	constexpr auto in_range(float const lo, float const hi) -> float { return lo + (hi - lo) * next_float(); }
+
+  private:
+	std::array<std::uint32_t, 4> m_state{};
+};
+
 template <typename T>
 auto random_range(T lo, T hi) -> T {
 	return Random::default_instance().in_range(lo, hi);
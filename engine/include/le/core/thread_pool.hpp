@@ -0,0 +1,89 @@
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace le {
+///
+/// \brief Fixed set of worker threads consuming a shared task queue.
+///
+class ThreadPool {
+  public:
+	///
+	/// \brief Obtain the default number of worker threads (leaves one hardware thread for the caller).
+	///
+	[[nodiscard]] static auto default_thread_count() -> std::size_t;
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool(ThreadPool&&) = delete;
+	auto operator=(ThreadPool const&) -> ThreadPool& = delete;
+	auto operator=(ThreadPool&&) -> ThreadPool& = delete;
+
+	explicit ThreadPool(std::size_t thread_count = default_thread_count());
+	~ThreadPool();
+
+	[[nodiscard]] auto thread_count() const -> std::size_t { return m_threads.size(); }
+
+	///
+	/// \brief Enqueue a task to be run on a worker thread.
+	/// \param func Task to run
+	/// \returns Future for the result of func
+	///
+	template <std::invocable FuncT>
+	auto enqueue(FuncT func) -> std::future<std::invoke_result_t<FuncT>> {
+		auto task = std::make_shared<std::packaged_task<std::invoke_result_t<FuncT>()>>(std::move(func));
+		auto ret = task->get_future();
+		push([task] { (*task)(); });
+		return ret;
+	}
+
+	///
+	/// \brief Split [0, count) into contiguous chunks and run func(first, last) on each, blocking until all are done.
+	/// \param count Total number of elements
+	/// \param func Callable invoked as func(std::size_t first, std::size_t last)
+	/// \param min_chunk Minimum number of elements per chunk
+	///
+	/// The calling thread processes the first chunk.
+	/// Any exception thrown by func is rethrown on the calling thread.
+	///
+	template <typename FuncT>
+		requires(std::invocable<FuncT&, std::size_t, std::size_t>)
+	auto for_each_chunk(std::size_t const count, FuncT func, std::size_t const min_chunk = 1) -> void {
+		if (count == 0) { return; }
+		auto const max_chunks = (count + std::max(min_chunk, std::size_t{1}) - 1) / std::max(min_chunk, std::size_t{1});
+		auto const chunks = std::clamp(thread_count() + 1, std::size_t{1}, max_chunks);
+		auto const chunk_size = (count + chunks - 1) / chunks;
+		auto futures = std::vector<std::future<void>>{};
+		futures.reserve(chunks);
+		for (auto first = chunk_size; first < count; first += chunk_size) {
+			auto const last = std::min(first + chunk_size, count);
+			futures.push_back(enqueue([&func, first, last] { func(first, last); }));
+		}
+		auto exception = std::exception_ptr{};
+		try {
+			func(std::size_t{0}, std::min(chunk_size, count));
+		} catch (...) { exception = std::current_exception(); }
+		// every queued chunk references func: wait for all of them before (re)throwing.
+		for (auto& future : futures) { future.wait(); }
+		if (exception) { std::rethrow_exception(exception); }
+		for (auto& future : futures) { future.get(); }
+	}
+
+  private:
+	auto push(std::function<void()> task) -> void;
+	auto run() -> void;
+
+	std::vector<std::thread> m_threads{};
+	std::deque<std::function<void()>> m_queue{};
+	std::mutex m_mutex{};
+	std::condition_variable m_cv{};
+	bool m_stop{};
+};
+} // namespace le
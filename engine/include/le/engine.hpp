@@ -9,9 +9,11 @@
 #include <le/graphics/device.hpp>
 #include <le/graphics/renderer.hpp>
 #include <le/input/state.hpp>
+#include <le/perf_capture.hpp>
 #include <le/resources/resources.hpp>
 #include <le/stats.hpp>
 #include <le/vfs/vfs.hpp>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -23,6 +25,12 @@ class Engine : public MonoInstance<Engine> {
   public:
 	class Builder;
 
+	///
+	/// \brief Feeds input::State in headless mode, called once per frame in next_frame().
+	/// \param frame Index of the frame being started
+	///
+	using InputScript = std::function<void(input::State& out, std::uint64_t frame)>;
+
 	Engine(Engine const&) = delete;
 	Engine(Engine&&) = delete;
 	auto operator=(Engine const&) -> Engine& = delete;
@@ -41,7 +49,11 @@ class Engine : public MonoInstance<Engine> {
 
 	[[nodiscard]] auto frame_profile() const -> FrameProfile const&;
 
-	[[nodiscard]] auto is_running() const -> bool { return glfwWindowShouldClose(m_window.get()) != GLFW_TRUE; }
+	[[nodiscard]] auto is_headless() const -> bool { return m_window == nullptr; }
+	[[nodiscard]] auto is_running() const -> bool {
+		if (is_headless()) { return !m_input_state.shutting_down; }
+		return glfwWindowShouldClose(m_window.get()) != GLFW_TRUE;
+	}
 	[[nodiscard]] auto next_frame() -> bool;
 	auto render(graphics::RenderFrame const& frame) -> void;
 	auto shutdown() -> void;
@@ -50,9 +62,25 @@ class Engine : public MonoInstance<Engine> {
 
 	auto request_present_mode(vk::PresentModeKHR mode) -> bool;
 
+	///
+	/// \brief Start recording the next frames' profiles (after warmup frames).
+	///
+	/// A headless Engine shuts down once the capture is complete.
+	///
+	auto start_capture(std::uint64_t frames, std::uint64_t warmup = 0) -> void;
+	[[nodiscard]] auto get_capture() const -> Ptr<PerfCapture const> { return m_capture ? &*m_capture : nullptr; }
+
 	Engine([[maybe_unused]] ConstructTag tag) noexcept {}
 
 	Duration min_frame_time{};
+	///
+	/// \brief Override measured delta time (for deterministic runs).
+	///
+	std::optional<Duration> fixed_delta_time{};
+	///
+	/// \brief Source of input in headless mode.
+	///
+	InputScript input_script{};
 
   private:
 	static auto get_engine(GLFWwindow* window) -> Engine&;
@@ -73,6 +101,9 @@ class Engine : public MonoInstance<Engine> {
 	std::unique_ptr<audio::Device> m_audio_device{};
 
 	input::State m_input_state{};
+	glm::uvec2 m_headless_extent{};
+	Uri m_pipeline_cache_uri{};
+	std::optional<PerfCapture> m_capture{};
 
 	std::optional<std::uint32_t> m_image_index{};
 	DeltaTime m_delta_time{};
@@ -96,6 +127,18 @@ class Engine::Builder {
 
 	auto set_extent(glm::uvec2 value) -> Builder&;
 	auto set_shader_layout(graphics::ShaderLayout shader_layout) -> Builder&;
+	///
+	/// \brief Run without a window: render into offscreen images and source input from Engine::input_script.
+	///
+	/// Does not require swapchain / surface support (works with software implementations like lavapipe).
+	///
+	auto set_headless(bool value) -> Builder&;
+	///
+	/// \brief Set the Uri to load Vulkan pipeline cache data from, and save it to on shutdown (if the vfs reader is a FileReader).
+	///
+	/// Disabled (empty) by default: the Uri is relative to the mounted (asset) directory, which apps may not want written to.
+	///
+	auto set_pipeline_cache_uri(Uri uri) -> Builder&;
 
 	[[nodiscard]] auto build() -> std::unique_ptr<Engine>;
 
@@ -103,5 +146,7 @@ class Engine::Builder {
 	std::optional<graphics::ShaderLayout> m_shader_layout{};
 	std::string m_title{};
 	glm::uvec2 m_extent{default_extent_v};
+	Uri m_pipeline_cache_uri{};
+	bool m_headless{};
 };
 } // namespace le
@@ -17,7 +17,25 @@ struct FrameProfile {
 
 	static constexpr auto to_string_v = StaticEnumToString<Type>{"acquire-frame", "tick", "render-shadow-map", "render-3d", "render-imgui", "render-submit"};
 
+	///
+	/// \brief Whether GPU time is measured for type.
+	///
+	static constexpr auto has_gpu_time(Type const type) -> bool {
+		return type == Type::eRenderShadowMap || type == Type::eRenderScene || type == Type::eRenderImGui;
+	}
+
 	EnumArray<Type, Duration> profile{};
 	Duration frame_time{};
+	///
+	/// \brief GPU time of render passes (timestamp queries), from the frame that last used the same frame index.
+	///
+	/// Zero if timestamps are not supported, or no results are available yet.
+	///
+	EnumArray<Type, Duration> gpu_profile{};
+	Duration gpu_frame_time{};
+	///
+	/// \brief Time the render thread spent building / waiting for pipelines (part of the above stages).
+	///
+	Duration pipeline_compile{};
 };
 } // namespace le
@@ -2,6 +2,7 @@
 #include <le/core/transform.hpp>
 #include <le/graphics/animation/interpolator.hpp>
 #include <le/node/node_tree.hpp>
+#include <span>
 #include <variant>
 
 namespace le::graphics {
@@ -15,12 +16,45 @@ struct Animation {
 		std::variant<Translate, Rotate, Scale> storage{};
 
 		auto update(NodeLocator node_locator, Duration time) const -> void;
+		auto update(NodeLocator node_locator, Duration time, KeyframeCursor& cursor) const -> void;
 		[[nodiscard]] auto duration() const -> Duration;
 	};
 
+	///
+	/// \brief Channels resolved against a NodeTree instance, grouped by type.
+	///
+	/// Updating a Binding samples each group in a tight loop without visiting variants or looking up nodes.
+	/// Holds pointers to the Animation and its nodes: rebind when either is destroyed or the tree changes structurally.
+	///
+	struct Binding {
+		template <typename InterpolatorT>
+		struct Target {
+			Ptr<InterpolatorT const> interpolator{};
+			Ptr<Node> node{};
+			KeyframeCursor cursor{};
+		};
+
+		std::vector<Target<Translate>> translations{};
+		std::vector<Target<Rotate>> rotations{};
+		std::vector<Target<Scale>> scales{};
+		Ptr<Animation const> animation{};
+
+		auto update(Duration time) -> void;
+		auto reset_cursors() -> void;
+	};
+
 	std::vector<Channel> channels{};
 
+	///
+	/// \brief Resolve channels to the nodes of node_locator's tree (channels targeting missing nodes are dropped).
+	///
+	[[nodiscard]] auto bind(NodeLocator node_locator) const -> Binding;
+
 	[[nodiscard]] auto duration() const -> Duration;
 	auto update(NodeLocator node_locator, Duration time) const -> void;
+	///
+	/// \brief Update using per channel cursors (one per channel), owned by the playback.
+	///
+	auto update(NodeLocator node_locator, Duration time, std::span<KeyframeCursor> cursors) const -> void;
 };
 } // namespace le::graphics
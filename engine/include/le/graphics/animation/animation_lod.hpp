@@ -0,0 +1,46 @@
+#pragma once
+#include <glm/vec3.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace le::graphics {
+///
+/// \brief Distance based animation update rate tiers, shared by all animators of a Scene.
+///
+/// Animators within tiers[i].distance (scaled per animator, eg by its size) of origin (the camera) update every tiers[i].interval frames.
+/// Tiers must be sorted by distance; animators beyond the last tier are paused.
+/// Update frames of throttled animators are staggered by their phase, to spread the work evenly across frames.
+/// Disabled by default (all animators update every frame): set enabled to opt in.
+///
+class AnimationLod {
+  public:
+	struct Tier {
+		float distance{};
+		///
+		/// \brief Frames between updates (0: paused).
+		///
+		std::uint32_t interval{1};
+	};
+
+	///
+	/// \brief Obtain the update interval of an animator at position.
+	/// \param scale Multiplier for tier distances
+	/// \returns 0 if paused, 1 if disabled
+	///
+	[[nodiscard]] auto get_interval(glm::vec3 position, float scale = 1.0f) const -> std::uint32_t;
+	///
+	/// \brief Check whether an animator with the given interval and phase should update this frame.
+	///
+	[[nodiscard]] auto is_update_frame(std::uint32_t interval, std::uint64_t phase) const -> bool;
+
+	[[nodiscard]] auto get_frame() const -> std::uint64_t { return m_frame; }
+	auto next_frame() -> void { ++m_frame; }
+
+	std::vector<Tier> tiers{{25.0f, 1}, {60.0f, 2}, {150.0f, 4}, {400.0f, 8}};
+	glm::vec3 origin{};
+	bool enabled{false};
+
+  private:
+	std::uint64_t m_frame{};
+};
+} // namespace le::graphics
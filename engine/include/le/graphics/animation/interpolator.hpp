@@ -13,9 +13,33 @@ constexpr auto lerp(glm::vec3 const& a, glm::vec3 const& b, float const t) -> gl
 
 inline auto lerp(glm::quat const& a, glm::quat const& b, float const t) -> glm::quat { return glm::slerp(a, b, t); }
 
+///
+/// \brief Cubic Hermite spline between (v0, out0) and (v1, in1), with tangents scaled by the segment duration dt.
+///
+template <typename T>
+constexpr auto hermite(T const& v0, T const& out0, T const& v1, T const& in1, float const t, float const dt) -> T {
+	auto const t2 = t * t;
+	auto const t3 = t2 * t;
+	return (2.0f * t3 - 3.0f * t2 + 1.0f) * v0 + (dt * (t3 - 2.0f * t2 + t)) * out0 + (-2.0f * t3 + 3.0f * t2) * v1 + (dt * (t3 - t2)) * in1;
+}
+
+inline auto hermite(glm::quat const& v0, glm::quat const& out0, glm::quat const& v1, glm::quat const& in1, float const t, float const dt) -> glm::quat {
+	return glm::normalize(hermite<glm::quat>(v0, out0, v1, in1, t, dt));
+}
+
 enum class Interpolation : std::uint8_t {
 	eLinear,
 	eStep,
+	eCubicSpline,
+};
+
+///
+/// \brief Per playback sampling state: remembers the last keyframe segment.
+///
+/// Sampling with a cursor while time moves forward is O(1) amortized; results are identical to sampling without one.
+///
+struct KeyframeCursor {
+	std::size_t index{};
 };
 
 template <typename T>
@@ -27,23 +51,67 @@ struct Interpolator {
 		Duration timestamp{};
 	};
 
+	///
+	/// \brief In / out tangents of a keyframe (per second), used by Interpolation::eCubicSpline.
+	///
+	struct Tangents {
+		T in{};
+		T out{};
+	};
+
 	std::vector<Keyframe> keyframes{};
+	///
+	/// \brief One entry per keyframe for eCubicSpline, otherwise empty.
+	///
+	/// Cubic splines without matching tangents are sampled linearly.
+	///
+	std::vector<Tangents> tangents{};
 	Interpolation interpolation{};
 
 	[[nodiscard]] auto duration() const -> Duration { return keyframes.empty() ? Duration{} : keyframes.back().timestamp; }
 
-	[[nodiscard]] auto index_for(Duration time) const -> std::optional<std::size_t> {
-		if (keyframes.empty()) { return {}; }
+	[[nodiscard]] auto index_for(Duration time) const -> std::optional<std::size_t> { return to_index(lower_bound(time, 0, keyframes.size())); }
+
+	///
+	/// \brief Obtain the index of the first keyframe at or after time, starting the search from cursor.
+	///
+	[[nodiscard]] auto index_for(Duration time, KeyframeCursor& cursor) const -> std::optional<std::size_t> {
+		auto const size = keyframes.size();
+		auto index = std::min(cursor.index, size);
+		if (index > 0 && !(keyframes[index - 1].timestamp < time)) {
+			// time moved backwards.
+			index = lower_bound(time, 0, index);
+		} else {
+			// time moved forwards: step through the next few keyframes, then fall back to a binary search.
+			auto const last = std::min(index + linear_steps_v, size);
+			while (index < last && keyframes[index].timestamp < time) { ++index; }
+			if (index == last && last < size && keyframes[index].timestamp < time) { index = lower_bound(time, index, size); }
+		}
+		cursor.index = index;
+		return to_index(index);
+	}
+
+	auto operator()(Duration elapsed) const -> std::optional<T> { return sample(elapsed, index_for(elapsed)); }
+	auto operator()(Duration elapsed, KeyframeCursor& cursor) const -> std::optional<T> { return sample(elapsed, index_for(elapsed, cursor)); }
+
+  private:
+	static constexpr std::size_t linear_steps_v{4};
+
+	[[nodiscard]] auto lower_bound(Duration time, std::size_t first, std::size_t last) const -> std::size_t {
+		auto const begin = keyframes.begin();
+		auto const it = std::lower_bound(begin + static_cast<std::ptrdiff_t>(first), begin + static_cast<std::ptrdiff_t>(last), time,
+										 [](Keyframe const& k, Duration time) { return k.timestamp < time; });
+		return static_cast<std::size_t>(it - begin);
+	}
 
-		auto const it = std::lower_bound(keyframes.begin(), keyframes.end(), time, [](Keyframe const& k, Duration time) { return k.timestamp < time; });
-		if (it == keyframes.end()) { return {}; }
-		return static_cast<std::size_t>(it - keyframes.begin());
+	[[nodiscard]] auto to_index(std::size_t const index) const -> std::optional<std::size_t> {
+		if (index >= keyframes.size()) { return {}; }
+		return index;
 	}
 
-	auto operator()(Duration elapsed) const -> std::optional<T> {
+	auto sample(Duration elapsed, std::optional<std::size_t> const i_next) const -> std::optional<T> {
 		if (keyframes.empty()) { return {}; }
 
-		auto const i_next = index_for(elapsed);
 		if (!i_next) { return keyframes.back().value; }
 
 		assert(*i_next < keyframes.size());
@@ -55,7 +123,11 @@ struct Interpolator {
 		assert(prev.timestamp < elapsed);
 		if (interpolation == Interpolation::eStep) { return prev.value; }
 
-		auto const t = (elapsed - prev.timestamp) / (next.timestamp - prev.timestamp);
+		auto const dt = next.timestamp - prev.timestamp;
+		auto const t = (elapsed - prev.timestamp) / dt;
+		if (interpolation == Interpolation::eCubicSpline && tangents.size() == keyframes.size()) {
+			return hermite(prev.value, tangents[*i_next - 1].out, next.value, tangents[*i_next].in, t, dt.count());
+		}
 		using graphics::lerp;
 		using std::lerp;
 		return lerp(prev.value, next.value, t);
@@ -0,0 +1,22 @@
+#pragma once
+#include <glm/vec3.hpp>
+#include <le/graphics/geometry.hpp>
+#include <span>
+
+namespace le::graphics {
+///
+/// \brief Local space bounding volume of a Primitive: an axis aligned box and its enclosing sphere.
+///
+struct Bounds {
+	glm::vec3 centre{};
+	glm::vec3 half_extent{};
+	///
+	/// \brief Radius of the bounding sphere, negative if unbounded (eg no geometry).
+	///
+	float radius{-1.0f};
+
+	static auto from(std::span<Vertex const> vertices) -> Bounds;
+
+	[[nodiscard]] auto is_bounded() const -> bool { return radius >= 0.0f; }
+};
+} // namespace le::graphics
@@ -1,60 +1,187 @@
 #pragma once
+#include <le/core/flat_hash_map.hpp>
 #include <le/core/mono_instance.hpp>
 #include <le/core/not_null.hpp>
+#include <le/core/thread_pool.hpp>
+#include <le/core/time.hpp>
 #include <le/graphics/cache/shader_cache.hpp>
 #include <le/graphics/pipeline_state.hpp>
 #include <le/graphics/shader.hpp>
 #include <le/graphics/shader_layout.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <optional>
 #include <span>
 #include <unordered_map>
+#include <vector>
 
 namespace le::graphics {
 class PipelineCache : public MonoInstance<PipelineCache> {
   public:
-	explicit PipelineCache(ShaderLayout shader_layout = {});
+	///
+	/// \brief Prefix of serialized (on-disk) Vulkan pipeline cache data.
+	///
+	/// Cache data from a different device / driver is rejected before being handed to the driver.
+	///
+	struct DiskHeader {
+		static constexpr auto magic_v = std::array{'L', 'E', 'P', 'C'};
+		static constexpr std::uint32_t version_v{1};
 
-	[[nodiscard]] auto shader_layout() const -> ShaderLayout const& { return m_shader_layout; }
-	auto set_shader_layout(ShaderLayout shader_layout) -> void;
+		std::array<char, 4> magic{magic_v};
+		std::uint32_t version{version_v};
+		std::uint32_t vendor_id{};
+		std::uint32_t device_id{};
+		std::uint32_t driver_version{};
+		std::array<std::uint8_t, VK_UUID_SIZE> device_uuid{};
+		std::array<std::uint8_t, VK_UUID_SIZE> cache_uuid{};
+		std::uint64_t data_size{};
 
-	[[nodiscard]] auto load(PipelineFormat format, Shader shader, PipelineState state, vk::PolygonMode polygon_mode) -> vk::Pipeline;
+		[[nodiscard]] static auto make(vk::PhysicalDeviceProperties const& properties, std::span<std::uint8_t const, VK_UUID_SIZE> device_uuid) -> DiskHeader;
+		///
+		/// \brief Parse the header at the start of bytes.
+		/// \returns Header if bytes are large enough to contain it and its data, and magic and version match
+		///
+		[[nodiscard]] static auto read(std::span<std::byte const> bytes) -> std::optional<DiskHeader>;
 
-	[[nodiscard]] auto pipeline_layout() const -> vk::PipelineLayout { return *m_pipeline_layout; }
-	[[nodiscard]] auto descriptor_set_layouts() const -> std::span<vk::DescriptorSetLayout const> { return m_descriptor_set_layouts_view; }
-
-	[[nodiscard]] auto shader_count() const -> std::size_t { return m_shader_cache.shader_count(); }
-	[[nodiscard]] auto pipeline_count() const -> std::size_t { return m_pipelines.size(); }
+		///
+		/// \brief Check whether cache data with this header can be used on the device described by rhs.
+		///
+		[[nodiscard]] auto is_compatible(DiskHeader const& rhs) const -> bool;
+		auto write_to(std::vector<std::byte>& out) const -> void;
+	};
 
-	auto clear_pipelines() -> void;
-	auto clear_pipelines_and_shaders() -> void;
+	///
+	/// \brief Pipeline compilation counts (since construction).
+	///
+	struct Stats {
+		///
+		/// \brief Pipelines created from Vulkan pipeline cache data.
+		///
+		std::uint64_t hits{};
+		///
+		/// \brief Pipelines compiled by the driver.
+		///
+		std::uint64_t misses{};
+		///
+		/// \brief Pipelines being compiled in the background.
+		///
+		std::uint64_t pending{};
+		///
+		/// \brief Total time spent compiling pipelines (across all threads).
+		///
+		Duration compile_time{};
+	};
 
-  private:
+	///
+	/// \brief Identity of a pipeline: every input baked into it.
+	///
+	/// PipelineState::line_width is dynamic state (set per draw), and is normalized out.
+	/// Equality is exact (the hash is only used to filter candidates).
+	///
 	struct Key {
-	  public:
 		Key(PipelineFormat format, Shader shader, PipelineState state, vk::PolygonMode polygon_mode);
 
-		[[nodiscard]] auto hash() const -> std::size_t { return cached_hash; }
+		[[nodiscard]] static auto make_hash(PipelineFormat format, Shader const& shader, PipelineState const& state, vk::PolygonMode polygon_mode)
+			-> std::uint64_t;
+
+		[[nodiscard]] auto hash() const -> std::uint64_t { return cached_hash; }
+		[[nodiscard]] auto matches(PipelineFormat format, Shader const& shader, PipelineState const& state, vk::PolygonMode polygon_mode) const -> bool;
 
-		auto operator==(Key const& rhs) const -> bool { return hash() == rhs.hash(); }
+		auto operator==(Key const& rhs) const -> bool { return hash() == rhs.hash() && matches(rhs.format, rhs.shader, rhs.state, rhs.polygon_mode); }
 
 		PipelineFormat format{};
 		Shader shader{};
 		PipelineState state{};
 		vk::PolygonMode polygon_mode{};
-		std::size_t cached_hash{};
+		std::uint64_t cached_hash{};
 	};
 
 	struct Hasher {
-		auto operator()(Key const& key) const -> std::size_t { return key.hash(); }
+		auto operator()(Key const& key) const -> std::uint64_t { return key.hash(); }
+	};
+
+	///
+	/// \brief Number of worker threads used for background compilation.
+	///
+	[[nodiscard]] static auto default_compile_threads() -> std::size_t;
+
+	explicit PipelineCache(ShaderLayout shader_layout = {});
+
+	[[nodiscard]] auto shader_layout() const -> ShaderLayout const& { return m_shader_layout; }
+	auto set_shader_layout(ShaderLayout shader_layout) -> void;
+
+	///
+	/// \brief Obtain the pipeline for the given parameters, building it if required.
+	/// \returns Null pipeline if shaders failed to load, or if skip_unready is set and the pipeline is not yet compiled
+	///
+	/// Time spent building / waiting for pipelines is recorded in FrameProfile::pipeline_compile.
+	///
+	[[nodiscard]] auto load(PipelineFormat format, Shader const& shader, PipelineState const& state, vk::PolygonMode polygon_mode) -> vk::Pipeline;
+	///
+	/// \brief Enqueue a pipeline for compilation on a worker thread.
+	/// \returns false if the pipeline is already built / pending, or shaders failed to load
+	///
+	auto prewarm(PipelineFormat format, Shader shader, PipelineState state, vk::PolygonMode polygon_mode) -> bool;
+	///
+	/// \brief Block until all pending pipelines are compiled.
+	///
+	auto wait_pending() -> void;
+
+	[[nodiscard]] auto pipeline_layout() const -> vk::PipelineLayout { return *m_pipeline_layout; }
+	[[nodiscard]] auto descriptor_set_layouts() const -> std::span<vk::DescriptorSetLayout const> { return m_descriptor_set_layouts_view; }
+
+	[[nodiscard]] auto shader_count() const -> std::size_t { return m_shader_cache.shader_count(); }
+	[[nodiscard]] auto pipeline_count() const -> std::size_t { return m_pipelines.size(); }
+	[[nodiscard]] auto get_stats() const -> Stats;
+
+	///
+	/// \brief Recreate the Vulkan pipeline cache from previously serialized data.
+	/// \returns false if data is missing, or was written on an incompatible device / driver (cache will be empty)
+	///
+	auto load_vk_cache(std::span<std::byte const> bytes) -> bool;
+	///
+	/// \brief Serialize the Vulkan pipeline cache (with a DiskHeader).
+	///
+	[[nodiscard]] auto serialize_vk_cache() const -> std::vector<std::byte>;
+
+	auto clear_pipelines() -> void;
+	auto clear_pipelines_and_shaders() -> void;
+
+	///
+	/// \brief Skip draws (return null pipelines) instead of stalling on pipeline compilation.
+	///
+	/// Unseen pipelines are enqueued for background compilation, and returned once ready.
+	///
+	bool skip_unready{};
+
+  private:
+	struct Modules {
+		vk::ShaderModule vertex{};
+		vk::ShaderModule fragment{};
 	};
 
-	[[nodiscard]] auto build(Key const& key) -> vk::UniquePipeline;
+	[[nodiscard]] auto load_modules(Shader const& shader) -> std::optional<Modules>;
+	[[nodiscard]] auto build(Key const& key, Modules modules) -> vk::UniquePipeline;
+	auto enqueue(Key const& key, Modules modules) -> void;
+	auto insert(Key const& key, vk::UniquePipeline pipeline) -> vk::Pipeline;
+	[[nodiscard]] auto make_disk_header() const -> DiskHeader;
 
-	std::unordered_map<Key, vk::UniquePipeline, Hasher> m_pipelines{};
+	FlatHashMap<Key, vk::UniquePipeline, Hasher> m_pipelines{};
 	ShaderCache m_shader_cache{};
 	ShaderLayout m_shader_layout{};
 	std::vector<vk::UniqueDescriptorSetLayout> m_descriptor_set_layouts{};
 	std::vector<vk::DescriptorSetLayout> m_descriptor_set_layouts_view{};
 	vk::UniquePipelineLayout m_pipeline_layout{};
+	vk::UniquePipelineCache m_vk_cache{};
 	vk::Device m_device{};
+
+	std::unordered_map<Key, std::future<vk::UniquePipeline>, Hasher> m_pending{};
+	std::atomic<std::uint64_t> m_hits{};
+	std::atomic<std::uint64_t> m_misses{};
+	std::atomic<std::int64_t> m_compile_ns{};
+	// declared last: worker threads must be joined before anything they reference is destroyed.
+	ThreadPool m_compile_pool{default_compile_threads()};
 };
 } // namespace le::graphics
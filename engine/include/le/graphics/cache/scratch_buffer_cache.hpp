@@ -4,27 +4,64 @@
 #include <le/graphics/resource.hpp>
 #include <vulkan/vulkan_hash.hpp>
 #include <memory>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
 namespace le::graphics {
+///
+/// \brief Per-frame linear arenas of persistently mapped host buffers, one per buffer usage.
+///
+/// Allocations are sub-allocated at the device's minimum offset alignment for their usage,
+/// and are valid until the same frame index comes around again.
+///
 class ScratchBufferCache : public MonoInstance<ScratchBufferCache> {
   public:
-	auto allocate_host(vk::BufferUsageFlags usage) -> HostBuffer&;
+	static constexpr std::size_t block_size_v{64 * 1024};
+
+	struct Allocation {
+		vk::Buffer buffer{};
+		vk::DeviceSize offset{};
+		vk::DeviceSize size{};
+		std::span<std::byte> mapped{};
+
+		[[nodiscard]] auto descriptor_info() const -> vk::DescriptorBufferInfo { return {buffer, offset, size}; }
+	};
+
+	struct Stats {
+		std::size_t bytes_used{};
+		std::size_t high_water{};
+		std::size_t capacity{};
+		std::size_t buffers{};
+	};
+
+	ScratchBufferCache();
+
+	auto allocate(vk::BufferUsageFlags usage, std::size_t size) -> Allocation;
+	auto write(vk::BufferUsageFlags usage, void const* data, std::size_t size) -> Allocation;
 	auto get_empty_buffer(vk::BufferUsageFlags usage) -> DeviceBuffer const&;
 
+	[[nodiscard]] auto get_alignment(vk::BufferUsageFlags usage) const -> std::size_t;
+	[[nodiscard]] auto get_stats() const -> Stats;
+
 	auto next_frame() -> void;
 	auto clear() -> void;
 
   private:
-	struct Pool {
-		std::vector<std::unique_ptr<HostBuffer>> buffers{};
+	struct Arena {
+		std::vector<std::unique_ptr<HostBuffer>> blocks{};
 		std::unique_ptr<DeviceBuffer> empty_buffer{};
-		std::size_t next{};
+		std::size_t block{};
+		std::size_t offset{};
 	};
 
-	using Map = std::unordered_map<vk::BufferUsageFlags, Pool>;
+	using Map = std::unordered_map<vk::BufferUsageFlags, Arena>;
 
 	Buffered<Map> m_maps{};
+	std::size_t m_storage_alignment{};
+	std::size_t m_uniform_alignment{};
+	std::size_t m_frame_used{};
+	std::size_t m_last_frame_used{};
+	std::size_t m_high_water{};
 };
 } // namespace le::graphics
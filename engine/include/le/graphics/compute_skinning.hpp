@@ -0,0 +1,119 @@
+#pragma once
+#include <glm/mat4x4.hpp>
+#include <le/core/ptr.hpp>
+#include <le/graphics/buffering.hpp>
+#include <le/graphics/cache/shader_cache.hpp>
+#include <le/graphics/primitive.hpp>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace le::graphics {
+///
+/// \brief Skins primitives with bones in a compute pre-pass, into cached vertex buffers drawn with a plain vertex shader.
+///
+/// Each (primitive, joints) pair owns one output buffer per frame in flight, which is only re-skinned when its joints change:
+/// a pose is skinned once per frame regardless of how many passes draw it, and static poses are not skinned at all.
+/// Outputs not used for a few frames are released.
+///
+/// Requires a compute capable queue, and skin.comp / pre_skinned.vert (SPIR-V) in the VFS. Objects that cannot be skinned here fall back to the material's shader.
+/// Outputs are skinned by skin.comp with the same math as skinned.vert (CPU reference: skin_vertex()).
+///
+class ComputeSkinning {
+  public:
+	static constexpr auto compute_shader_v{"shaders/skin.comp"};
+	///
+	/// \brief Material vertex shader replaced for skinned outputs: objects using any other vertex shader are not skinned here.
+	///
+	static constexpr auto material_vertex_shader_v{"shaders/skinned.vert"};
+	///
+	/// \brief Vertex shader that draws skinned outputs (same conventions as material_vertex_shader_v).
+	///
+	static constexpr auto vertex_shader_v{"shaders/pre_skinned.vert"};
+	static constexpr std::uint32_t local_size_v{64};
+	///
+	/// \brief Number of frames an unused output is retained for.
+	///
+	static constexpr std::uint64_t retain_frames_v{2 * buffering_v};
+
+	struct Stats {
+		std::uint32_t outputs{};
+		std::uint32_t dispatches{};
+		std::uint32_t skipped{};
+	};
+
+	ComputeSkinning(ComputeSkinning const&) = delete;
+	ComputeSkinning(ComputeSkinning&&) = delete;
+	auto operator=(ComputeSkinning const&) -> ComputeSkinning& = delete;
+	auto operator=(ComputeSkinning&&) -> ComputeSkinning& = delete;
+
+	///
+	/// \brief Check whether the Device queue supports compute.
+	///
+	[[nodiscard]] static auto is_supported() -> bool;
+	///
+	/// \brief Check whether outputs can be drawn in place of a material's vertex_shader.
+	///
+	[[nodiscard]] static auto replaces(Uri const& vertex_shader) -> bool { return vertex_shader.value() == material_vertex_shader_v; }
+
+	ComputeSkinning();
+	~ComputeSkinning();
+
+	///
+	/// \brief Obtain the skinned vertices of primitive posed by joints this frame, recording a dispatch into cmd if required.
+	/// \returns Null buffer if primitive has no skin source or the compute pipeline is unavailable
+	///
+	/// Must be called outside a render pass; call barrier() before any draws that use the returned buffers.
+	///
+	[[nodiscard]] auto skin(Primitive const& primitive, std::span<glm::mat4 const> joints, vk::CommandBuffer cmd) -> vk::Buffer;
+	///
+	/// \brief Make outputs skinned this frame visible to vertex input (no-op if nothing was dispatched).
+	///
+	auto barrier(vk::CommandBuffer cmd) -> void;
+
+	[[nodiscard]] auto get_stats() const -> Stats;
+
+	auto next_frame() -> void;
+	auto clear() -> void;
+
+  private:
+	struct Key {
+		Ptr<Primitive const> primitive{};
+		Ptr<glm::mat4 const> joints{};
+
+		auto operator==(Key const&) const -> bool = default;
+	};
+
+	struct Hasher {
+		auto operator()(Key const& key) const -> std::size_t;
+	};
+
+	struct Output {
+		std::unique_ptr<DeviceBuffer> vertices{};
+		std::vector<glm::mat4> joints{};
+		std::uint64_t generation{};
+	};
+
+	struct Slot {
+		Buffered<Output> outputs{};
+		std::uint64_t last_used{};
+	};
+
+	auto create_pipeline() -> bool;
+	auto dispatch(Primitive::SkinSource const& source, std::uint32_t vertex_count, Output& out, std::span<glm::mat4 const> joints, vk::CommandBuffer cmd)
+		-> void;
+
+	ShaderCache m_shader_cache{};
+	vk::UniqueDescriptorSetLayout m_set_layout{};
+	vk::UniquePipelineLayout m_pipeline_layout{};
+	vk::UniquePipeline m_pipeline{};
+	bool m_pipeline_failed{};
+
+	std::unordered_map<Key, Slot, Hasher> m_slots{};
+	Stats m_stats{};
+	Stats m_last_stats{};
+	std::uint64_t m_frame_count{};
+	bool m_dispatched{};
+};
+} // namespace le::graphics
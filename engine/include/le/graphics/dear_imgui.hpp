@@ -1,4 +1,5 @@
 #pragma once
+#include <glm/vec2.hpp>
 #include <le/core/ptr.hpp>
 #include <vulkan/vulkan.hpp>
 
@@ -13,7 +14,11 @@ class DearImGui {
 	auto operator=(DearImGui&&) -> DearImGui& = delete;
 	auto operator=(DearImGui const&) -> DearImGui& = delete;
 
-	DearImGui(Ptr<GLFWwindow> window, vk::Format colour);
+	///
+	/// \param window GLFW window to source input from; headless (no input, fixed display size) if null
+	/// \param headless_extent Display size when window is null
+	///
+	DearImGui(Ptr<GLFWwindow> window, vk::Format colour, glm::uvec2 headless_extent = {});
 	~DearImGui();
 
 	auto new_frame() -> void;
@@ -24,6 +29,8 @@ class DearImGui {
 	enum class State { eNewFrame, eEndFrame };
 
 	vk::UniqueDescriptorPool m_pool{};
+	glm::vec2 m_headless_extent{};
 	State m_state{};
+	bool m_headless{};
 };
 } // namespace le::graphics
@@ -25,6 +25,10 @@ class DescriptorUpdater {
 	[[nodiscard]] auto get_descriptor_set() const -> vk::DescriptorSet { return m_descriptor_set; }
 
 	static auto bind_set(std::uint32_t set, vk::DescriptorSet descriptor_set, vk::CommandBuffer cmd) -> void;
+	///
+	/// \brief Obtain the total number of descriptor sets bound so far.
+	///
+	static auto bind_count() -> std::uint64_t;
 
   private:
 	auto write(std::uint32_t binding, vk::DescriptorType type, void const* data, std::size_t size, vk::DeviceSize count) -> DescriptorUpdater&;
@@ -3,14 +3,22 @@
 #include <le/graphics/allocator.hpp>
 #include <le/graphics/font/font_library.hpp>
 #include <vulkan/vulkan.hpp>
+#include <array>
 #include <limits>
 #include <mutex>
+#include <span>
 
 struct GLFWwindow;
 
 namespace le::graphics {
+class UploadQueue;
+
 struct RenderDeviceCreateInfo {
 	bool validation{};
+	///
+	/// \brief Enable descriptor indexing (bindless MaterialTable) if the GPU supports it.
+	///
+	bool bindless{true};
 };
 
 class Device : public MonoInstance<Device> {
@@ -22,6 +30,12 @@ class Device : public MonoInstance<Device> {
 	struct Info {
 		bool validation{};
 		bool portability{};
+		bool headless{};
+		bool bindless{};
+		///
+		/// \brief Whether uploads are submitted to a dedicated transfer queue (distinct family from the graphics queue).
+		///
+		bool dedicated_transfer{};
 	};
 
 	Device(Device const&) = delete;
@@ -29,16 +43,29 @@ class Device : public MonoInstance<Device> {
 	auto operator=(Device const&) -> Device& = delete;
 	auto operator=(Device&&) -> Device& = delete;
 
+	///
+	/// \brief Create the Vulkan instance and device.
+	/// \param window Window to create a surface for; headless (no surface / swapchain support) if null
+	///
 	explicit Device(Ptr<GLFWwindow> window, CreateInfo const& create_info = {});
 	~Device();
 
 	[[nodiscard]] auto get_instance() const -> vk::Instance { return *m_instance; }
-	[[nodiscard]] auto get_surface() const -> vk::SurfaceKHR { return *m_surface; }
+	[[nodiscard]] auto get_surface() const -> vk::SurfaceKHR { return m_surface.get(); }
 	[[nodiscard]] auto get_physical_device() const -> vk::PhysicalDevice { return m_physical_device; }
 	[[nodiscard]] auto get_device() const -> vk::Device { return *m_device; }
 	[[nodiscard]] auto get_queue() const -> vk::Queue { return m_queue; }
 	[[nodiscard]] auto get_allocator() const -> Allocator& { return *m_allocator; }
 	[[nodiscard]] auto get_queue_family() const -> std::uint32_t { return m_queue_family; }
+	///
+	/// \brief Obtain the transfer queue (same as get_queue() if the GPU has no dedicated transfer family).
+	///
+	[[nodiscard]] auto get_transfer_queue() const -> vk::Queue { return m_transfer_queue; }
+	[[nodiscard]] auto get_transfer_queue_family() const -> std::uint32_t { return m_transfer_family; }
+	///
+	/// \brief Obtain all distinct queue families in use (for concurrently shared resources).
+	///
+	[[nodiscard]] auto get_queue_families() const -> std::span<std::uint32_t const>;
 
 	[[nodiscard]] auto get_font_library() const -> FontLibrary& { return *m_font_library; }
 
@@ -49,11 +76,13 @@ class Device : public MonoInstance<Device> {
 
 	[[nodiscard]] auto acquire_next_image(vk::SwapchainKHR swapchain, std::uint32_t& out_image_index, vk::Semaphore signal) const -> vk::Result;
 	auto submit(vk::SubmitInfo2 const& submit_info, vk::Fence signal = {}) const -> bool;
+	auto submit_transfer(vk::SubmitInfo2 const& submit_info, vk::Fence signal = {}) const -> bool;
 	auto submit_and_present(vk::SubmitInfo2 const& submit_info, vk::Fence submit_signal, vk::PresentInfoKHR const& present_info) const -> vk::Result;
 
   private:
 	Info m_info{};
 	mutable std::mutex m_mutex{};
+	mutable std::mutex m_transfer_mutex{};
 
 	vk::UniqueInstance m_instance{};
 	vk::UniqueDebugUtilsMessengerEXT m_debug_messenger{};
@@ -61,10 +90,14 @@ class Device : public MonoInstance<Device> {
 	vk::PhysicalDevice m_physical_device{};
 	vk::UniqueDevice m_device{};
 	vk::Queue m_queue{};
+	vk::Queue m_transfer_queue{};
 	std::unique_ptr<Allocator> m_allocator{};
 	std::unique_ptr<FontLibrary> m_font_library{FontLibrary::make()};
+	std::unique_ptr<UploadQueue> m_upload_queue{};
 
 	vk::PhysicalDeviceProperties m_device_properties{};
 	std::uint32_t m_queue_family{};
+	std::uint32_t m_transfer_family{};
+	std::array<std::uint32_t, 2> m_queue_families{};
 };
 } // namespace le::graphics
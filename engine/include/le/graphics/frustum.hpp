@@ -0,0 +1,64 @@
+#pragma once
+#include <glm/mat4x4.hpp>
+#include <le/graphics/render_object.hpp>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace le::graphics {
+struct Sphere {
+	glm::vec3 centre{};
+	float radius{};
+};
+
+///
+/// \brief Six normalized world space planes (pointing inwards) extracted from a view-projection matrix.
+///
+struct Frustum {
+	std::array<glm::vec4, 6> planes{};
+
+	static auto from(glm::mat4 const& view_projection) -> Frustum;
+
+	[[nodiscard]] auto intersects(Sphere const& sphere) const -> bool;
+};
+
+///
+/// \brief Tests batches of bounding spheres against frustums, four at a time (SSE2 where available).
+///
+/// Spheres are stored as structure-of-arrays, so the same set can be tested against multiple frustums
+/// (eg camera and shadow) without being rebuilt.
+///
+class FrustumCuller {
+  public:
+	///
+	/// \brief Compute the world space bounding sphere of object (all its instances).
+	/// \returns Infinite sphere if object cannot be bounded (skinned, or primitive without bounds)
+	///
+	static auto world_sphere(RenderObject const& object) -> Sphere;
+
+	auto clear() -> void;
+	auto push(Sphere const& sphere) -> void;
+	auto push(RenderObject const& object) -> void { push(world_sphere(object)); }
+
+	[[nodiscard]] auto size() const -> std::size_t { return m_count; }
+
+	///
+	/// \brief Test all spheres against frustum.
+	/// \param out_visible Written 1 for each sphere that intersects the frustum, 0 otherwise (at least size() large)
+	/// \returns Number of visible spheres
+	///
+	auto cull(Frustum const& frustum, std::span<std::uint8_t> out_visible) const -> std::size_t;
+	///
+	/// \brief Reference implementation of cull(), always scalar.
+	///
+	auto cull_scalar(Frustum const& frustum, std::span<std::uint8_t> out_visible) const -> std::size_t;
+
+  private:
+	std::vector<float> m_x{};
+	std::vector<float> m_y{};
+	std::vector<float> m_z{};
+	std::vector<float> m_radius{};
+	std::size_t m_count{};
+};
+} // namespace le::graphics
@@ -1,4 +1,5 @@
 #pragma once
+#include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
@@ -113,4 +114,10 @@ auto make_cone(float xz_diam, float y_height, std::uint32_t xz_points, glm::vec4
 auto make_cylinder(float xz_diam, float y_height, std::uint32_t xz_points, glm::vec4 rgba = glm::vec4{1.0f}) -> Geometry;
 auto make_arrow(float stalk_diam, float stalk_height, std::uint32_t xz_points, glm::vec4 rgba = glm::vec4{1.0f}) -> Geometry;
 auto make_manipulator(float stalk_diam, float stalk_height, std::uint32_t xz_points, glm::vec4 rgba = glm::vec4{1.0f}) -> Geometry;
+
+///
+/// \brief Skin vertex with bone and joints on the CPU (reference for skinned.vert / skin.comp).
+/// \returns vertex with skinned position and normal, model space (before the instance transform)
+///
+auto skin_vertex(Vertex vertex, Bone const& bone, std::span<glm::mat4 const> joints) -> Vertex;
 } // namespace le::graphics
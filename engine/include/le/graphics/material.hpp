@@ -3,8 +3,11 @@
 #include <le/graphics/rgba.hpp>
 #include <le/graphics/shader.hpp>
 #include <le/graphics/texture.hpp>
+#include <optional>
 
 namespace le::graphics {
+class MaterialTable;
+
 enum class AlphaMode : std::uint32_t {
 	eOpaque = 0,
 	eBlend = 1,
@@ -29,20 +32,46 @@ class Material {
 
 	virtual auto bind_set(vk::CommandBuffer cmd) const -> void = 0;
 
+	///
+	/// \brief Write this material's parameters into the bindless MaterialTable (used instead of bind_set()).
+	/// \returns Index of the parameters in the table, or nullopt if unsupported / the table is full
+	///
+	[[nodiscard]] virtual auto push_to(MaterialTable& /*table*/) const -> std::optional<std::uint32_t> { return {}; }
+	///
+	/// \brief Obtain the shader to draw with when push_to() succeeds.
+	///
+	[[nodiscard]] virtual auto get_bindless_shader() const -> Shader { return get_shader(); }
+	///
+	/// \brief Check whether push_to() / get_bindless_shader() apply (otherwise get_shader() and bind_set() are used).
+	///
+	[[nodiscard]] virtual auto uses_bindless() const -> bool { return false; }
+
 	[[nodiscard]] auto is_transparent() const -> bool { return get_alpha_mode() == AlphaMode::eBlend; }
 };
 
 class UnlitMaterial : public Material {
   public:
 	static constexpr std::string_view material_type_v{"unlit"};
+	static constexpr auto fragment_v{"shaders/unlit.frag"};
 
 	[[nodiscard]] auto get_shader() const -> Shader const& override { return shader; }
 	[[nodiscard]] auto get_alpha_mode() const -> AlphaMode final { return AlphaMode::eBlend; }
 	[[nodiscard]] auto cast_shadow() const -> bool final { return false; }
 
 	auto bind_set(vk::CommandBuffer cmd) const -> void override;
+	[[nodiscard]] auto push_to(MaterialTable& table) const -> std::optional<std::uint32_t> override;
+	[[nodiscard]] auto get_bindless_shader() const -> Shader override { return uses_bindless() ? Shader{shader.vertex, bindless_fragment} : shader; }
 
-	Shader shader{"shaders/unlit.vert", "shaders/unlit.frag"};
+	///
+	/// \brief True only with the stock fragment shader (fragment_v).
+	///
+	[[nodiscard]] auto uses_bindless() const -> bool override { return !bindless_fragment.is_empty() && shader.fragment.value() == fragment_v; }
+
+	Shader shader{"shaders/unlit.vert", fragment_v};
+	///
+	/// \brief Fragment shader reading from the MaterialTable, replaces fragment_v (custom fragment shaders always use bind_set()).
+	///
+	Uri bindless_fragment{"shaders/unlit_bindless.frag"};
 
 	Ptr<Texture const> texture{};
 };
@@ -50,6 +79,7 @@ class UnlitMaterial : public Material {
 class LitMaterial : public Material {
   public:
 	static constexpr std::string_view material_type_v{"lit"};
+	static constexpr auto fragment_v{"shaders/lit.frag"};
 
 	struct Std140 {
 		glm::vec4 albedo;
@@ -62,8 +92,19 @@ class LitMaterial : public Material {
 	[[nodiscard]] auto cast_shadow() const -> bool override { return !is_transparent(); }
 
 	auto bind_set(vk::CommandBuffer cmd) const -> void override;
-
-	Shader shader{"shaders/lit.vert", "shaders/lit.frag"};
+	[[nodiscard]] auto push_to(MaterialTable& table) const -> std::optional<std::uint32_t> override;
+	[[nodiscard]] auto get_bindless_shader() const -> Shader override { return uses_bindless() ? Shader{shader.vertex, bindless_fragment} : shader; }
+
+	///
+	/// \brief True only with the stock fragment shader (fragment_v).
+	///
+	[[nodiscard]] auto uses_bindless() const -> bool override { return !bindless_fragment.is_empty() && shader.fragment.value() == fragment_v; }
+
+	Shader shader{"shaders/lit.vert", fragment_v};
+	///
+	/// \brief Fragment shader reading from the MaterialTable, replaces fragment_v (custom fragment shaders always use bind_set()).
+	///
+	Uri bindless_fragment{"shaders/lit_bindless.frag"};
 
 	Ptr<Texture const> base_colour{};
 	Ptr<Texture const> metallic_roughness{};
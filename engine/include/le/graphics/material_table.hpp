@@ -0,0 +1,116 @@
+#pragma once
+#include <glm/vec4.hpp>
+#include <le/core/flat_hash_map.hpp>
+#include <le/core/mono_instance.hpp>
+#include <le/graphics/buffering.hpp>
+#include <le/graphics/texture.hpp>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace le::graphics {
+class Material;
+
+///
+/// \brief Bindless material descriptors: a persistent array of sampled images and a per-frame buffer of material parameters.
+///
+/// Textures are registered once (one descriptor write) and referenced by index thereafter.
+/// Materials write their parameters once per frame, draws select them through a push constant (ShaderLayout::MaterialTable).
+/// Texture slots not used by any frame in flight are recycled when the array is full.
+///
+/// Requires Device::Info::bindless; materials that cannot be expressed here fall back to Material::bind_set().
+///
+class MaterialTable : public MonoInstance<MaterialTable> {
+  public:
+	struct Std430 {
+		glm::vec4 albedo;
+		glm::vec4 m_r_aco_am;
+		glm::vec4 emissive;
+		glm::uvec4 textures;
+	};
+
+	struct Stats {
+		std::uint32_t textures{};
+		std::uint32_t materials{};
+		std::uint32_t texture_writes{};
+		std::uint32_t overflows{};
+	};
+
+	static constexpr std::uint32_t min_material_capacity_v{256};
+
+	MaterialTable(MaterialTable const&) = delete;
+	MaterialTable(MaterialTable&&) = delete;
+	auto operator=(MaterialTable const&) -> MaterialTable& = delete;
+	auto operator=(MaterialTable&&) -> MaterialTable& = delete;
+
+	MaterialTable();
+
+	///
+	/// \brief Obtain the index of texture in the sampled image array, registering it if required.
+	/// \returns nullopt if the array is full
+	///
+	[[nodiscard]] auto texture_index(Texture const& texture) -> std::optional<std::uint32_t>;
+
+	///
+	/// \brief Obtain the index of material's parameters written this frame (if any).
+	///
+	[[nodiscard]] auto find(Material const& material) const -> std::optional<std::uint32_t>;
+	///
+	/// \brief Write material's parameters for this frame.
+	/// \returns nullopt if this frame's buffer is full (capacity grows from the next frame)
+	///
+	[[nodiscard]] auto push(Material const& material, Std430 const& params) -> std::optional<std::uint32_t>;
+
+	auto bind_set(vk::CommandBuffer cmd) const -> void;
+	static auto bind_material(std::uint32_t index, vk::CommandBuffer cmd) -> void;
+
+	[[nodiscard]] auto get_stats() const -> Stats;
+
+	auto next_frame() -> void;
+
+  private:
+	struct TextureKey {
+		std::uint64_t image_serial{};
+		vk::Sampler sampler{};
+
+		auto operator==(TextureKey const&) const -> bool = default;
+	};
+
+	struct TextureHasher {
+		auto operator()(TextureKey const& key) const -> std::size_t;
+	};
+
+	struct MaterialHasher {
+		auto operator()(Ptr<Material const> material) const -> std::uint64_t;
+	};
+
+	struct Slot {
+		TextureKey key{};
+		std::uint64_t last_used{};
+	};
+
+	struct Frame {
+		std::unique_ptr<HostBuffer> params{};
+		vk::DescriptorSet descriptor_set{};
+		FlatHashMap<Ptr<Material const>, std::uint32_t, MaterialHasher> materials{};
+	};
+
+	auto create_sets() -> void;
+	auto allocate_slot() -> std::optional<std::uint32_t>;
+	auto write_params_descriptor(Frame const& frame) const -> void;
+
+	vk::UniqueDescriptorPool m_pool{};
+	vk::DescriptorSetLayout m_layout{};
+	Buffered<Frame> m_frames{};
+
+	std::unordered_map<TextureKey, std::uint32_t, TextureHasher> m_textures{};
+	std::vector<Slot> m_slots{};
+	std::vector<std::uint32_t> m_free{};
+
+	Stats m_stats{};
+	Stats m_last_stats{};
+	std::uint64_t m_frame_count{};
+	std::uint32_t m_material_capacity{min_material_capacity_v};
+};
+} // namespace le::graphics
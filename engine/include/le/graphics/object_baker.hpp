@@ -0,0 +1,138 @@
+#pragma once
+#include <le/core/ptr.hpp>
+#include <le/core/thread_pool.hpp>
+#include <le/graphics/render_object.hpp>
+#include <cstddef>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace le::graphics {
+///
+/// \brief Packs instance and joint data of RenderObjects into one contiguous (GPU) buffer.
+///
+/// push() lays out every object serially (computing aligned offsets),
+/// write() then fills any subrange of entries independently, which allows writing in parallel.
+/// The written bytes do not depend on how the entries are split across threads.
+///
+/// With batching enabled, objects sharing material, primitive, pipeline state, and layer are merged into one Entry
+/// (a single instanced draw), with each object's parent folded into its instance transforms.
+/// Opaque depth-writing objects are merged across the whole list, others only with adjacent objects (preserving draw order).
+/// Skinned objects (with joints) are never merged.
+///
+/// Objects can be tagged with the passes they are drawn in: an entry (and its data) can then be shared by multiple passes.
+///
+class ObjectBaker {
+  public:
+	///
+	/// \brief Bitmask of passes an object is drawn in (not interpreted): only objects with identical masks are merged.
+	///
+	using PassMask = std::uint8_t;
+
+	static constexpr auto all_passes_v{PassMask{0xff}};
+
+	struct Std430Instance {
+		glm::mat4 transform;
+		glm::vec4 tint;
+	};
+
+	struct Range {
+		std::size_t offset{};
+		std::size_t size{};
+	};
+
+	struct Entry {
+		NotNull<RenderObject const*> object;
+		Range objects{};
+		Range instances{};
+		Range joints{};
+		std::uint32_t instance_count{};
+		PassMask passes{all_passes_v};
+	};
+
+	static constexpr std::size_t default_alignment_v{256};
+
+	///
+	/// \brief Check whether object can be merged with others regardless of draw order.
+	///
+	[[nodiscard]] static auto is_batchable(RenderObject const& object) -> bool;
+
+	///
+	/// \brief Obtain the instance / joint data offset alignment (minStorageBufferOffsetAlignment).
+	///
+	[[nodiscard]] auto get_alignment() const -> std::size_t { return m_alignment; }
+	auto set_alignment(std::size_t alignment) -> void;
+
+	auto clear() -> void;
+	///
+	/// \brief Lay out objects after any previously pushed ones.
+	/// \returns Number of entries added
+	///
+	auto push(std::span<RenderObject const> objects, PassMask passes = all_passes_v) -> std::size_t;
+	///
+	/// \brief Lay out objects (each drawn in the corresponding passes) after any previously pushed ones.
+	/// \param objects Pointers to objects, which must outlive any use of the entries
+	/// \param passes Pass mask of each object (at least objects.size() large)
+	/// \returns Number of entries added
+	///
+	auto push(std::span<Ptr<RenderObject const> const> objects, std::span<PassMask const> passes) -> std::size_t;
+
+	///
+	/// \brief Write entries [first, last) into out.
+	/// \param out Mapped buffer memory (at least size_bytes() large)
+	///
+	auto write(std::span<std::byte> out, std::size_t first, std::size_t last) const -> void;
+	///
+	/// \brief Write all entries into out, across worker threads of pool if non-null.
+	///
+	auto write(std::span<std::byte> out, Ptr<ThreadPool> pool = {}) const -> void;
+
+	[[nodiscard]] auto get_entries() const -> std::span<Entry const> { return m_entries; }
+	[[nodiscard]] auto size_bytes() const -> std::size_t { return m_size; }
+	///
+	/// \brief Obtain the number of objects merged into other entries (draw calls saved).
+	///
+	[[nodiscard]] auto merged_count() const -> std::size_t { return m_objects.size() - m_entries.size(); }
+
+	///
+	/// \brief Minimum entries per worker chunk (smaller lists are not worth splitting).
+	///
+	std::size_t min_chunk{256};
+	///
+	/// \brief Whether to merge compatible objects into instanced entries.
+	///
+	bool batching{true};
+
+  private:
+	struct Key {
+		Ptr<Material const> material{};
+		Ptr<Primitive const> primitive{};
+		PipelineState pipeline_state{};
+		std::int32_t layer{};
+		PassMask passes{};
+
+		auto operator==(Key const&) const -> bool = default;
+	};
+
+	struct Hasher {
+		auto operator()(Key const& key) const -> std::size_t;
+	};
+
+	struct Group {
+		Key key{};
+		std::vector<NotNull<RenderObject const*>> objects{};
+	};
+
+	auto allocate(std::size_t size) -> Range;
+
+	std::vector<Entry> m_entries{};
+	std::vector<NotNull<RenderObject const*>> m_objects{};
+	std::size_t m_size{};
+	std::size_t m_alignment{default_alignment_v};
+
+	std::vector<Group> m_groups{};
+	std::vector<Ptr<RenderObject const>> m_pointers{};
+	std::vector<PassMask> m_passes{};
+	std::unordered_map<Key, std::size_t, Hasher> m_batches{};
+};
+} // namespace le::graphics
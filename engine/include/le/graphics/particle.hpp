@@ -1,11 +1,14 @@
 #pragma once
+#include <le/core/enum_array.hpp>
 #include <le/core/inclusive_range.hpp>
+#include <le/core/random.hpp>
 #include <le/core/time.hpp>
 #include <le/core/transform.hpp>
 #include <le/graphics/material.hpp>
 #include <le/graphics/primitive.hpp>
 #include <le/graphics/render_object.hpp>
 #include <le/graphics/rgba.hpp>
+#include <optional>
 
 namespace le::graphics {
 struct Particle {
@@ -20,25 +23,6 @@ struct Particle {
 	};
 
 	using Modifiers = std::uint32_t;
-
-	struct {
-		glm::vec3 linear{};
-		Radians angular{};
-	} velocity{};
-
-	struct {
-		InclusiveRange<graphics::Rgba> tint{};
-		InclusiveRange<glm::vec2> scale{};
-	} lerp{};
-
-	Duration ttl{};
-
-	glm::vec3 position{};
-	Radians rotation{};
-	glm::vec2 scale{};
-	graphics::Rgba tint{};
-	Duration elapsed{};
-	float alpha{};
 };
 
 struct Particle::Config {
@@ -66,6 +50,12 @@ struct Particle::Config {
 	bool respawn{true};
 };
 
+///
+/// \brief Simulates particles as structure-of-arrays, four at a time (SSE2 where available).
+///
+/// Expired particles are swap-removed (draw order is not preserved).
+/// Scale and tint are interpolated between the current config.lerp ranges.
+///
 class Particle::Emitter {
   public:
 	Config config{};
@@ -75,15 +65,36 @@ class Particle::Emitter {
 
 	auto respawn_all(glm::quat const& view) -> void;
 	auto update(glm::quat const& view, Duration dt) -> void;
+	///
+	/// \brief Reference implementation of update(), always scalar.
+	///
+	auto update_scalar(glm::quat const& view, Duration dt) -> void;
 	[[nodiscard]] auto render_object() const -> graphics::RenderObject;
 
-	[[nodiscard]] auto active_particles() const -> std::size_t { return m_particles.size(); }
+	///
+	/// \brief Reseed the random number generator (for reproducible simulations).
+	///
+	auto seed(std::uint64_t value) -> void { m_random = Xoshiro128{value}; }
+
+	[[nodiscard]] auto active_particles() const -> std::size_t { return m_particles[Field::eTtl].size(); }
+	[[nodiscard]] auto get_instances() const -> std::span<RenderInstance const> { return m_instances; }
 
   private:
-	[[nodiscard]] auto make_particle() const -> Particle;
+	enum class Field : std::uint8_t { eX, eY, eZ, eVx, eVy, eVz, eRotation, eAngular, eElapsed, eTtl, eCOUNT_ };
+
+	struct Step;
+
+	auto prepare(glm::quat const& view, Duration dt) -> Step;
+	auto spawn() -> void;
+	auto swap_remove(std::size_t index) -> void;
+	auto integrate(Step const& step, std::size_t first, std::size_t last) -> void;
+	auto integrate_scalar(Step const& step, std::size_t first, std::size_t last) -> void;
 
-	std::unique_ptr<graphics::DynamicPrimitive> m_primitive{std::make_unique<graphics::DynamicPrimitive>()};
-	std::vector<Particle> m_particles{};
+	// created on first render_object(): simulation does not require a Device.
+	mutable std::unique_ptr<graphics::DynamicPrimitive> m_primitive{};
+	mutable std::optional<glm::vec2> m_quad_size{};
+	EnumArray<Field, std::vector<float>> m_particles{};
 	std::vector<graphics::RenderInstance> m_instances{};
+	Xoshiro128 m_random{std::random_device{}()};
 };
 } // namespace le::graphics
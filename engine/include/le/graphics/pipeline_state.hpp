@@ -12,5 +12,7 @@ struct PipelineState {
 	vk::CompareOp depth_compare{vk::CompareOp::eLess};
 	vk::Bool32 depth_test_write{vk::True};
 	float line_width{1.0f};
+
+	auto operator==(PipelineState const&) const -> bool = default;
 };
 } // namespace le::graphics
@@ -1,5 +1,6 @@
 #pragma once
 #include <le/core/ptr.hpp>
+#include <le/graphics/bounds.hpp>
 #include <le/graphics/buffering.hpp>
 #include <le/graphics/defer.hpp>
 #include <le/graphics/geometry.hpp>
@@ -21,6 +22,21 @@ class Primitive {
 		std::uint32_t vertex_count{};
 		std::uint32_t index_count{};
 		std::uint32_t bone_count{};
+		Bounds bounds{};
+	};
+
+	///
+	/// \brief Storage buffers read by ComputeSkinning.
+	///
+	struct SkinSource {
+		vk::Buffer vertices{};
+		vk::Buffer bones{};
+		///
+		/// \brief Incremented whenever the contents of vertices / bones change.
+		///
+		std::uint64_t generation{};
+
+		explicit operator bool() const { return vertices && bones; }
 	};
 
 	[[nodiscard]] auto layout() const -> Layout const& { return m_layout; }
@@ -29,6 +45,15 @@ class Primitive {
 	virtual auto set_geometry(Geometry&& geometry) -> void;
 	virtual auto draw(std::uint32_t instances, vk::CommandBuffer cmd) const -> void = 0;
 
+	///
+	/// \brief Obtain the buffers to skin on the GPU (null if not supported / no bones).
+	///
+	[[nodiscard]] virtual auto get_skin_source() const -> SkinSource { return {}; }
+	///
+	/// \brief Draw with vertices sourced from skinned_vertices (skinned from get_skin_source()), and without bones.
+	///
+	virtual auto draw_skinned(vk::Buffer /*skinned_vertices*/, std::uint32_t instances, vk::CommandBuffer cmd) const -> void { draw(instances, cmd); }
+
   protected:
 	struct Buffers {
 		vk::Buffer vertices{};
@@ -47,6 +72,9 @@ class StaticPrimitive : public Primitive {
 	auto set_geometry(Geometry const& geometry) -> void final;
 	auto draw(std::uint32_t instances, vk::CommandBuffer cmd) const -> void final;
 
+	[[nodiscard]] auto get_skin_source() const -> SkinSource final;
+	auto draw_skinned(vk::Buffer skinned_vertices, std::uint32_t instances, vk::CommandBuffer cmd) const -> void final;
+
   protected:
 	struct Data {
 		std::unique_ptr<DeviceBuffer> vertices_indices{};
@@ -55,6 +83,7 @@ class StaticPrimitive : public Primitive {
 	};
 
 	Defer<Data> m_data{};
+	std::uint64_t m_generation{};
 };
 
 class DynamicPrimitive : public Primitive {
@@ -23,11 +23,22 @@ struct RenderObject {
 	std::span<glm::mat4 const> joints{};
 
 	PipelineState pipeline_state{};
+	///
+	/// \brief Draw order bucket: lower layers are drawn first, regardless of sorting within a layer.
+	///
+	std::int32_t layer{};
 };
 
 struct RenderObject::Baked {
-	RenderObject object;
+	///
+	/// \brief Source object (the first one, if multiple were merged into this draw).
+	///
+	NotNull<RenderObject const*> object;
 	vk::DescriptorSet descriptor_set{};
 	std::uint32_t instance_count{};
+	///
+	/// \brief Vertices skinned by ComputeSkinning (drawn with its vertex shader instead of the material's), if any.
+	///
+	vk::Buffer skinned_vertices{};
 };
 } // namespace le::graphics
@@ -0,0 +1,65 @@
+#pragma once
+#include <le/core/ptr.hpp>
+#include <le/graphics/render_object.hpp>
+#include <span>
+#include <vector>
+
+namespace le::graphics {
+///
+/// \brief Sorts RenderObjects to minimize pipeline / descriptor set changes.
+///
+/// Layer order is always preserved (lower layers first).
+/// Within a layer, opaque depth-writing objects are drawn first, sorted by pipeline, material, primitive, then front-to-back.
+/// Blended (and non depth-writing) objects follow, sorted back-to-front first (required for correct blending), then by state.
+/// Sorting is stable: objects with identical keys retain their submission order.
+///
+class RenderSorter {
+  public:
+	enum class Mode : std::uint8_t {
+		eNone,	// submission order
+		eLayer, // layer only
+		eState, // layer, state, depth
+	};
+
+	struct Key {
+		std::int32_t layer{};
+		std::uint32_t ordered{};
+		float back_to_front{};
+		std::size_t pipeline{};
+		std::uintptr_t material{};
+		std::uintptr_t primitive{};
+		float front_to_back{};
+
+		auto operator<=>(Key const&) const = default;
+	};
+
+	///
+	/// \brief Build the sort key of object.
+	/// \param bindless Whether the object will be drawn with its material's bindless shader
+	///
+	[[nodiscard]] static auto make_key(RenderObject const& object, glm::vec3 const& eye, bool bindless = false) -> Key;
+
+	///
+	/// \brief Sort objects.
+	/// \param objects Objects to sort
+	/// \param eye Camera position (for depth sorting)
+	/// \returns Pointers into objects, in draw order (valid until next call)
+	///
+	auto sort(std::span<RenderObject const> objects, glm::vec3 const& eye) -> std::span<Ptr<RenderObject const> const>;
+
+	Mode mode{Mode::eState};
+	///
+	/// \brief Whether draws use Material::get_bindless_shader() (the MaterialTable is active).
+	///
+	bool bindless{};
+
+  private:
+	struct Item {
+		Key key{};
+		std::size_t index{};
+	};
+
+	std::vector<Item> m_items{};
+	std::vector<Ptr<RenderObject const>> m_sorted{};
+};
+} // namespace le::graphics
@@ -6,10 +6,16 @@
 #include <le/graphics/cache/sampler_cache.hpp>
 #include <le/graphics/cache/scratch_buffer_cache.hpp>
 #include <le/graphics/cache/vertex_buffer_cache.hpp>
+#include <le/graphics/compute_skinning.hpp>
 #include <le/graphics/dear_imgui.hpp>
 #include <le/graphics/defer.hpp>
 #include <le/graphics/fallback.hpp>
+#include <le/graphics/frustum.hpp>
+#include <le/graphics/material_table.hpp>
+#include <le/graphics/mesh.hpp>
+#include <le/graphics/object_baker.hpp>
 #include <le/graphics/render_frame.hpp>
+#include <le/graphics/render_sorter.hpp>
 #include <le/graphics/swapchain.hpp>
 #include <optional>
 #include <span>
@@ -22,6 +28,19 @@ struct RenderTarget {
 
 class Renderer : public MonoInstance<Renderer> {
   public:
+	///
+	/// \brief Per-frame render statistics.
+	///
+	struct Counters {
+		std::uint32_t draws_saved{};
+		std::uint32_t pipeline_binds{};
+		std::uint32_t descriptor_binds{};
+		std::uint32_t visible{};
+		std::uint32_t culled{};
+		std::uint32_t shadow_visible{};
+		std::uint32_t shadow_culled{};
+	};
+
 	static constexpr auto to_vsync_string(vk::PresentModeKHR mode) -> std::string_view;
 
 	Renderer(Renderer const&) = delete;
@@ -29,6 +48,11 @@ class Renderer : public MonoInstance<Renderer> {
 	auto operator=(Renderer const&) -> Renderer& = delete;
 	auto operator=(Renderer&&) -> Renderer& = delete;
 
+	///
+	/// \brief Create the Renderer.
+	///
+	/// If the Device is headless, frames are rendered into offscreen images (left in TransferSrcOptimal) instead of a Swapchain.
+	///
 	explicit Renderer(glm::uvec2 framebuffer_extent);
 	~Renderer();
 
@@ -36,6 +60,7 @@ class Renderer : public MonoInstance<Renderer> {
 	[[nodiscard]] static constexpr auto to_rect2d(vk::Viewport const& rect) -> vk::Rect2D;
 
 	[[nodiscard]] auto get_frame_index() const -> FrameIndex { return m_frame.frame_index; }
+	[[nodiscard]] auto is_headless() const -> bool { return m_headless; }
 	[[nodiscard]] auto get_colour_format() const -> vk::Format;
 	[[nodiscard]] auto get_depth_format() const -> vk::Format;
 
@@ -45,6 +70,18 @@ class Renderer : public MonoInstance<Renderer> {
 	[[nodiscard]] auto get_shader_layout() const -> ShaderLayout const& { return m_pipeline_cache.shader_layout(); }
 	[[nodiscard]] auto get_dear_imgui() const -> DearImGui& { return *m_imgui; }
 	[[nodiscard]] auto get_line_width_limit() const -> InclusiveRange<float> { return m_line_width_limit; }
+	///
+	/// \brief Obtain the bindless MaterialTable, if supported by the Device and bindless_materials is set.
+	///
+	[[nodiscard]] auto get_material_table() const -> Ptr<MaterialTable> { return bindless_materials ? m_material_table.get() : nullptr; }
+	[[nodiscard]] auto supports_bindless() const -> bool { return m_material_table != nullptr; }
+	///
+	/// \brief Obtain ComputeSkinning, if supported by the Device and compute_skinning is set.
+	///
+	[[nodiscard]] auto get_compute_skinning() const -> Ptr<ComputeSkinning> { return compute_skinning ? m_compute_skinning.get() : nullptr; }
+	[[nodiscard]] auto supports_compute_skinning() const -> bool { return m_compute_skinning != nullptr; }
+
+	[[nodiscard]] auto get_counters() const -> Counters const& { return m_counters; }
 
 	[[nodiscard]] auto wait_for_frame(glm::uvec2 framebuffer_extent) -> std::optional<std::uint32_t>;
 	auto render(RenderFrame const& render_frame, std::uint32_t image_index) -> std::uint32_t;
@@ -59,6 +96,14 @@ class Renderer : public MonoInstance<Renderer> {
 
 	auto set_imgui(std::unique_ptr<DearImGui> imgui) -> void { m_imgui = std::move(imgui); }
 
+	///
+	/// \brief Enqueue background compilation of the pipelines required to draw objects (including the shadow pass).
+	/// \returns Number of pipelines enqueued
+	///
+	auto prewarm(std::span<RenderObject const> objects) -> std::size_t;
+	auto prewarm(RenderFrame const& render_frame) -> std::size_t;
+	auto prewarm(Mesh const& mesh, PipelineState pipeline_state = {}) -> std::size_t;
+
 	auto bind_pipeline(vk::Pipeline pipeline) -> bool;
 	auto set_viewport(vk::Viewport viewport = {}) -> bool;
 	auto set_scissor(vk::Rect2D scissor) -> bool;
@@ -67,6 +112,18 @@ class Renderer : public MonoInstance<Renderer> {
 	glm::vec3 shadow_frustum{100.0f};
 	vk::Extent2D shadow_map_extent{2048, 2048};
 	vk::PolygonMode polygon_mode{vk::PolygonMode::eFill};
+	bool parallel_bake{true};
+	bool auto_instance{true};
+	RenderSorter::Mode sort_mode{RenderSorter::Mode::eState};
+	bool frustum_culling{true};
+	///
+	/// \brief Draw materials via the MaterialTable instead of allocating / writing a descriptor set per bind (if supported).
+	///
+	bool bindless_materials{true};
+	///
+	/// \brief Skin objects with joints once per frame in a compute pre-pass, shared by the shadow and scene passes (if supported).
+	///
+	bool compute_skinning{false};
 
   private:
 	struct Frame {
@@ -76,10 +133,13 @@ class Renderer : public MonoInstance<Renderer> {
 			vk::UniqueFence drawn{};
 			vk::UniqueCommandPool command_pool{};
 			vk::CommandBuffer command_buffer{};
+			vk::UniqueQueryPool timestamps{};
+			bool timestamps_written{};
 		};
 
 		Buffered<std::unique_ptr<Image>> depth_images{};
 		Buffered<std::unique_ptr<Image>> shadow_maps{};
+		Buffered<std::unique_ptr<Image>> offscreen_images{};
 		Buffered<Sync> syncs{};
 		FrameIndex frame_index{};
 
@@ -88,17 +148,14 @@ class Renderer : public MonoInstance<Renderer> {
 		glm::mat4 primary_light_mat{1.0f};
 		vk::Pipeline last_bound{};
 
-		static auto make(vk::Device device, std::uint32_t queue_family, vk::Format depth_format) -> Frame;
-	};
-
-	struct Std430Instance {
-		glm::mat4 transform;
-		glm::vec4 tint;
+		static auto make(vk::Device device, std::uint32_t queue_family, vk::Format depth_format, bool headless) -> Frame;
 	};
 
 	[[nodiscard]] auto acquire_next_image(glm::uvec2 framebuffer_extent) -> std::optional<std::uint32_t>;
-	auto bake_objects(std::span<RenderObject const> objects, std::vector<RenderObject::Baked>& out) -> void;
-	auto bake_objects(RenderFrame const& render_frame) -> void;
+	[[nodiscard]] auto get_offscreen_image() -> ImageView;
+	auto bake_objects(RenderFrame const& render_frame, Frustum const& camera_frustum, Frustum const& shadow_frustum, vk::CommandBuffer cmd) -> void;
+	auto cull_objects(std::span<Ptr<RenderObject const> const> scene, Frustum const& camera_frustum, Frustum const& shadow_frustum) -> void;
+	auto read_timestamps(Frame::Sync& sync) const -> void;
 
 	std::unique_ptr<DearImGui> m_imgui{};
 	PipelineCache m_pipeline_cache{};
@@ -111,13 +168,31 @@ class Renderer : public MonoInstance<Renderer> {
 	DeferQueue m_defer{};
 
 	Fallback m_fallback{};
-
-	std::vector<Std430Instance> m_instances{};
+	std::unique_ptr<MaterialTable> m_material_table{};
+	std::unique_ptr<ComputeSkinning> m_compute_skinning{};
+
+	RenderSorter m_sorter{};
+	FrustumCuller m_culler{};
+	struct {
+		std::vector<Ptr<RenderObject const>> objects{};
+		std::vector<ObjectBaker::PassMask> passes{};
+		std::vector<std::uint8_t> camera_mask{};
+		std::vector<std::uint8_t> shadow_mask{};
+	} m_visible{};
+	ObjectBaker m_object_baker{};
+	ThreadPool m_bake_pool{};
+	std::vector<DescriptorUpdater> m_object_sets{};
 	std::vector<RenderObject::Baked> m_scene_objects{};
+	std::vector<RenderObject::Baked> m_shadow_objects{};
 	std::vector<RenderObject::Baked> m_ui_objects{};
+	std::vector<vk::SemaphoreSubmitInfo> m_submit_waits{};
 	InclusiveRange<float> m_line_width_limit{};
+	Counters m_counters{};
+	float m_timestamp_period{};
+	std::uint64_t m_timestamp_mask{};
 
 	bool m_rendering{};
+	bool m_headless{};
 };
 
 constexpr auto Renderer::to_vsync_string(vk::PresentModeKHR const mode) -> std::string_view {
@@ -1,6 +1,7 @@
 #pragma once
 #include <vk_mem_alloc.h>
 #include <le/graphics/bitmap.hpp>
+#include <le/graphics/upload_queue.hpp>
 #include <vulkan/vulkan.hpp>
 #include <span>
 
@@ -15,11 +16,19 @@ class Resource {
 	virtual ~Resource() = default;
 
 	[[nodiscard]] auto allocation() const -> VmaAllocation { return m_allocation; }
+	///
+	/// \brief Obtain the ticket of the last upload into this resource (completed once its contents are visible on the GPU).
+	///
+	[[nodiscard]] auto upload_ticket() const -> UploadTicket const& { return m_upload; }
 
   protected:
 	Resource() = default;
 
+	auto prepare_upload(UploadLane lane) -> UploadQueue&;
+	auto wait_upload() -> void;
+
 	VmaAllocation m_allocation{};
+	UploadTicket m_upload{};
 };
 
 class HostBuffer;
@@ -126,6 +135,10 @@ class Image : public Resource {
 	[[nodiscard]] auto view_type() const -> vk::ImageViewType { return m_create_info.view_type; }
 	[[nodiscard]] auto layout() const -> vk::ImageLayout { return m_layout; }
 	[[nodiscard]] auto mip_levels() const -> std::uint32_t { return m_mip_levels; }
+	///
+	/// \brief Obtain a unique identifier of the current Vulkan image / view (changes on every recreation).
+	///
+	[[nodiscard]] auto serial() const -> std::uint64_t { return m_serial; }
 
 	[[nodiscard]] auto create_info() const -> ImageCreateInfo const& { return m_create_info; }
 
@@ -144,5 +157,6 @@ class Image : public Resource {
 	vk::ImageLayout m_layout{};
 	vk::DeviceSize m_bytes_allocated{};
 	std::uint32_t m_mip_levels{};
+	std::uint64_t m_serial{};
 };
 } // namespace le::graphics
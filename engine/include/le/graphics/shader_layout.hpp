@@ -48,10 +48,23 @@ struct ShaderLayout {
 		Binding<Type::eStorageBuffer> joints{1};
 	};
 
+	///
+	/// \brief Bindless material set (only present in the pipeline layout if Device::Info::bindless).
+	///
+	/// Draws using it push their material index as a fragment stage push constant (uint at offset 0).
+	///
+	struct MaterialTable {
+		std::uint32_t set{3};
+		Binding<Type::eCombinedImageSampler> textures{0};
+		Binding<Type::eStorageBuffer> params{1};
+		std::uint32_t texture_capacity{4096};
+	};
+
 	VertexLayout vertex_layout{VertexLayout::make(VertexLayout::Buffers{})};
 	Camera camera{};
 	Material material{};
 	Object object{};
+	MaterialTable material_table{};
 	std::map<std::uint32_t, std::vector<vk::DescriptorSetLayoutBinding>> custom_sets{};
 };
 } // namespace le::graphics
@@ -0,0 +1,171 @@
+#pragma once
+#include <le/core/enum_array.hpp>
+#include <le/core/mono_instance.hpp>
+#include <vulkan/vulkan.hpp>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace le::graphics {
+class HostBuffer;
+
+///
+/// \brief Queue an upload is recorded into.
+///
+/// eTransfer uses the dedicated transfer queue (if the Device has one), eGraphics is required for blits (mip map generation).
+///
+enum class UploadLane : std::uint8_t { eTransfer, eGraphics, eCOUNT_ };
+
+///
+/// \brief Completion handle of uploads: the timeline semaphore value each UploadQueue lane must reach.
+///
+struct UploadTicket {
+	EnumArray<UploadLane, std::uint64_t> values{};
+
+	[[nodiscard]] auto is_empty() const -> bool { return values.values == decltype(values.values){}; }
+
+	auto merge(UploadTicket const& rhs) -> UploadTicket&;
+};
+
+///
+/// \brief Asynchronous batched uploads into device buffers and images.
+///
+/// Copies are sub-allocated from a persistent ring of staging blocks and recorded into one command buffer per lane,
+/// which are submitted together on flush() (called by the Renderer before every frame submission).
+/// Each lane signals a timeline semaphore; frames wait on the last flushed values, so uploads never block the caller.
+///
+/// Resources written through this queue wait for their pending ticket before being destroyed / recreated.
+///
+class UploadQueue : public MonoInstance<UploadQueue> {
+  public:
+	static constexpr std::size_t block_size_v{8 * 1024 * 1024};
+	static constexpr std::size_t max_staging_v{64 * 1024 * 1024};
+
+	///
+	/// \brief Sub-allocated staging memory, valid until the recording batch completes.
+	///
+	struct Staging {
+		vk::Buffer buffer{};
+		vk::DeviceSize offset{};
+		std::span<std::byte> mapped{};
+		///
+		/// \brief Ticket of the batch being recorded into.
+		///
+		UploadTicket batch{};
+	};
+
+	UploadQueue(UploadQueue const&) = delete;
+	UploadQueue(UploadQueue&&) = delete;
+	auto operator=(UploadQueue const&) -> UploadQueue& = delete;
+	auto operator=(UploadQueue&&) -> UploadQueue& = delete;
+
+	UploadQueue();
+	~UploadQueue();
+
+	///
+	/// \brief Obtain the lane image uploads must be recorded into.
+	///
+	[[nodiscard]] auto image_lane(std::uint32_t mip_levels) const -> UploadLane;
+
+	///
+	/// \brief Record an upload into the lane's pending batch.
+	/// \param size Staging bytes required (may be 0)
+	/// \param func Invoked as func(vk::CommandBuffer, Staging const&): must write staging.mapped and record copies from staging.buffer
+	/// \returns Ticket completed when the batch has executed
+	///
+	template <typename FuncT>
+	auto record(UploadLane lane, std::size_t size, FuncT&& func) -> UploadTicket {
+		auto lock = std::scoped_lock{m_mutex};
+		auto const staging = allocate(lane, size);
+		func(m_lanes[lane].pending.cmd, staging);
+		return pending_ticket(lane);
+	}
+
+	///
+	/// \brief Keep obj alive until ticket is complete.
+	///
+	template <typename Type>
+	auto release_after(UploadTicket const& ticket, Type obj) -> void {
+		auto lock = std::scoped_lock{m_mutex};
+		m_retired.push_back(Retired{.ticket = ticket, .obj = std::make_unique<Model<Type>>(std::move(obj))});
+	}
+
+	///
+	/// \brief Submit all pending batches.
+	/// \returns Ticket of all uploads submitted so far
+	///
+	auto flush() -> UploadTicket;
+
+	[[nodiscard]] auto is_complete(UploadTicket const& ticket) const -> bool;
+	///
+	/// \brief Block until ticket is complete (flushing first if required).
+	///
+	auto wait(UploadTicket const& ticket) -> void;
+
+	///
+	/// \brief Submit all pending batches and append semaphore waits for uploads not yet known to be complete.
+	///
+	/// Queue submissions that may read uploaded resources must wait on these.
+	///
+	auto flush(std::vector<vk::SemaphoreSubmitInfo>& out_waits, vk::PipelineStageFlags2 stages) -> void;
+
+	[[nodiscard]] auto get_semaphore(UploadLane lane) const -> vk::Semaphore { return *m_lanes[lane].semaphore; }
+
+  private:
+	struct Base {
+		virtual ~Base() = default;
+	};
+	template <typename T>
+	struct Model : Base {
+		T t;
+		Model(T&& t) : t(std::move(t)) {}
+	};
+
+	struct Retired {
+		UploadTicket ticket{};
+		std::unique_ptr<Base> obj{};
+	};
+
+	struct Batch {
+		vk::CommandBuffer cmd{};
+		std::uint64_t value{};
+	};
+
+	struct Lane {
+		vk::UniqueCommandPool pool{};
+		vk::UniqueSemaphore semaphore{};
+		Batch pending{.value = 1};
+		std::deque<Batch> submitted{};
+		std::vector<vk::CommandBuffer> free{};
+		std::uint64_t completed{};
+		bool recording{};
+	};
+
+	struct Block {
+		std::unique_ptr<HostBuffer> buffer{};
+		vk::DeviceSize offset{};
+		UploadTicket ticket{};
+	};
+
+	auto allocate(UploadLane lane, std::size_t size) -> Staging;
+	auto begin_batch(UploadLane lane) -> void;
+	auto acquire_block(std::size_t size) -> Block&;
+	[[nodiscard]] auto pending_ticket(UploadLane lane) const -> UploadTicket;
+	[[nodiscard]] auto is_reached(UploadTicket const& ticket) const -> bool;
+	auto submit() -> UploadTicket;
+	auto block_until(UploadTicket const& ticket) -> void;
+	auto collect() -> void;
+
+	EnumArray<UploadLane, Lane> m_lanes{};
+	std::vector<Block> m_blocks{};
+	std::vector<Block> m_oversized{};
+	std::vector<Retired> m_retired{};
+	std::size_t m_block{};
+	vk::DeviceSize m_alignment{};
+	bool m_transfer_images{};
+	mutable std::mutex m_mutex{};
+};
+} // namespace le::graphics
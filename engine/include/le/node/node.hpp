@@ -20,12 +20,16 @@ class Node {
 	auto id() const -> Id<Node> { return m_id; }
 	auto parent() const -> std::optional<Id<Node>> { return m_parent; }
 	auto children() const -> std::span<Id<Node> const> { return m_children; }
+	///
+	/// \brief Obtain the name (renamed via NodeTree::rename(), which keeps its name index up to date).
+	///
+	auto name() const -> std::string const& { return m_name; }
 
 	std::optional<Id<Entity>> entity_id{};
 	Transform transform{};
-	std::string name{};
 
   private:
+	std::string m_name{};
 	Id<Node> m_id{0};
 	std::optional<Id<Node>> m_parent{};
 	std::vector<Id<Node>> m_children{};
@@ -1,10 +1,24 @@
 #pragma once
 #include <le/core/ptr.hpp>
 #include <le/node/node.hpp>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <optional>
+#include <string>
 #include <unordered_map>
+#include <utility>
 
 namespace le {
+///
+/// \brief Hierarchy of Nodes in dense, parent-before-child storage.
+///
+/// Nodes, parent indices, and local / global transforms live in parallel contiguous arrays sorted such that every
+/// parent precedes all its descendants; Id<Node>s are stable handles mapped to the current index.
+/// Propagating transforms, iterating, and serializing are linear passes over these arrays.
+///
+/// References / pointers to Nodes are invalidated by adding, removing, reparenting, and importing nodes: hold Id<Node>s instead.
+///
 class NodeTree {
   public:
 	struct Data {
@@ -26,15 +40,22 @@ class NodeTree {
 	auto insert_or_assign(Id<Node> id, CreateInfo const& create_info) -> Node&;
 	void remove(Id<Node> id);
 
+	///
+	/// \brief Remove nodes and all their descendants.
+	/// \param foreach_removed Invoked with each removed Node (descendants before ancestors), before any are erased
+	///
 	template <typename FuncT>
-	auto remove(Id<Node> id, FuncT&& foreach_removed) {
-		if (auto it = m_nodes.find(id); it != m_nodes.end()) {
-			remove_child_from_parent(it->second);
-			destroy_children(it->second, foreach_removed);
-			foreach_removed(it->second);
-			m_nodes.erase(it);
-			std::erase(m_roots, id);
+	auto remove(std::span<Id<Node> const> ids, FuncT&& foreach_removed) -> void {
+		if (!mark_removed(ids)) { return; }
+		for (auto index = m_nodes.size(); index-- > 0;) {
+			if (m_removed[index] != 0) { foreach_removed(m_nodes[index]); }
 		}
+		erase_removed();
+	}
+
+	template <typename FuncT>
+	auto remove(Id<Node> id, FuncT&& foreach_removed) -> void {
+		remove(std::span{&id, 1}, std::forward<FuncT>(foreach_removed));
 	}
 
 	[[nodiscard]] auto find(Id<Node> id) const -> Ptr<Node const>;
@@ -44,46 +65,114 @@ class NodeTree {
 	auto get(Id<Node> id) -> Node&;
 
 	void reparent(Node& out, std::optional<Id<Node>> new_parent);
+	void rename(Node& out, std::string name);
+
+	///
+	/// \brief Obtain the global transform of node.
+	///
+	/// Global transforms are cached per node: only nodes whose transform (or an ancestor's) changed since the last query are recomputed.
+	/// node must be owned by this tree.
+	/// Queries update the cache and are thus not thread safe.
+	///
 	[[nodiscard]] auto global_transform(Node const& node) const -> glm::mat4;
 	[[nodiscard]] auto global_transform(Id<Node> id) const -> glm::mat4;
+	///
+	/// \brief Obtain the global transforms of ids (identity for invalid IDs), validating each shared ancestor once.
+	///
+	auto global_transforms(std::span<Id<Node> const> ids, std::span<glm::mat4> out) const -> void;
+	///
+	/// \brief Recompute the cached global transforms of all dirty subtrees.
+	///
+	/// Dirty nodes are found in a single pass over the dense arrays, then concatenated as a batch (see mat4_batch).
+	///
+	/// Call once per frame after nodes have been moved (eg by animations), so subsequent queries only validate caches.
+	///
+	auto update_transforms() const -> void;
 	[[nodiscard]] auto global_position(Node const& node) const -> glm::vec3;
 	[[nodiscard]] auto global_position(Id<Node> id) const -> glm::vec3;
 
+	///
+	/// \brief Obtain the earliest added node named name.
+	///
 	[[nodiscard]] auto find_by_name(std::string_view name) const -> std::optional<Id<Node>>;
+	///
+	/// \brief Obtain all nodes named name, in order of addition.
+	///
+	[[nodiscard]] auto find_all_by_name(std::string_view name) const -> std::span<Id<Node> const>;
 
 	void clear();
 
 	[[nodiscard]] auto roots() const -> std::span<Id<Node> const> { return m_roots; }
+	///
+	/// \brief Obtain all nodes, parents before children.
+	///
+	[[nodiscard]] auto nodes() const -> std::span<Node const> { return m_nodes; }
+	[[nodiscard]] auto size() const -> std::size_t { return m_nodes.size(); }
 
 	// Use with caution
 	auto import_tree(DataMap nodes, std::vector<Id<Node>> roots) -> void;
 
 	template <typename Func>
 	void for_each(Func&& func) {
-		for (auto& [_, node] : m_nodes) { func(node); }
+		for (auto& node : m_nodes) { func(node); }
 	}
 
   private:
-	using Map = std::unordered_map<Id<Node>::id_type, Node>;
+	using Index = std::uint32_t;
+	static constexpr auto null_index_v{std::numeric_limits<Index>::max()};
+
+	///
+	/// \brief Validity of a cached global transform.
+	///
+	struct Stamp {
+		// unique per (re)computation within a NodeTree, 0 if never computed.
+		std::uint64_t revision{};
+		std::uint64_t parent_revision{};
+		std::uint64_t epoch{};
+	};
+
 	[[nodiscard]] static auto make_node(Id<Node> self, std::vector<Id<Node>> children, CreateInfo create_info = {}) -> Node;
 
-	void remove_child_from_parent(Node& out);
+	struct NameHasher {
+		using is_transparent = void;
 
-	template <typename FuncT>
-	void destroy_children(Node& out, FuncT&& foreach_removed) {
-		for (auto const id : out.m_children) {
-			if (auto it = m_nodes.find(id); it != m_nodes.end()) {
-				destroy_children(it->second, foreach_removed);
-				foreach_removed(it->second);
-				m_nodes.erase(it);
-			}
-		}
-		out.m_children.clear();
-	}
+		auto operator()(std::string_view const name) const -> std::size_t { return std::hash<std::string_view>{}(name); }
+	};
+
+	using NameIndex = std::unordered_map<std::string, std::vector<Id<Node>>, NameHasher, std::equal_to<>>;
 
-	Map m_nodes{};
+	[[nodiscard]] auto index_of(Id<Node> id) const -> Index;
+	[[nodiscard]] auto index_of(Node const& node) const -> Index;
+
+	auto assign(std::vector<Node> nodes, std::vector<Id<Node>> roots) -> void;
+	auto append(Node node, Index parent) -> Node&;
+	void remove_child_from_parent(Node& out);
+	auto add_name(Node const& node) -> void;
+	auto remove_name(Node const& node) -> void;
+	auto mark_removed(std::span<Id<Node> const> ids) -> bool;
+	auto erase_removed() -> void;
+	auto sort_nodes() -> void;
+
+	auto resolve(Index index) const -> glm::mat4 const&;
+	auto refresh(Index index) const -> void;
+	[[nodiscard]] auto revalidate(Index index) const -> bool;
+
+	// parallel arrays, parents before children.
+	std::vector<Node> m_nodes{};
+	std::vector<Index> m_parents{};
+	mutable std::vector<glm::mat4> m_locals{};
+	mutable std::vector<glm::mat4> m_globals{};
+	mutable std::vector<Stamp> m_stamps{};
+	// scratch for update_transforms().
+	mutable std::vector<Index> m_dirty{};
+
+	std::unordered_map<Id<Node>::id_type, Index> m_indices{};
+	NameIndex m_names{};
 	std::vector<Id<Node>> m_roots{};
+	std::vector<std::uint8_t> m_removed{};
 	Id<Node>::id_type m_next_id{};
+	mutable std::uint64_t m_revision{};
+	mutable std::uint64_t m_epoch{};
 };
 
 ///
@@ -99,8 +188,12 @@ class NodeLocator {
 	[[nodiscard]] auto find(Id<Node> id) const -> Ptr<Node> { return m_out.find(id); }
 	[[nodiscard]] auto get(Id<Node> id) const -> Node& { return m_out.get(id); }
 	[[nodiscard]] auto find_by_name(std::string_view name) const -> std::optional<Id<Node>> { return m_out.find_by_name(name); }
+	[[nodiscard]] auto find_all_by_name(std::string_view name) const -> std::span<Id<Node> const> { return m_out.find_all_by_name(name); }
 	void reparent(Node& out, Id<Node> new_parent) const { return m_out.reparent(out, new_parent); }
+	void rename(Node& out, std::string name) const { m_out.rename(out, std::move(name)); }
 	[[nodiscard]] auto global_transform(Node const& node) const -> glm::mat4 { return m_out.global_transform(node); }
+	auto global_transforms(std::span<Id<Node> const> ids, std::span<glm::mat4> out) const -> void { m_out.global_transforms(ids, out); }
+	auto update_transforms() const -> void { m_out.update_transforms(); }
 	[[nodiscard]] auto global_position(Node const& node) const -> glm::vec3 { return m_out.global_position(node); }
 	[[nodiscard]] auto global_position(Id<Node> id) const -> glm::vec3 { return m_out.global_position(id); }
 	[[nodiscard]] auto roots() const -> std::span<Id<Node> const> { return m_out.roots(); }
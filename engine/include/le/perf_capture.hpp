@@ -0,0 +1,48 @@
+#pragma once
+#include <le/frame_profile.hpp>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace le {
+///
+/// \brief Records FrameProfiles over a fixed number of frames, for offline / CI performance comparisons.
+///
+/// The first warmup frames are discarded (pipeline compilation, resource uploads, etc).
+///
+class PerfCapture {
+  public:
+	struct Summary {
+		Duration median{};
+		Duration p99{};
+		Duration max{};
+	};
+
+	explicit PerfCapture(std::uint64_t frames, std::uint64_t warmup = 0);
+
+	///
+	/// \brief Record a frame profile (if not yet complete).
+	/// \returns true if capture is complete
+	///
+	auto push(FrameProfile const& profile) -> bool;
+
+	[[nodiscard]] auto is_complete() const -> bool { return m_profiles.size() >= m_frames; }
+	[[nodiscard]] auto get_profiles() const -> std::span<FrameProfile const> { return m_profiles; }
+
+	[[nodiscard]] auto summarize(FrameProfile::Type type) const -> Summary;
+	[[nodiscard]] auto summarize_gpu(FrameProfile::Type type) const -> Summary;
+	[[nodiscard]] auto summarize_frame_time() const -> Summary;
+	[[nodiscard]] auto summarize_pipeline_compile() const -> Summary;
+
+	///
+	/// \brief Write the summary of each profile type (in milliseconds) as JSON to path.
+	///
+	auto write_json(char const* path) const -> bool;
+
+  private:
+	std::vector<FrameProfile> m_profiles{};
+	std::uint64_t m_frames{};
+	std::uint64_t m_warmup{};
+};
+} // namespace le
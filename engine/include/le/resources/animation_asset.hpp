@@ -7,12 +7,29 @@ class AnimationAsset : public Asset {
   public:
 	static constexpr std::string_view type_name_v{"AnimationAsset"};
 
+	///
+	/// \brief Lossy encoding parameters.
+	///
+	/// Rotations are stored as smallest-three quaternions, translations and scales quantized to 16 bits within each channel's range.
+	/// Keys that can be reconstructed from their neighbours (constant / linear runs) within tolerance are removed before quantization.
+	/// Cubic spline channels keep all their keys, and their tangents are stored unquantized.
+	///
+	struct Compression {
+		float translation_tolerance{0.0001f};
+		float rotation_tolerance{0.0001f};
+		float scale_tolerance{0.0001f};
+	};
+
 	[[nodiscard]] auto type_name() const -> std::string_view final { return type_name_v; }
 	[[nodiscard]] auto try_load(Uri const& uri) -> bool final;
 
 	static auto bin_pack_to(std::vector<std::byte>& out, graphics::Animation::Channel const& sampler) -> void;
 	static auto bin_unpack_from(std::span<std::byte const> bytes, graphics::Animation::Channel& out) -> bool;
 	static auto bin_pack_to(std::vector<std::byte>& out, graphics::Animation const& animation) -> void;
+	static auto bin_pack_to(std::vector<std::byte>& out, graphics::Animation const& animation, Compression const& compression) -> void;
+	///
+	/// \brief Unpack an animation, raw or compressed.
+	///
 	static auto bin_unpack_from(std::span<std::byte const> bytes, graphics::Animation& out) -> bool;
 
 	graphics::Animation animation{};
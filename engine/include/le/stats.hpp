@@ -11,14 +11,50 @@ struct Stats {
 	struct {
 		std::uint64_t count{};
 		std::uint64_t draw_calls{};
+		std::uint64_t draws_saved{};
+		std::uint64_t pipeline_binds{};
+		std::uint64_t descriptor_binds{};
 		Duration time{};
 		std::uint32_t rate{};
 	} frame{};
 
+	struct {
+		std::uint32_t visible{};
+		std::uint32_t culled{};
+		std::uint32_t shadow_visible{};
+		std::uint32_t shadow_culled{};
+	} culling{};
+
 	struct {
 		std::uint32_t shaders{};
 		std::uint32_t pipelines{};
+		std::uint64_t pipeline_hits{};
+		std::uint64_t pipeline_misses{};
+		std::uint64_t pipelines_pending{};
+		Duration pipeline_compile_time{};
 		std::uint32_t vertex_buffers{};
 	} cache{};
+
+	struct {
+		bool enabled{};
+		std::uint32_t textures{};
+		std::uint32_t materials{};
+		std::uint32_t texture_writes{};
+		std::uint32_t overflows{};
+	} bindless{};
+
+	struct {
+		bool enabled{};
+		std::uint32_t outputs{};
+		std::uint32_t dispatches{};
+		std::uint32_t skipped{};
+	} skinning{};
+
+	struct {
+		std::uint64_t bytes_used{};
+		std::uint64_t high_water{};
+		std::uint64_t capacity{};
+		std::uint32_t buffers{};
+	} scratch{};
 };
 } // namespace le
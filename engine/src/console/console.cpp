@@ -1,4 +1,5 @@
 #include <le/console/console.hpp>
+#include <le/console/profile_trace.hpp>
 #include <algorithm>
 #include <array>
 #include <format>
@@ -60,7 +61,9 @@ Console::Console()
 	: m_builtins({
 		  Builtin{"help", [](Console& console) { console.add_entry(console.autocomplete("", 0)); }},
 		  Builtin{"clear", [](Console& console) { console.clear_log(); }},
-	  }) {}
+	  }) {
+	add<ProfileTrace>();
+}
 
 void Console::submit(std::string_view text) {
 	if (text.empty()) { return; }
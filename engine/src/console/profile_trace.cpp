@@ -0,0 +1,22 @@
+#include <le/console/profile_trace.hpp>
+#include <le/core/profiler.hpp>
+#include <charconv>
+#include <format>
+
+namespace le::console {
+auto ProfileTrace::process(std::string_view argument) -> Response {
+	auto frames = default_frames_v;
+	auto path = default_path_v;
+	if (!argument.empty()) {
+		auto const space = argument.find(' ');
+		auto const count = argument.substr(0, space);
+		auto const* end = count.data() + count.size();
+		auto [ptr, ec] = std::from_chars(count.data(), end, frames);
+		if (ec != std::errc{} || ptr != end || frames == 0) { return Response{.error = "invalid argument, expected [frames] [path]"}; }
+		if (space != std::string_view::npos) { path = argument.substr(space + 1); }
+	}
+	if (path.empty()) { return Response{.error = "invalid path"}; }
+	if (!Profiler::start_capture(frames, std::string{path})) { return Response{.error = "capture already in progress"}; }
+	return Response{.message = std::format("capturing {} frames to '{}'", frames, path)};
+}
+} // namespace le::console
@@ -0,0 +1,66 @@
+#include <le/core/mat4_batch.hpp>
+#include <cassert>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LE_MAT4_BATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace le::mat4_batch {
+namespace {
+#if defined(LE_MAT4_BATCH_SSE2)
+// each column of the result: lhs[0] * rhs[c][0] + lhs[1] * rhs[c][1] + lhs[2] * rhs[c][2] + lhs[3] * rhs[c][3], summed left to right like glm.
+auto multiply_to(glm::mat4 const& lhs, glm::mat4 const& rhs, glm::mat4& out) -> void {
+	auto const* a = &lhs[0][0];
+	auto const* b = &rhs[0][0];
+	auto* o = &out[0][0];
+	auto const a0 = _mm_loadu_ps(a);	  // NOLINT
+	auto const a1 = _mm_loadu_ps(a + 4);  // NOLINT
+	auto const a2 = _mm_loadu_ps(a + 8);  // NOLINT
+	auto const a3 = _mm_loadu_ps(a + 12); // NOLINT
+	for (int column = 0; column < 4; ++column) {
+		auto const* b_column = b + column * 4; // NOLINT
+		auto result = _mm_mul_ps(a0, _mm_set1_ps(b_column[0]));
+		result = _mm_add_ps(result, _mm_mul_ps(a1, _mm_set1_ps(b_column[1])));	// NOLINT
+		result = _mm_add_ps(result, _mm_mul_ps(a2, _mm_set1_ps(b_column[2])));	// NOLINT
+		result = _mm_add_ps(result, _mm_mul_ps(a3, _mm_set1_ps(b_column[3])));	// NOLINT
+		_mm_storeu_ps(o + column * 4, result);									// NOLINT
+	}
+}
+#else
+auto multiply_to(glm::mat4 const& lhs, glm::mat4 const& rhs, glm::mat4& out) -> void { out = lhs * rhs; }
+#endif
+} // namespace
+
+auto multiply(std::span<glm::mat4 const> lhs, std::span<glm::mat4 const> rhs, std::span<glm::mat4> out) -> void {
+	assert(lhs.size() >= out.size() && rhs.size() >= out.size());
+	for (std::size_t i = 0; i < out.size(); ++i) { multiply_to(lhs[i], rhs[i], out[i]); }
+}
+
+auto multiply_scalar(std::span<glm::mat4 const> lhs, std::span<glm::mat4 const> rhs, std::span<glm::mat4> out) -> void {
+	assert(lhs.size() >= out.size() && rhs.size() >= out.size());
+	for (std::size_t i = 0; i < out.size(); ++i) { out[i] = lhs[i] * rhs[i]; }
+}
+
+auto concatenate(std::span<glm::mat4 const> locals, std::span<std::uint32_t const> parents, std::span<std::uint32_t const> indices, std::span<glm::mat4> out)
+	-> void {
+	for (auto const index : indices) {
+		assert(index < locals.size() && index < parents.size() && index < out.size());
+		auto const parent = parents[index];
+		if (parent == root_v) {
+			out[index] = locals[index];
+		} else {
+			multiply_to(out[parent], locals[index], out[index]);
+		}
+	}
+}
+
+auto concatenate_scalar(std::span<glm::mat4 const> locals, std::span<std::uint32_t const> parents, std::span<std::uint32_t const> indices,
+						std::span<glm::mat4> out) -> void {
+	for (auto const index : indices) {
+		assert(index < locals.size() && index < parents.size() && index < out.size());
+		auto const parent = parents[index];
+		out[index] = parent == root_v ? locals[index] : out[parent] * locals[index];
+	}
+}
+} // namespace le::mat4_batch
@@ -0,0 +1,199 @@
+#include <le/core/logger.hpp>
+#include <le/core/profiler.hpp>
+#include <le/core/time.hpp>
+#include <algorithm>
+#include <array>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace le {
+namespace {
+auto const g_log{logger::Logger{"Profiler"}};
+
+auto const g_epoch{Clock::now()}; // NOLINT
+
+///
+/// \brief Single producer (owning thread), single consumer (collect(), serialized by Registry::mutex) ring of completed scopes.
+///
+struct ThreadBuffer {
+	std::array<Profiler::Event, Profiler::thread_capacity_v> events{};
+	std::atomic<std::uint64_t> head{};
+	std::atomic<std::uint64_t> tail{};
+	std::atomic<std::uint64_t> dropped{};
+	std::uint32_t thread{};
+
+	auto push(Profiler::Event const& event) -> void {
+		auto const index = head.load(std::memory_order_relaxed);
+		if (index - tail.load(std::memory_order_acquire) >= events.size()) {
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		events[index % events.size()] = event;
+		head.store(index + 1, std::memory_order_release);
+	}
+
+	auto drain_to(std::vector<Profiler::Event>& out) -> void {
+		auto const last = head.load(std::memory_order_acquire);
+		auto index = tail.load(std::memory_order_relaxed);
+		for (; index < last; ++index) { out.push_back(events[index % events.size()]); }
+		tail.store(last, std::memory_order_release);
+	}
+};
+
+struct Registry {
+	std::mutex mutex{};
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers{};
+	std::uint32_t next_thread{};
+
+	static auto self() -> Registry& {
+		static auto ret = Registry{};
+		return ret;
+	}
+};
+
+struct Capture {
+	std::mutex mutex{};
+	std::vector<Profiler::Event> events{};
+	std::string path{};
+	std::uint64_t frames{};
+	std::uint64_t remain{};
+	std::int64_t frame_start{};
+	bool requested{};
+	bool active{};
+
+	static auto self() -> Capture& {
+		static auto ret = Capture{};
+		return ret;
+	}
+};
+
+thread_local std::uint32_t t_depth{}; // NOLINT
+
+auto local_buffer() -> ThreadBuffer& {
+	// the registry shares ownership: events pushed just before a thread exits are still collected.
+	thread_local auto t_buffer = std::shared_ptr<ThreadBuffer>{};
+	if (!t_buffer) {
+		auto buffer = std::make_shared<ThreadBuffer>();
+		auto& registry = Registry::self();
+		auto lock = std::scoped_lock{registry.mutex};
+		buffer->thread = registry.next_thread++;
+		registry.buffers.push_back(buffer);
+		t_buffer = std::move(buffer);
+	}
+	return *t_buffer;
+}
+
+auto escape_to(std::string& out, std::string_view const name) -> void {
+	for (auto const ch : name) {
+		if (ch == '"' || ch == '\\') { out += '\\'; }
+		if (static_cast<unsigned char>(ch) >= 0x20) { out += ch; }
+	}
+}
+} // namespace
+
+auto Profiler::start_capture(std::uint64_t const frames, std::string path) -> bool {
+	if (frames == 0) { return false; }
+	auto& capture = Capture::self();
+	auto lock = std::scoped_lock{capture.mutex};
+	if (capture.requested || capture.active) { return false; }
+	capture.path = std::move(path);
+	capture.frames = capture.remain = frames;
+	capture.requested = true;
+	return true;
+}
+
+auto Profiler::is_capturing() -> bool {
+	auto& capture = Capture::self();
+	auto lock = std::scoped_lock{capture.mutex};
+	return capture.requested || capture.active;
+}
+
+auto Profiler::next_frame() -> void {
+	auto& capture = Capture::self();
+	auto lock = std::scoped_lock{capture.mutex};
+	if (!capture.requested && !capture.active) { return; }
+
+	auto const now = now_ns();
+	if (capture.requested) {
+		// discard anything recorded before this frame.
+		[[maybe_unused]] auto const stale = collect();
+		drain_dropped();
+		capture.requested = false;
+		capture.active = true;
+		capture.frame_start = now;
+		set_enabled(true);
+		return;
+	}
+
+	auto events = collect();
+	capture.events.insert(capture.events.end(), events.begin(), events.end());
+	capture.events.push_back(Event{.name = "frame", .start_ns = capture.frame_start, .duration_ns = now - capture.frame_start, .thread = thread_id()});
+	capture.frame_start = now;
+	if (--capture.remain > 0) { return; }
+
+	set_enabled(false);
+	capture.active = false;
+	if (auto const dropped = drain_dropped(); dropped > 0) { g_log.warn("{} events dropped (thread buffers full)", dropped); }
+	if (write_trace(capture.events, capture.path.c_str())) {
+		g_log.info("{} events over {} frames written to '{}'", capture.events.size(), capture.frames, capture.path);
+	} else {
+		g_log.error("failed to write trace to '{}'", capture.path);
+	}
+	capture.events = {};
+}
+
+auto Profiler::collect() -> std::vector<Event> {
+	auto ret = std::vector<Event>{};
+	auto& registry = Registry::self();
+	auto lock = std::scoped_lock{registry.mutex};
+	for (auto const& buffer : registry.buffers) { buffer->drain_to(ret); }
+	// the registry is the last owner of buffers of exited threads, which have just been drained.
+	std::erase_if(registry.buffers, [](std::shared_ptr<ThreadBuffer> const& buffer) { return buffer.use_count() == 1; });
+	return ret;
+}
+
+auto Profiler::drain_dropped() -> std::uint64_t {
+	auto ret = std::uint64_t{};
+	auto& registry = Registry::self();
+	auto lock = std::scoped_lock{registry.mutex};
+	for (auto const& buffer : registry.buffers) { ret += buffer->dropped.exchange(0, std::memory_order_relaxed); }
+	return ret;
+}
+
+auto Profiler::now_ns() -> std::int64_t { return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - g_epoch).count(); }
+
+auto Profiler::thread_id() -> std::uint32_t { return local_buffer().thread; }
+
+auto Profiler::write_trace(std::span<Event const> const events, char const* path) -> bool {
+	auto file = std::ofstream{path};
+	if (!file) { return false; }
+
+	auto text = std::string{"{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"};
+	auto first = true;
+	for (auto const& event : events) {
+		if (!first) { text += ",\n"; }
+		first = false;
+		text += R"({"name":")";
+		escape_to(text, event.name);
+		std::format_to(std::back_inserter(text), R"(","cat":"le","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":1,"tid":{}}})",
+					   static_cast<double>(event.start_ns) / 1000.0, static_cast<double>(event.duration_ns) / 1000.0, event.thread);
+	}
+	text += "\n]}\n";
+	file << text;
+	return static_cast<bool>(file);
+}
+
+auto Profiler::begin() -> std::int64_t {
+	++t_depth;
+	return now_ns();
+}
+
+auto Profiler::end(char const* name, std::int64_t const start) -> void {
+	auto const now = now_ns();
+	--t_depth;
+	auto& buffer = local_buffer();
+	buffer.push(Event{.name = name, .start_ns = start, .duration_ns = now - start, .thread = buffer.thread, .depth = t_depth});
+}
+} // namespace le
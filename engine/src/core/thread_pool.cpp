@@ -0,0 +1,44 @@
+#include <le/core/thread_pool.hpp>
+
+namespace le {
+auto ThreadPool::default_thread_count() -> std::size_t {
+	auto const hardware = static_cast<std::size_t>(std::thread::hardware_concurrency());
+	return hardware > 1 ? hardware - 1 : 1;
+}
+
+ThreadPool::ThreadPool(std::size_t const thread_count) {
+	m_threads.reserve(thread_count);
+	for (std::size_t i = 0; i < thread_count; ++i) { m_threads.emplace_back([this] { run(); }); }
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		m_stop = true;
+	}
+	m_cv.notify_all();
+	for (auto& thread : m_threads) { thread.join(); }
+}
+
+auto ThreadPool::push(std::function<void()> task) -> void {
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		m_queue.push_back(std::move(task));
+	}
+	m_cv.notify_one();
+}
+
+auto ThreadPool::run() -> void {
+	while (true) {
+		auto task = std::function<void()>{};
+		{
+			auto lock = std::unique_lock{m_mutex};
+			m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+			if (m_queue.empty()) { return; }
+			task = std::move(m_queue.front());
+			m_queue.pop_front();
+		}
+		task();
+	}
+}
+} // namespace le
@@ -3,11 +3,13 @@
 
 #include <impl/frame_profiler.hpp>
 #include <le/core/enumerate.hpp>
+#include <le/core/profiler.hpp>
 #include <le/core/reverse_view.hpp>
 #include <le/core/zip_ranges.hpp>
 #include <le/engine.hpp>
 #include <le/error.hpp>
 #include <le/input/receiver.hpp>
+#include <le/vfs/file_reader.hpp>
 #include <format>
 #include <thread>
 
@@ -97,16 +99,23 @@ auto Engine::Deleter::operator()(GLFWwindow* ptr) const -> void {
 
 Engine::~Engine() {
 	if (m_graphics_device) { m_graphics_device->get_device().waitIdle(); }
+	if (m_renderer && !m_pipeline_cache_uri.is_empty()) {
+		if (auto const* file_reader = dynamic_cast<FileReader const*>(&vfs::get_reader())) {
+			[[maybe_unused]] auto const result = file_reader->write_to(m_pipeline_cache_uri, m_renderer->get_pipeline_cache().serialize_vk_cache());
+		}
+	}
 	m_resources->clear();
 }
 
 auto Engine::framebuffer_extent() const -> glm::uvec2 {
+	if (is_headless()) { return m_headless_extent; }
 	auto ret = glm::ivec2{};
 	glfwGetFramebufferSize(m_window.get(), &ret.x, &ret.y);
 	return ret;
 }
 
 auto Engine::window_extent() const -> glm::uvec2 {
+	if (is_headless()) { return m_headless_extent; }
 	auto ret = glm::ivec2{};
 	glfwGetWindowSize(m_window.get(), &ret.x, &ret.y);
 	return ret;
@@ -120,6 +129,7 @@ auto Engine::frame_profile() const -> FrameProfile const& { return FrameProfiler
 
 auto Engine::next_frame() -> bool {
 	FrameProfiler::self().start();
+	Profiler::next_frame();
 
 	update_stats();
 
@@ -139,11 +149,16 @@ auto Engine::next_frame() -> bool {
 
 	advance(m_input_state.keyboard);
 	advance(m_input_state.mouse_buttons);
-	update_gamepads();
+
+	if (is_headless()) {
+		if (input_script) { input_script(m_input_state, m_stats.frame.count - 1); }
+	} else {
+		update_gamepads();
+	}
 
 	m_input_state.cursor_position = screen_to_world(m_input_state.raw_cursor_position, m_input_state.window_extent, m_input_state.display_ratio());
 
-	glfwPollEvents();
+	if (!is_headless()) { glfwPollEvents(); }
 	if (!is_running()) { return false; }
 	if (m_image_index) { return true; }
 
@@ -164,6 +179,14 @@ auto Engine::next_frame() -> bool {
 auto Engine::render(graphics::RenderFrame const& frame) -> void {
 	if (!m_image_index) { return; }
 	m_stats.frame.draw_calls = m_renderer->render(frame, *m_image_index);
+	auto const& counters = m_renderer->get_counters();
+	m_stats.frame.draws_saved = counters.draws_saved;
+	m_stats.frame.pipeline_binds = counters.pipeline_binds;
+	m_stats.frame.descriptor_binds = counters.descriptor_binds;
+	m_stats.culling.visible = counters.visible;
+	m_stats.culling.culled = counters.culled;
+	m_stats.culling.shadow_visible = counters.shadow_visible;
+	m_stats.culling.shadow_culled = counters.shadow_culled;
 	m_renderer->submit_frame(*m_image_index);
 	m_image_index.reset();
 
@@ -178,6 +201,8 @@ auto Engine::render(graphics::RenderFrame const& frame) -> void {
 
 	FrameProfiler::self().finish();
 
+	if (m_capture && !m_capture->is_complete() && m_capture->push(FrameProfiler::self().previous_profile()) && is_headless()) { shutdown(); }
+
 	if (min_frame_time > 0s) {
 		auto const frame_time = Clock::now() - m_delta_time.start;
 		auto const remain = min_frame_time - frame_time;
@@ -186,7 +211,7 @@ auto Engine::render(graphics::RenderFrame const& frame) -> void {
 }
 
 auto Engine::shutdown() -> void {
-	glfwSetWindowShouldClose(m_window.get(), GLFW_TRUE);
+	if (!is_headless()) { glfwSetWindowShouldClose(m_window.get(), GLFW_TRUE); }
 	m_input_state.shutting_down = true;
 }
 
@@ -197,6 +222,8 @@ auto Engine::request_present_mode(vk::PresentModeKHR mode) -> bool {
 	return true;
 }
 
+auto Engine::start_capture(std::uint64_t const frames, std::uint64_t const warmup) -> void { m_capture.emplace(frames, warmup); }
+
 auto Engine::get_engine(GLFWwindow* window) -> Engine& {
 	auto* ret = static_cast<Engine*>(glfwGetWindowUserPointer(window));
 	assert(ret);
@@ -255,6 +282,7 @@ auto Engine::setup_signals(GLFWwindow* window) -> void {
 
 auto Engine::update_stats() -> void {
 	m_stats.frame.time = m_delta_time();
+	if (fixed_delta_time) { m_stats.frame.time = *fixed_delta_time; }
 	++m_fps.frames;
 	m_fps.elapsed += m_stats.frame.time;
 	if (m_fps.elapsed >= 1s) {
@@ -265,8 +293,40 @@ auto Engine::update_stats() -> void {
 
 	auto const& pipeline_cache = graphics::PipelineCache::self();
 	m_stats.cache.pipelines = static_cast<std::uint32_t>(pipeline_cache.pipeline_count());
+	auto const pipeline_stats = pipeline_cache.get_stats();
+	m_stats.cache.pipeline_hits = pipeline_stats.hits;
+	m_stats.cache.pipeline_misses = pipeline_stats.misses;
+	m_stats.cache.pipelines_pending = pipeline_stats.pending;
+	m_stats.cache.pipeline_compile_time = pipeline_stats.compile_time;
 	m_stats.cache.shaders = static_cast<std::uint32_t>(pipeline_cache.shader_count());
 	m_stats.cache.vertex_buffers = static_cast<std::uint32_t>(graphics::VertexBufferCache::self().buffer_count());
+
+	auto const material_table = m_renderer->get_material_table();
+	m_stats.bindless = {};
+	if (material_table != nullptr) {
+		auto const table_stats = material_table->get_stats();
+		m_stats.bindless.enabled = true;
+		m_stats.bindless.textures = table_stats.textures;
+		m_stats.bindless.materials = table_stats.materials;
+		m_stats.bindless.texture_writes = table_stats.texture_writes;
+		m_stats.bindless.overflows = table_stats.overflows;
+	}
+
+	auto const compute_skinning = m_renderer->get_compute_skinning();
+	m_stats.skinning = {};
+	if (compute_skinning != nullptr) {
+		auto const skinning_stats = compute_skinning->get_stats();
+		m_stats.skinning.enabled = true;
+		m_stats.skinning.outputs = skinning_stats.outputs;
+		m_stats.skinning.dispatches = skinning_stats.dispatches;
+		m_stats.skinning.skipped = skinning_stats.skipped;
+	}
+
+	auto const scratch = graphics::ScratchBufferCache::self().get_stats();
+	m_stats.scratch.bytes_used = scratch.bytes_used;
+	m_stats.scratch.high_water = scratch.high_water;
+	m_stats.scratch.capacity = scratch.capacity;
+	m_stats.scratch.buffers = static_cast<std::uint32_t>(scratch.buffers);
 }
 
 auto Engine::update_gamepads() -> void {
@@ -287,27 +347,42 @@ auto Engine::Builder::set_shader_layout(graphics::ShaderLayout shader_layout) ->
 	return *this;
 }
 
+auto Engine::Builder::set_headless(bool const value) -> Builder& {
+	m_headless = value;
+	return *this;
+}
+
+auto Engine::Builder::set_pipeline_cache_uri(Uri uri) -> Builder& {
+	m_pipeline_cache_uri = std::move(uri);
+	return *this;
+}
+
 auto Engine::Builder::build() -> std::unique_ptr<Engine> {
 	auto ret = std::make_unique<Engine>(ConstructTag{});
 
 	ret->m_resources = std::make_unique<Resources>();
 
-	ret->m_window = std::unique_ptr<GLFWwindow, Deleter>{make_window(m_title.c_str(), m_extent)};
-	ret->setup_signals(ret->m_window.get());
+	if (m_headless) {
+		ret->m_headless_extent = m_extent;
+	} else {
+		ret->m_window = std::unique_ptr<GLFWwindow, Deleter>{make_window(m_title.c_str(), m_extent)};
+		ret->setup_signals(ret->m_window.get());
+	}
 
 	auto rdci = graphics::Device::CreateInfo{
 		.validation = debug_v,
 	};
 	ret->m_graphics_device = std::make_unique<graphics::Device>(ret->m_window.get(), rdci);
 
-	auto framebuffer_extent = glm::ivec2{};
-	glfwGetFramebufferSize(ret->m_window.get(), &framebuffer_extent.x, &framebuffer_extent.y);
-	ret->m_renderer = std::make_unique<graphics::Renderer>(framebuffer_extent);
-	auto imgui = std::make_unique<graphics::DearImGui>(ret->get_window(), ret->m_renderer->get_colour_format());
+	ret->m_renderer = std::make_unique<graphics::Renderer>(ret->framebuffer_extent());
+	auto imgui = std::make_unique<graphics::DearImGui>(ret->get_window(), ret->m_renderer->get_colour_format(), ret->m_headless_extent);
 	ret->m_renderer->set_imgui(std::move(imgui));
 
 	if (m_shader_layout) { graphics::PipelineCache::self().set_shader_layout(std::move(*m_shader_layout)); }
 
+	ret->m_pipeline_cache_uri = std::move(m_pipeline_cache_uri);
+	if (!ret->m_pipeline_cache_uri.is_empty()) { ret->m_renderer->get_pipeline_cache().load_vk_cache(vfs::read_bytes(ret->m_pipeline_cache_uri)); }
+
 	ret->m_stats.gpu_name = ret->m_graphics_device->get_physical_device().getProperties().deviceName.data();
 	ret->m_stats.validation_enabled = ret->m_graphics_device->get_info().validation;
 
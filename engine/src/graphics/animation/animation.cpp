@@ -1,4 +1,5 @@
 #include <le/core/visitor.hpp>
+#include <le/core/zip_ranges.hpp>
 #include <le/graphics/animation/animation.hpp>
 
 namespace le::graphics {
@@ -6,22 +7,68 @@ auto Animation::Channel::duration() const -> Duration {
 	return std::visit([](auto const& s) { return s.duration(); }, storage);
 }
 
-void Animation::Channel::update(NodeLocator node_locator, Duration time) const {
+namespace {
+template <typename SampleT>
+void update_joint(NodeLocator node_locator, Id<Node> joint_id, std::variant<Animation::Translate, Animation::Rotate, Animation::Scale> const& storage,
+				  SampleT sample) {
 	auto* joint = node_locator.find(joint_id);
 	if (joint == nullptr) { return; }
 	auto const visitor = Visitor{
-		[time, joint](Animation::Translate const& translate) {
-			if (auto const p = translate(time)) { joint->transform.set_position(*p); }
+		[joint, sample](Animation::Translate const& translate) {
+			if (auto const p = sample(translate)) { joint->transform.set_position(*p); }
 		},
-		[time, joint](Animation::Rotate const& rotate) {
-			if (auto const o = rotate(time)) { joint->transform.set_orientation(*o); }
+		[joint, sample](Animation::Rotate const& rotate) {
+			if (auto const o = sample(rotate)) { joint->transform.set_orientation(*o); }
 		},
-		[time, joint](Animation::Scale const& scale) {
-			if (auto const s = scale(time)) { joint->transform.set_scale(*s); }
+		[joint, sample](Animation::Scale const& scale) {
+			if (auto const s = sample(scale)) { joint->transform.set_scale(*s); }
 		},
 	};
 	std::visit(visitor, storage);
 }
+} // namespace
+
+void Animation::Channel::update(NodeLocator node_locator, Duration time) const {
+	update_joint(node_locator, joint_id, storage, [time](auto const& interpolator) { return interpolator(time); });
+}
+
+void Animation::Channel::update(NodeLocator node_locator, Duration time, KeyframeCursor& cursor) const {
+	update_joint(node_locator, joint_id, storage, [time, &cursor](auto const& interpolator) { return interpolator(time, cursor); });
+}
+
+auto Animation::bind(NodeLocator node_locator) const -> Binding {
+	auto ret = Binding{.animation = this};
+	for (auto const& channel : channels) {
+		auto* node = node_locator.find(channel.joint_id);
+		if (node == nullptr) { continue; }
+		auto const visitor = Visitor{
+			[&](Translate const& translate) { ret.translations.push_back({.interpolator = &translate, .node = node}); },
+			[&](Rotate const& rotate) { ret.rotations.push_back({.interpolator = &rotate, .node = node}); },
+			[&](Scale const& scale) { ret.scales.push_back({.interpolator = &scale, .node = node}); },
+		};
+		std::visit(visitor, channel.storage);
+	}
+	return ret;
+}
+
+// channels of different types write different components of a transform: groups can be applied in any order.
+auto Animation::Binding::update(Duration time) -> void {
+	for (auto& target : translations) {
+		if (auto const p = (*target.interpolator)(time, target.cursor)) { target.node->transform.set_position(*p); }
+	}
+	for (auto& target : rotations) {
+		if (auto const o = (*target.interpolator)(time, target.cursor)) { target.node->transform.set_orientation(*o); }
+	}
+	for (auto& target : scales) {
+		if (auto const s = (*target.interpolator)(time, target.cursor)) { target.node->transform.set_scale(*s); }
+	}
+}
+
+auto Animation::Binding::reset_cursors() -> void {
+	for (auto& target : translations) { target.cursor = {}; }
+	for (auto& target : rotations) { target.cursor = {}; }
+	for (auto& target : scales) { target.cursor = {}; }
+}
 
 auto Animation::duration() const -> Duration {
 	auto ret = Duration{};
@@ -32,4 +79,9 @@ auto Animation::duration() const -> Duration {
 auto Animation::update(NodeLocator node_locator, Duration time) const -> void {
 	for (auto const& channel : channels) { channel.update(node_locator, time); }
 }
+
+auto Animation::update(NodeLocator node_locator, Duration time, std::span<KeyframeCursor> cursors) const -> void {
+	assert(cursors.size() >= channels.size());
+	for (auto [channel, cursor] : zip_ranges(channels, cursors)) { channel.update(node_locator, time, cursor); }
+}
 } // namespace le::graphics
@@ -0,0 +1,20 @@
+#include <glm/geometric.hpp>
+#include <le/graphics/animation/animation_lod.hpp>
+
+namespace le::graphics {
+auto AnimationLod::get_interval(glm::vec3 const position, float const scale) const -> std::uint32_t {
+	if (!enabled) { return 1; }
+	auto const offset = position - origin;
+	auto const distance_sq = glm::dot(offset, offset);
+	for (auto const& tier : tiers) {
+		auto const distance = tier.distance * scale;
+		if (distance_sq <= distance * distance) { return tier.interval; }
+	}
+	return 0;
+}
+
+auto AnimationLod::is_update_frame(std::uint32_t const interval, std::uint64_t const phase) const -> bool {
+	if (interval == 0) { return false; }
+	return (m_frame + phase) % interval == 0;
+}
+} // namespace le::graphics
@@ -0,0 +1,25 @@
+#include <glm/geometric.hpp>
+#include <le/graphics/bounds.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace le::graphics {
+auto Bounds::from(std::span<Vertex const> vertices) -> Bounds {
+	if (vertices.empty()) { return {}; }
+	auto lo = vertices.front().position;
+	auto hi = lo;
+	for (auto const& vertex : vertices) {
+		lo = glm::min(lo, vertex.position);
+		hi = glm::max(hi, vertex.position);
+	}
+	auto ret = Bounds{.centre = 0.5f * (lo + hi), .half_extent = 0.5f * (hi - lo)};
+	// tighter than the box's circumscribed sphere for most meshes.
+	auto radius_sq = 0.0f;
+	for (auto const& vertex : vertices) {
+		auto const offset = vertex.position - ret.centre;
+		radius_sq = std::max(radius_sq, glm::dot(offset, offset));
+	}
+	ret.radius = std::sqrt(radius_sq);
+	return ret;
+}
+} // namespace le::graphics
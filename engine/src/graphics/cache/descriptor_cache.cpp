@@ -8,11 +8,13 @@ namespace {
 auto make_descriptor_pool(vk::Device device) -> vk::UniqueDescriptorPool {
 	static constexpr std::uint32_t descriptor_count_v{3};
 	static constexpr std::uint32_t max_sets_v{3};
+	// ComputeSkinning sets bind four storage buffers.
+	static constexpr std::uint32_t storage_descriptor_count_v{4 * max_sets_v};
 
 	auto const pool_sizes = std::array{
 		vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler, descriptor_count_v},
 		vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer, descriptor_count_v},
-		vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer, descriptor_count_v},
+		vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer, storage_descriptor_count_v},
 	};
 
 	auto dpci = vk::DescriptorPoolCreateInfo{};
@@ -1,9 +1,11 @@
+#include <impl/frame_profiler.hpp>
 #include <le/core/hash_combine.hpp>
 #include <le/core/logger.hpp>
 #include <le/graphics/cache/pipeline_cache.hpp>
 #include <le/graphics/device.hpp>
 #include <vulkan/vulkan_hash.hpp>
 #include <algorithm>
+#include <cstring>
 #include <map>
 
 namespace le::graphics {
@@ -12,7 +14,7 @@ struct PipelineShaderLayout {
 	std::vector<vk::UniqueDescriptorSetLayout> descriptor_set_layouts{};
 	std::vector<vk::DescriptorSetLayout> descriptor_set_layouts_view{};
 
-	static auto make(ShaderLayout const& shader_layout, vk::Device device) -> PipelineShaderLayout {
+	static auto make(ShaderLayout const& shader_layout, vk::Device device, bool const bindless) -> PipelineShaderLayout {
 		auto ordered_set_layouts = shader_layout.custom_sets;
 
 		auto& camera_set = ordered_set_layouts[shader_layout.camera.set];
@@ -30,15 +32,37 @@ struct PipelineShaderLayout {
 		object_set.emplace_back(shader_layout.object.instances, vk::DescriptorType::eStorageBuffer, 1);
 		object_set.emplace_back(shader_layout.object.joints, vk::DescriptorType::eStorageBuffer, 1);
 
+		auto const& table = shader_layout.material_table;
+		if (bindless) {
+			auto& table_set = ordered_set_layouts[table.set];
+			table_set.emplace_back(table.textures, vk::DescriptorType::eCombinedImageSampler, table.texture_capacity);
+			table_set.emplace_back(table.params, vk::DescriptorType::eStorageBuffer, 1);
+		}
+
 		for (auto& [_, bindings] : ordered_set_layouts) {
 			for (auto& binding : bindings) { binding.stageFlags = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment; }
 		}
 
 		auto ret = PipelineShaderLayout{};
+		auto binding_flags = std::vector<vk::DescriptorBindingFlags>{};
+		auto dslbfci = vk::DescriptorSetLayoutBindingFlagsCreateInfo{};
 		for (auto const& [set, bindings] : ordered_set_layouts) {
 			auto dslci = vk::DescriptorSetLayoutCreateInfo{};
 			dslci.bindingCount = static_cast<std::uint32_t>(bindings.size());
 			dslci.pBindings = bindings.data();
+			if (bindless && set == table.set) {
+				// textures are registered once and written while other frames are in flight.
+				using Flag = vk::DescriptorBindingFlagBits;
+				static constexpr auto texture_flags_v = Flag::ePartiallyBound | Flag::eUpdateAfterBind | Flag::eUpdateUnusedWhilePending;
+				binding_flags.clear();
+				for (auto const& binding : bindings) {
+					binding_flags.push_back(binding.binding == table.textures ? texture_flags_v : vk::DescriptorBindingFlags{});
+				}
+				dslbfci.bindingCount = static_cast<std::uint32_t>(binding_flags.size());
+				dslbfci.pBindingFlags = binding_flags.data();
+				dslci.flags = vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool;
+				dslci.pNext = &dslbfci;
+			}
 			ret.descriptor_set_layouts.push_back(device.createDescriptorSetLayoutUnique(dslci));
 			ret.descriptor_set_layouts_view.push_back(*ret.descriptor_set_layouts.back());
 		}
@@ -46,22 +70,116 @@ struct PipelineShaderLayout {
 	}
 };
 
+// line width is dynamic state: pipelines must not be duplicated per width.
+constexpr auto normalized(PipelineState state) -> PipelineState {
+	state.line_width = PipelineState{}.line_width;
+	return state;
+}
+
+template <typename Type>
+auto append(std::vector<std::byte>& out, Type const& value) -> void {
+	auto const offset = out.size();
+	out.resize(offset + sizeof(Type));
+	std::memcpy(out.data() + offset, &value, sizeof(Type));
+}
+
+template <typename Type>
+auto extract(std::span<std::byte const>& bytes, Type& out) -> bool {
+	if (bytes.size() < sizeof(Type)) { return false; }
+	std::memcpy(&out, bytes.data(), sizeof(Type));
+	bytes = bytes.subspan(sizeof(Type));
+	return true;
+}
+
+constexpr auto disk_header_size_v = 4 * sizeof(char) + 4 * sizeof(std::uint32_t) + 2 * VK_UUID_SIZE + sizeof(std::uint64_t);
+
 auto const g_log{logger::Logger{"Cache"}};
 } // namespace
 
+auto PipelineCache::DiskHeader::make(vk::PhysicalDeviceProperties const& properties, std::span<std::uint8_t const, VK_UUID_SIZE> device_uuid) -> DiskHeader {
+	auto ret = DiskHeader{
+		.vendor_id = properties.vendorID,
+		.device_id = properties.deviceID,
+		.driver_version = properties.driverVersion,
+	};
+	std::ranges::copy(device_uuid, ret.device_uuid.begin());
+	std::ranges::copy(properties.pipelineCacheUUID, ret.cache_uuid.begin());
+	return ret;
+}
+
+auto PipelineCache::DiskHeader::read(std::span<std::byte const> bytes) -> std::optional<DiskHeader> {
+	auto ret = DiskHeader{};
+	if (!extract(bytes, ret.magic) || ret.magic != magic_v) { return {}; }
+	if (!extract(bytes, ret.version) || ret.version != version_v) { return {}; }
+	if (!extract(bytes, ret.vendor_id) || !extract(bytes, ret.device_id) || !extract(bytes, ret.driver_version)) { return {}; }
+	if (!extract(bytes, ret.device_uuid) || !extract(bytes, ret.cache_uuid) || !extract(bytes, ret.data_size)) { return {}; }
+	if (bytes.size() != ret.data_size) { return {}; }
+	return ret;
+}
+
+auto PipelineCache::DiskHeader::is_compatible(DiskHeader const& rhs) const -> bool {
+	return vendor_id == rhs.vendor_id && device_id == rhs.device_id && driver_version == rhs.driver_version && device_uuid == rhs.device_uuid &&
+		   cache_uuid == rhs.cache_uuid;
+}
+
+auto PipelineCache::DiskHeader::write_to(std::vector<std::byte>& out) const -> void {
+	out.reserve(out.size() + disk_header_size_v + data_size);
+	append(out, magic);
+	append(out, version);
+	append(out, vendor_id);
+	append(out, device_id);
+	append(out, driver_version);
+	append(out, device_uuid);
+	append(out, cache_uuid);
+	append(out, data_size);
+}
+
 PipelineCache::Key::Key(PipelineFormat format, Shader shader, PipelineState state, vk::PolygonMode polygon_mode)
-	: format(format), shader(std::move(shader)), state(state), polygon_mode(polygon_mode) {
-	cached_hash = make_combined_hash(shader.vertex.hash(), shader.fragment.hash(), state.topology, polygon_mode, state.depth_compare, state.depth_test_write,
-									 format.colour, format.depth);
+	: format(format), shader(std::move(shader)), state(normalized(state)), polygon_mode(polygon_mode),
+	  cached_hash(make_hash(this->format, this->shader, this->state, this->polygon_mode)) {}
+
+auto PipelineCache::Key::make_hash(PipelineFormat const format, Shader const& shader, PipelineState const& state, vk::PolygonMode const polygon_mode)
+	-> std::uint64_t {
+	// update this (and normalized()) when adding members to PipelineState.
+	static_assert(sizeof(PipelineState) == 4 * sizeof(std::uint32_t));
+	auto ret = std::uint64_t{};
+	hash_combine_64(ret, shader.vertex.hash());
+	hash_combine_64(ret, shader.fragment.hash());
+	hash_combine_64(ret, static_cast<std::uint64_t>(format.colour) << 32 | static_cast<std::uint64_t>(format.depth));
+	hash_combine_64(ret, static_cast<std::uint64_t>(state.topology) << 32 | static_cast<std::uint64_t>(state.depth_compare));
+	hash_combine_64(ret, static_cast<std::uint64_t>(state.depth_test_write) << 32 | static_cast<std::uint64_t>(polygon_mode));
+	return ret;
 }
 
-PipelineCache::PipelineCache(ShaderLayout shader_layout) { set_shader_layout(std::move(shader_layout)); }
+auto PipelineCache::Key::matches(PipelineFormat const format, Shader const& shader, PipelineState const& state, vk::PolygonMode const polygon_mode) const
+	-> bool {
+	return this->format.colour == format.colour && this->format.depth == format.depth && this->shader.vertex == shader.vertex &&
+		   this->shader.fragment == shader.fragment && this->state == normalized(state) && this->polygon_mode == polygon_mode;
+}
+
+PipelineCache::PipelineCache(ShaderLayout shader_layout) {
+	set_shader_layout(std::move(shader_layout));
+	m_vk_cache = m_device.createPipelineCacheUnique({});
+}
+
+auto PipelineCache::default_compile_threads() -> std::size_t { return std::max(ThreadPool::default_thread_count() / 2, std::size_t{1}); }
 
 auto PipelineCache::set_shader_layout(ShaderLayout shader_layout) -> void {
+	// pending builds reference the current pipeline layout.
+	wait_pending();
 	m_shader_layout = std::move(shader_layout);
 
 	m_device = Device::self().get_device();
-	auto pipeline_shader_layout = PipelineShaderLayout::make(m_shader_layout, m_device);
+	auto const bindless = Device::self().get_info().bindless;
+	if (bindless) {
+		using IndexingProperties = vk::PhysicalDeviceDescriptorIndexingProperties;
+		auto const properties = Device::self().get_physical_device().getProperties2<vk::PhysicalDeviceProperties2, IndexingProperties>();
+		auto const& limits = properties.get<IndexingProperties>();
+		auto& capacity = m_shader_layout.material_table.texture_capacity;
+		capacity = std::min({capacity, limits.maxDescriptorSetUpdateAfterBindSampledImages, limits.maxPerStageDescriptorUpdateAfterBindSampledImages,
+							 limits.maxPerStageDescriptorUpdateAfterBindSamplers});
+	}
+	auto pipeline_shader_layout = PipelineShaderLayout::make(m_shader_layout, m_device, bindless);
 
 	m_descriptor_set_layouts = std::move(pipeline_shader_layout).descriptor_set_layouts;
 	m_descriptor_set_layouts_view = std::move(pipeline_shader_layout.descriptor_set_layouts_view);
@@ -69,47 +187,127 @@ auto PipelineCache::set_shader_layout(ShaderLayout shader_layout) -> void {
 	auto plci = vk::PipelineLayoutCreateInfo{};
 	plci.setLayoutCount = static_cast<std::uint32_t>(m_descriptor_set_layouts_view.size());
 	plci.pSetLayouts = m_descriptor_set_layouts_view.data();
+	auto const material_index_range = vk::PushConstantRange{vk::ShaderStageFlagBits::eFragment, 0, sizeof(std::uint32_t)};
+	if (bindless) {
+		plci.pushConstantRangeCount = 1;
+		plci.pPushConstantRanges = &material_index_range;
+	}
 	m_pipeline_layout = m_device.createPipelineLayoutUnique(plci);
 }
 
-auto PipelineCache::load(PipelineFormat format, Shader shader, PipelineState state, vk::PolygonMode polygon_mode) -> vk::Pipeline {
+auto PipelineCache::load(PipelineFormat format, Shader const& shader, PipelineState const& state, vk::PolygonMode polygon_mode) -> vk::Pipeline {
+	// hot path (every draw call): look up without constructing a Key (which copies shader Uris).
+	auto const hash = Key::make_hash(format, shader, normalized(state), polygon_mode);
+	auto const matches = [&](Key const& key) { return key.matches(format, shader, state, polygon_mode); };
+	if (auto const* pipeline = m_pipelines.find(hash, matches)) { return **pipeline; }
+
+	auto const key = Key{format, shader, state, polygon_mode};
+	if (auto itr = m_pending.find(key); itr != m_pending.end()) {
+		auto& future = itr->second;
+		if (skip_unready && future.wait_for(0s) != std::future_status::ready) { return {}; }
+		auto const start = Clock::now();
+		auto pipeline = future.get();
+		m_pending.erase(itr);
+		FrameProfiler::self().add_pipeline_compile(Clock::now() - start);
+		return insert(key, std::move(pipeline));
+	}
+
+	auto const modules = load_modules(key.shader);
+	if (!modules) { return {}; }
+	if (skip_unready) {
+		enqueue(key, *modules);
+		return {};
+	}
+
+	auto const start = Clock::now();
+	auto pipeline = build(key, *modules);
+	FrameProfiler::self().add_pipeline_compile(Clock::now() - start);
+	return insert(key, std::move(pipeline));
+}
+
+auto PipelineCache::prewarm(PipelineFormat format, Shader shader, PipelineState state, vk::PolygonMode polygon_mode) -> bool {
 	auto const key = Key{format, std::move(shader), state, polygon_mode};
-	auto itr = m_pipelines.find(key);
-	if (itr == m_pipelines.end()) {
-		auto ret = build(key);
-		if (!ret) { return {}; }
-		auto const [inserted, _] = m_pipelines.insert_or_assign(key, std::move(ret));
-		itr = inserted;
-
-		g_log.debug("new Vulkan Pipeline created [{}] (total: {})", key.hash(), m_pipelines.size());
+	if (m_pipelines.contains(key) || m_pending.contains(key)) { return false; }
+	auto const modules = load_modules(key.shader);
+	if (!modules) { return false; }
+	enqueue(key, *modules);
+	return true;
+}
+
+auto PipelineCache::wait_pending() -> void {
+	for (auto& [key, future] : m_pending) { insert(key, future.get()); }
+	m_pending.clear();
+}
+
+auto PipelineCache::get_stats() const -> Stats {
+	return Stats{
+		.hits = m_hits.load(),
+		.misses = m_misses.load(),
+		.pending = m_pending.size(),
+		.compile_time = std::chrono::nanoseconds{m_compile_ns.load()},
+	};
+}
+
+auto PipelineCache::load_vk_cache(std::span<std::byte const> bytes) -> bool {
+	auto const header = DiskHeader::read(bytes);
+	if (!header || !header->is_compatible(make_disk_header())) {
+		if (!bytes.empty()) { g_log.info("discarding incompatible Vulkan Pipeline Cache data"); }
+		return false;
 	}
-	assert(itr != m_pipelines.end());
-	return *itr->second;
+
+	wait_pending();
+	auto const data = bytes.last(static_cast<std::size_t>(header->data_size));
+	auto pcci = vk::PipelineCacheCreateInfo{};
+	pcci.initialDataSize = data.size();
+	pcci.pInitialData = data.data();
+	m_vk_cache = m_device.createPipelineCacheUnique(pcci);
+	g_log.info("loaded Vulkan Pipeline Cache data ({} bytes)", data.size());
+	return true;
+}
+
+auto PipelineCache::serialize_vk_cache() const -> std::vector<std::byte> {
+	auto const data = m_device.getPipelineCacheData(*m_vk_cache);
+	auto header = make_disk_header();
+	header.data_size = data.size();
+	auto ret = std::vector<std::byte>{};
+	header.write_to(ret);
+	auto const offset = ret.size();
+	ret.resize(offset + data.size());
+	std::memcpy(ret.data() + offset, data.data(), data.size());
+	return ret;
 }
 
 auto PipelineCache::clear_pipelines() -> void {
+	wait_pending();
 	g_log.debug("[{}] Vulkan Pipelines destroyed", m_pipelines.size());
 	m_pipelines.clear();
 }
 
 auto PipelineCache::clear_pipelines_and_shaders() -> void {
+	// pending builds reference shader modules.
+	wait_pending();
 	m_device.waitIdle();
 	clear_pipelines();
 	m_shader_cache.clear_shaders();
 }
 
-auto PipelineCache::build(Key const& key) -> vk::UniquePipeline {
+auto PipelineCache::load_modules(Shader const& shader) -> std::optional<Modules> {
+	auto ret = Modules{.vertex = m_shader_cache.load(shader.vertex), .fragment = m_shader_cache.load(shader.fragment)};
+	if (!ret.vertex || !ret.fragment) { return {}; }
+	return ret;
+}
+
+// may be called on worker threads: only reads immutable state (and the internally synchronized vk::PipelineCache).
+auto PipelineCache::build(Key const& key, Modules const modules) -> vk::UniquePipeline {
+	auto const start = Clock::now();
+
 	auto shader_stages = std::array<vk::PipelineShaderStageCreateInfo, 2>{};
 	shader_stages[0].stage = vk::ShaderStageFlagBits::eVertex;
 	shader_stages[1].stage = vk::ShaderStageFlagBits::eFragment;
 	shader_stages[0].pName = shader_stages[1].pName = "main";
 
-	auto vertex_shader = m_shader_cache.load(key.shader.vertex);
-	auto fragment_shader = m_shader_cache.load(key.shader.fragment);
-	if (vertex_shader == nullptr || fragment_shader == nullptr) { return {}; }
-
-	shader_stages[0].module = vertex_shader;
-	shader_stages[1].module = fragment_shader;
+	shader_stages[0].module = modules.vertex;
+	shader_stages[1].module = modules.fragment;
 	assert(shader_stages[0].module && shader_stages[1].module);
 
 	auto pvisci = vk::PipelineVertexInputStateCreateInfo{};
@@ -176,10 +374,39 @@ auto PipelineCache::build(Key const& key) -> vk::UniquePipeline {
 	prci.depthAttachmentFormat = key.format.depth;
 	gpci.pNext = &prci;
 
+	// creation feedback (core in 1.3) reports whether the driver found the pipeline in m_vk_cache.
+	auto feedback = vk::PipelineCreationFeedback{};
+	auto pcfci = vk::PipelineCreationFeedbackCreateInfo{};
+	pcfci.pPipelineCreationFeedback = &feedback;
+	prci.pNext = &pcfci;
+
 	gpci.layout = *m_pipeline_layout;
 	auto ret = vk::Pipeline{};
-	if (m_device.createGraphicsPipelines({}, 1, &gpci, {}, &ret) != vk::Result::eSuccess) { return {}; }
+	if (m_device.createGraphicsPipelines(*m_vk_cache, 1, &gpci, {}, &ret) != vk::Result::eSuccess) { return {}; }
+
+	using Feedback = vk::PipelineCreationFeedbackFlagBits;
+	auto const cache_hit = (feedback.flags & Feedback::eValid) && (feedback.flags & Feedback::eApplicationPipelineCacheHit);
+	++(cache_hit ? m_hits : m_misses);
+	m_compile_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
 
 	return vk::UniquePipeline{ret, m_device};
 }
+
+auto PipelineCache::enqueue(Key const& key, Modules const modules) -> void {
+	m_pending.insert_or_assign(key, m_compile_pool.enqueue([this, key, modules] { return build(key, modules); }));
+}
+
+auto PipelineCache::insert(Key const& key, vk::UniquePipeline pipeline) -> vk::Pipeline {
+	if (!pipeline) { return {}; }
+	auto const ret = *m_pipelines.insert_or_assign(key, std::move(pipeline));
+	g_log.debug("new Vulkan Pipeline created [{:x}] (total: {})", key.hash(), m_pipelines.size());
+	return ret;
+}
+
+auto PipelineCache::make_disk_header() const -> DiskHeader {
+	auto const gpu = Device::self().get_physical_device();
+	auto const properties = gpu.getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceIDProperties>();
+	auto const& device_uuid = properties.get<vk::PhysicalDeviceIDProperties>().deviceUUID;
+	return DiskHeader::make(properties.get<vk::PhysicalDeviceProperties2>().properties, std::span<std::uint8_t const, VK_UUID_SIZE>{device_uuid.data(), VK_UUID_SIZE});
+}
 } // namespace le::graphics
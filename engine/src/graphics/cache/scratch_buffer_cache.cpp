@@ -1,26 +1,94 @@
 #include <le/graphics/cache/scratch_buffer_cache.hpp>
+#include <le/graphics/device.hpp>
 #include <le/graphics/renderer.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <utility>
 
 namespace le::graphics {
-auto ScratchBufferCache::allocate_host(vk::BufferUsageFlags const usage) -> HostBuffer& {
-	auto& pool = m_maps[Renderer::self().get_frame_index()][usage];
-	if (pool.next >= pool.buffers.size()) { pool.buffers.push_back(std::make_unique<HostBuffer>(usage)); }
-	return *pool.buffers[pool.next++];
+namespace {
+constexpr std::size_t min_alignment_v{16};
+
+constexpr auto align_up(std::size_t const value, std::size_t const alignment) -> std::size_t { return (value + alignment - 1) & ~(alignment - 1); }
+} // namespace
+
+ScratchBufferCache::ScratchBufferCache() {
+	auto const& limits = Device::self().get_physical_device().getProperties().limits;
+	m_storage_alignment = std::max(static_cast<std::size_t>(limits.minStorageBufferOffsetAlignment), min_alignment_v);
+	m_uniform_alignment = std::max(static_cast<std::size_t>(limits.minUniformBufferOffsetAlignment), min_alignment_v);
+}
+
+auto ScratchBufferCache::allocate(vk::BufferUsageFlags const usage, std::size_t const size) -> Allocation {
+	auto& arena = m_maps[Renderer::self().get_frame_index()][usage];
+	auto offset = align_up(arena.offset, get_alignment(usage));
+	if (arena.block < arena.blocks.size() && offset + size > arena.blocks[arena.block]->capacity()) {
+		// current block is full: move to the next one, earlier allocations in this frame must remain valid.
+		++arena.block;
+		offset = 0;
+	}
+	if (arena.block >= arena.blocks.size()) { arena.blocks.push_back(std::make_unique<HostBuffer>(usage, std::max(block_size_v, std::bit_ceil(size)))); }
+
+	auto& buffer = *arena.blocks[arena.block];
+	arena.offset = offset + size;
+	m_frame_used += size;
+	auto* mapped = static_cast<std::byte*>(buffer.mapped()) + offset; // NOLINT
+	return Allocation{.buffer = buffer.buffer(), .offset = offset, .size = size, .mapped = {mapped, size}};
+}
+
+auto ScratchBufferCache::write(vk::BufferUsageFlags const usage, void const* data, std::size_t const size) -> Allocation {
+	auto ret = allocate(usage, size);
+	if (size > 0) { std::memcpy(ret.mapped.data(), data, size); }
+	return ret;
 }
 
 auto ScratchBufferCache::get_empty_buffer(vk::BufferUsageFlags const usage) -> DeviceBuffer const& {
-	auto& pool = m_maps[Renderer::self().get_frame_index()][usage];
-	if (!pool.empty_buffer) {
-		pool.empty_buffer = std::make_unique<DeviceBuffer>(usage, 1);
+	auto& arena = m_maps[Renderer::self().get_frame_index()][usage];
+	if (!arena.empty_buffer) {
+		arena.empty_buffer = std::make_unique<DeviceBuffer>(usage, 1);
 		static constexpr std::uint8_t empty_byte_v{0x0};
-		pool.empty_buffer->write(&empty_byte_v, sizeof(empty_byte_v));
+		arena.empty_buffer->write(&empty_byte_v, sizeof(empty_byte_v));
 	}
-	return *pool.empty_buffer;
+	return *arena.empty_buffer;
+}
+
+auto ScratchBufferCache::get_alignment(vk::BufferUsageFlags const usage) const -> std::size_t {
+	auto ret = min_alignment_v;
+	if (usage & vk::BufferUsageFlagBits::eStorageBuffer) { ret = std::max(ret, m_storage_alignment); }
+	if (usage & vk::BufferUsageFlagBits::eUniformBuffer) { ret = std::max(ret, m_uniform_alignment); }
+	return ret;
+}
+
+auto ScratchBufferCache::get_stats() const -> Stats {
+	auto ret = Stats{.bytes_used = m_last_frame_used, .high_water = m_high_water};
+	for (auto const& map : m_maps) {
+		for (auto const& [_, arena] : map) {
+			ret.buffers += arena.blocks.size();
+			for (auto const& block : arena.blocks) { ret.capacity += block->capacity(); }
+		}
+	}
+	return ret;
 }
 
 auto ScratchBufferCache::next_frame() -> void {
-	for (auto& [_, pool] : m_maps[Renderer::self().get_frame_index()]) { pool.next = {}; }
+	m_last_frame_used = std::exchange(m_frame_used, 0);
+	m_high_water = std::max(m_high_water, m_last_frame_used);
+	for (auto& [usage, arena] : m_maps[Renderer::self().get_frame_index()]) {
+		if (arena.blocks.size() > 1) {
+			// this frame spilled into multiple blocks: replace them with a single one large enough for all of it.
+			auto capacity = std::size_t{};
+			for (auto const& block : arena.blocks) { capacity += block->capacity(); }
+			capacity = std::bit_ceil(capacity);
+			arena.blocks.clear();
+			arena.blocks.push_back(std::make_unique<HostBuffer>(usage, capacity));
+		}
+		arena.block = {};
+		arena.offset = {};
+	}
 }
 
-auto ScratchBufferCache::clear() -> void { m_maps = {}; }
+auto ScratchBufferCache::clear() -> void {
+	m_maps = {};
+	m_frame_used = m_last_frame_used = m_high_water = {};
+}
 } // namespace le::graphics
@@ -1,11 +1,13 @@
 #include <le/error.hpp>
 #include <le/graphics/command_buffer.hpp>
 #include <le/graphics/device.hpp>
+#include <le/graphics/upload_queue.hpp>
+#include <vector>
 
 namespace le::graphics {
 CommandBuffer::CommandBuffer() {
 	auto device = Device::self().get_device();
-	m_pool = device.createCommandPoolUnique({vk::CommandPoolCreateFlagBits::eTransient});
+	m_pool = device.createCommandPoolUnique({vk::CommandPoolCreateFlagBits::eTransient, Device::self().get_queue_family()});
 	auto const cbai = vk::CommandBufferAllocateInfo{*m_pool, vk::CommandBufferLevel::ePrimary, 1};
 	if (device.allocateCommandBuffers(&cbai, &m_cb) != vk::Result::eSuccess) { throw Error{"Failed to allocate Vulkan Command Buffer"}; }
 	m_cb.begin({vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
@@ -18,6 +20,12 @@ auto CommandBuffer::submit() -> void {
 	auto vsi = vk::SubmitInfo2{};
 	vsi.commandBufferInfoCount = 1;
 	vsi.pCommandBufferInfos = &cbsi;
+	auto waits = std::vector<vk::SemaphoreSubmitInfo>{};
+	if (UploadQueue::exists()) {
+		UploadQueue::self().flush(waits, vk::PipelineStageFlagBits2::eAllCommands);
+		vsi.waitSemaphoreInfoCount = static_cast<std::uint32_t>(waits.size());
+		vsi.pWaitSemaphoreInfos = waits.data();
+	}
 	auto& device = Device::self();
 	auto fence = device.get_device().createFenceUnique({});
 	device.submit(vsi, *fence);
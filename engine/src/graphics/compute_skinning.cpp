@@ -0,0 +1,175 @@
+#include <le/core/hash_combine.hpp>
+#include <le/core/logger.hpp>
+#include <le/core/profiler.hpp>
+#include <le/error.hpp>
+#include <le/graphics/cache/descriptor_cache.hpp>
+#include <le/graphics/cache/scratch_buffer_cache.hpp>
+#include <le/graphics/compute_skinning.hpp>
+#include <le/graphics/defer.hpp>
+#include <le/graphics/device.hpp>
+#include <le/graphics/renderer.hpp>
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace le::graphics {
+namespace {
+auto const g_log{logger::Logger{"ComputeSkinning"}};
+
+enum Binding : std::uint32_t { eVertices, eBones, eJoints, eOutput, eCOUNT_ };
+} // namespace
+
+auto ComputeSkinning::Hasher::operator()(Key const& key) const -> std::size_t { return make_combined_hash(key.primitive, key.joints); }
+
+auto ComputeSkinning::is_supported() -> bool {
+	auto const& device = Device::self();
+	auto const queue_flags = device.get_physical_device().getQueueFamilyProperties()[device.get_queue_family()].queueFlags;
+	return static_cast<bool>(queue_flags & vk::QueueFlagBits::eCompute);
+}
+
+ComputeSkinning::ComputeSkinning() {
+	if (!is_supported()) { throw Error{"Compute not supported by Device queue"}; }
+}
+
+ComputeSkinning::~ComputeSkinning() { clear(); }
+
+auto ComputeSkinning::skin(Primitive const& primitive, std::span<glm::mat4 const> const joints, vk::CommandBuffer const cmd) -> vk::Buffer {
+	auto const source = primitive.get_skin_source();
+	auto const vertex_count = primitive.layout().vertex_count;
+	if (!source || joints.empty() || vertex_count == 0 || !create_pipeline()) { return {}; }
+
+	auto& slot = m_slots[Key{.primitive = &primitive, .joints = joints.data()}];
+	slot.last_used = m_frame_count;
+	auto& out = slot.outputs[Renderer::self().get_frame_index()];
+
+	auto const size = vertex_count * sizeof(Vertex);
+	if (!out.vertices || out.vertices->capacity() < size) {
+		// the previous buffer may still be in use by frames in flight.
+		if (out.vertices) { DeferQueue::self().push(std::move(out.vertices)); }
+		out.vertices = std::make_unique<DeviceBuffer>(vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eVertexBuffer, size);
+		out.joints.clear();
+	}
+
+	if (out.generation == source.generation && std::ranges::equal(out.joints, joints)) {
+		++m_stats.skipped;
+	} else {
+		dispatch(source, vertex_count, out, joints, cmd);
+	}
+	return out.vertices->buffer();
+}
+
+auto ComputeSkinning::barrier(vk::CommandBuffer const cmd) -> void {
+	if (!m_dispatched) { return; }
+	m_dispatched = false;
+
+	auto barrier = vk::MemoryBarrier2{};
+	barrier.srcStageMask = vk::PipelineStageFlagBits2::eComputeShader;
+	barrier.srcAccessMask = vk::AccessFlagBits2::eShaderStorageWrite;
+	barrier.dstStageMask = vk::PipelineStageFlagBits2::eVertexAttributeInput;
+	barrier.dstAccessMask = vk::AccessFlagBits2::eVertexAttributeRead;
+	auto vdi = vk::DependencyInfo{};
+	vdi.memoryBarrierCount = 1;
+	vdi.pMemoryBarriers = &barrier;
+	cmd.pipelineBarrier2(vdi);
+}
+
+auto ComputeSkinning::get_stats() const -> Stats {
+	auto ret = m_last_stats;
+	ret.outputs = static_cast<std::uint32_t>(m_slots.size());
+	return ret;
+}
+
+auto ComputeSkinning::next_frame() -> void {
+	++m_frame_count;
+	m_last_stats = std::exchange(m_stats, {});
+	m_dispatched = false;
+	std::erase_if(m_slots, [this](auto& entry) {
+		auto& slot = entry.second;
+		if (slot.last_used + retain_frames_v > m_frame_count) { return false; }
+		for (auto& output : slot.outputs) { DeferQueue::self().push(std::move(output.vertices)); }
+		return true;
+	});
+}
+
+auto ComputeSkinning::clear() -> void {
+	m_slots.clear();
+	m_pipeline.reset();
+	m_pipeline_layout.reset();
+	m_set_layout.reset();
+	m_shader_cache.clear_shaders();
+	m_pipeline_failed = false;
+}
+
+auto ComputeSkinning::create_pipeline() -> bool {
+	if (m_pipeline) { return true; }
+	if (m_pipeline_failed) { return false; }
+
+	auto const shader_module = m_shader_cache.load(compute_shader_v);
+	if (!shader_module) {
+		g_log.warn("failed to load compute shader [{}], skinning in vertex shaders", compute_shader_v);
+		m_pipeline_failed = true;
+		return false;
+	}
+
+	auto const device = Device::self().get_device();
+	auto bindings = std::array<vk::DescriptorSetLayoutBinding, eCOUNT_>{};
+	for (std::uint32_t i = 0; i < bindings.size(); ++i) {
+		bindings[i] = vk::DescriptorSetLayoutBinding{i, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute};
+	}
+	auto dslci = vk::DescriptorSetLayoutCreateInfo{};
+	dslci.bindingCount = static_cast<std::uint32_t>(bindings.size());
+	dslci.pBindings = bindings.data();
+	m_set_layout = device.createDescriptorSetLayoutUnique(dslci);
+
+	auto const vertex_count_range = vk::PushConstantRange{vk::ShaderStageFlagBits::eCompute, 0, sizeof(std::uint32_t)};
+	auto plci = vk::PipelineLayoutCreateInfo{};
+	plci.setLayoutCount = 1;
+	plci.pSetLayouts = &*m_set_layout;
+	plci.pushConstantRangeCount = 1;
+	plci.pPushConstantRanges = &vertex_count_range;
+	m_pipeline_layout = device.createPipelineLayoutUnique(plci);
+
+	auto cpci = vk::ComputePipelineCreateInfo{};
+	cpci.stage = vk::PipelineShaderStageCreateInfo{{}, vk::ShaderStageFlagBits::eCompute, shader_module, "main"};
+	cpci.layout = *m_pipeline_layout;
+	auto pipeline = vk::Pipeline{};
+	if (device.createComputePipelines({}, 1, &cpci, {}, &pipeline) != vk::Result::eSuccess) {
+		g_log.warn("failed to create compute skinning pipeline, skinning in vertex shaders");
+		m_pipeline_failed = true;
+		return false;
+	}
+	m_pipeline = vk::UniquePipeline{pipeline, device};
+	g_log.debug("compute skinning pipeline created");
+	return true;
+}
+
+auto ComputeSkinning::dispatch(Primitive::SkinSource const& source, std::uint32_t const vertex_count, Output& out, std::span<glm::mat4 const> const joints,
+							   vk::CommandBuffer const cmd) -> void {
+	LE_PROFILE_SCOPE("ComputeSkinning::dispatch");
+	auto const size = vk::DeviceSize{vertex_count * sizeof(Vertex)};
+	auto const joint_data = ScratchBufferCache::self().write(vk::BufferUsageFlagBits::eStorageBuffer, joints.data(), joints.size_bytes());
+
+	auto const descriptor_set = DescriptorCache::self().allocate(*m_set_layout);
+	auto const infos = std::array{
+		vk::DescriptorBufferInfo{source.vertices, 0, size},
+		vk::DescriptorBufferInfo{source.bones, 0, vertex_count * sizeof(Bone)},
+		joint_data.descriptor_info(),
+		vk::DescriptorBufferInfo{out.vertices->buffer(), 0, size},
+	};
+	auto writes = std::array<vk::WriteDescriptorSet, eCOUNT_>{};
+	for (std::uint32_t i = 0; i < writes.size(); ++i) {
+		writes[i] = vk::WriteDescriptorSet{descriptor_set, i, 0, 1, vk::DescriptorType::eStorageBuffer, nullptr, &infos[i]};
+	}
+	Device::self().get_device().updateDescriptorSets(writes, {});
+
+	cmd.bindPipeline(vk::PipelineBindPoint::eCompute, *m_pipeline);
+	cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *m_pipeline_layout, 0, descriptor_set, {});
+	cmd.pushConstants(*m_pipeline_layout, vk::ShaderStageFlagBits::eCompute, 0, sizeof(vertex_count), &vertex_count);
+	cmd.dispatch((vertex_count + local_size_v - 1) / local_size_v, 1, 1);
+
+	out.joints.assign(joints.begin(), joints.end());
+	out.generation = source.generation;
+	++m_stats.dispatches;
+	m_dispatched = true;
+}
+} // namespace le::graphics
@@ -9,7 +9,8 @@
 #include <le/graphics/device.hpp>
 
 namespace le::graphics {
-DearImGui::DearImGui(Ptr<GLFWwindow> window, vk::Format colour) {
+DearImGui::DearImGui(Ptr<GLFWwindow> window, vk::Format colour, glm::uvec2 const headless_extent)
+	: m_headless_extent(headless_extent), m_headless(window == nullptr) {
 	auto& device = Device::self();
 
 	auto const pool_sizes = std::array{
@@ -44,7 +45,12 @@ DearImGui::DearImGui(Ptr<GLFWwindow> window, vk::Format colour) {
 		return (*gf)(name);
 	};
 	ImGui_ImplVulkan_LoadFunctions(lambda, &get_fn);
-	ImGui_ImplGlfw_InitForVulkan(window, true);
+	if (m_headless) {
+		// don't write imgui.ini from headless runs.
+		io.IniFilename = nullptr;
+	} else {
+		ImGui_ImplGlfw_InitForVulkan(window, true);
+	}
 	ImGui_ImplVulkan_InitInfo init_info = {};
 	init_info.Instance = device.get_instance();
 	init_info.PhysicalDevice = device.get_physical_device();
@@ -69,7 +75,7 @@ DearImGui::DearImGui(Ptr<GLFWwindow> window, vk::Format colour) {
 
 DearImGui::~DearImGui() {
 	ImGui_ImplVulkan_Shutdown();
-	ImGui_ImplGlfw_Shutdown();
+	if (!m_headless) { ImGui_ImplGlfw_Shutdown(); }
 	ImGui::DestroyContext();
 }
 
@@ -77,7 +83,13 @@ DearImGui::~DearImGui() {
 auto DearImGui::new_frame() -> void {
 	if (m_state == State::eEndFrame) { end_frame(); }
 	ImGui_ImplVulkan_NewFrame();
-	ImGui_ImplGlfw_NewFrame();
+	if (m_headless) {
+		auto& io = ImGui::GetIO();
+		io.DisplaySize = {m_headless_extent.x, m_headless_extent.y};
+		io.DeltaTime = 1.0f / 60.0f; // NOLINT
+	} else {
+		ImGui_ImplGlfw_NewFrame();
+	}
 	ImGui::NewFrame();
 	m_state = State::eEndFrame;
 }
@@ -3,6 +3,7 @@
 #include <le/graphics/cache/scratch_buffer_cache.hpp>
 #include <le/graphics/descriptor_updater.hpp>
 #include <le/graphics/device.hpp>
+#include <atomic>
 
 namespace le::graphics {
 namespace {
@@ -20,6 +21,8 @@ auto update_set(T const& info, vk::Device device, vk::DescriptorSet set, vk::Des
 	}
 	device.updateDescriptorSets(wds, {});
 }
+
+std::atomic<std::uint64_t> g_bind_count{}; // NOLINT
 } // namespace
 
 DescriptorUpdater::DescriptorUpdater(std::uint32_t const set) : m_set(set) {
@@ -67,9 +70,8 @@ auto DescriptorUpdater::write(std::uint32_t binding, vk::DescriptorType type, vo
 		return update(binding, type, vk::DescriptorBufferInfo{empty.buffer(), {}, empty.size()}, static_cast<std::uint32_t>(count));
 	}
 
-	auto& buffer = ScratchBufferCache::self().allocate_host(usage);
-	buffer.write(data, size);
-	return update(binding, type, vk::DescriptorBufferInfo{buffer.buffer(), {}, buffer.size()}, static_cast<std::uint32_t>(count));
+	auto const allocation = ScratchBufferCache::self().write(usage, data, size);
+	return update(binding, type, allocation.descriptor_info(), static_cast<std::uint32_t>(count));
 }
 
 auto DescriptorUpdater::bind_set(vk::CommandBuffer cmd) const -> void { bind_set(m_set, m_descriptor_set, cmd); }
@@ -77,5 +79,8 @@ auto DescriptorUpdater::bind_set(vk::CommandBuffer cmd) const -> void { bind_set
 auto DescriptorUpdater::bind_set(std::uint32_t set, vk::DescriptorSet descriptor_set, vk::CommandBuffer cmd) -> void {
 	auto const layout = PipelineCache::self().pipeline_layout();
 	cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layout, set, descriptor_set, {});
+	++g_bind_count;
 }
+
+auto DescriptorUpdater::bind_count() -> std::uint64_t { return g_bind_count; }
 } // namespace le::graphics
@@ -5,6 +5,8 @@
 #include <le/environment.hpp>
 #include <le/graphics/device.hpp>
 #include <le/graphics/resource.hpp>
+#include <le/graphics/upload_queue.hpp>
+#include <optional>
 
 namespace le::graphics {
 namespace {
@@ -82,8 +84,22 @@ struct Gpu {
 	vk::PhysicalDevice device{};
 	vk::PhysicalDeviceProperties properties{};
 	std::uint32_t queue_family{};
+	std::optional<std::uint32_t> transfer_family{};
 };
 
+// prefer a transfer-only family (DMA engine), else any non-graphics family that supports transfers.
+auto find_transfer_family(vk::PhysicalDevice const device) -> std::optional<std::uint32_t> {
+	auto ret = std::optional<std::uint32_t>{};
+	auto const properties = device.getQueueFamilyProperties();
+	for (std::size_t i = 0; i < properties.size(); ++i) {
+		auto const flags = properties[i].queueFlags;
+		if (!(flags & vk::QueueFlagBits::eTransfer) || (flags & vk::QueueFlagBits::eGraphics)) { continue; }
+		if (!(flags & vk::QueueFlagBits::eCompute)) { return static_cast<std::uint32_t>(i); }
+		if (!ret) { ret = static_cast<std::uint32_t>(i); }
+	}
+	return ret;
+}
+
 auto select_gpu(vk::Instance const instance, vk::SurfaceKHR const surface) -> Gpu {
 	enum class Preference {
 		eDiscrete = 10,
@@ -98,7 +114,7 @@ auto select_gpu(vk::Instance const instance, vk::SurfaceKHR const surface) -> Gp
 		auto const properties = device.getQueueFamilyProperties();
 		for (std::size_t i = 0; i < properties.size(); ++i) {
 			auto const family = static_cast<std::uint32_t>(i);
-			if (device.getSurfaceSupportKHR(family, surface) == 0) { continue; }
+			if (surface && device.getSurfaceSupportKHR(family, surface) == 0) { continue; }
 			if (!(properties[i].queueFlags & queue_flags_v)) { continue; }
 			out_family = family;
 			return true;
@@ -111,6 +127,7 @@ auto select_gpu(vk::Instance const instance, vk::SurfaceKHR const surface) -> Gp
 		auto entry = Entry{.gpu = {device}};
 		entry.gpu.properties = device.getProperties();
 		if (!get_queue_family(device, entry.gpu.queue_family)) { continue; }
+		entry.gpu.transfer_family = find_transfer_family(device);
 		if (entry.gpu.properties.deviceType == vk::PhysicalDeviceType::eDiscreteGpu) { entry.preference += static_cast<int>(Preference::eDiscrete); }
 		entries.push_back(entry);
 	}
@@ -119,17 +136,26 @@ auto select_gpu(vk::Instance const instance, vk::SurfaceKHR const surface) -> Gp
 	return entries.back().gpu;
 }
 
-auto make_device(Gpu const& gpu) -> vk::UniqueDevice {
-	static constexpr float priority_v = 1.0f;
-	static constexpr std::array required_extensions_v = {
-		VK_KHR_SWAPCHAIN_EXTENSION_NAME,
+// bindless materials: a partially bound, update-after-bind, runtime sized array of sampled images.
+auto supports_bindless(vk::PhysicalDevice const device) -> bool {
+	auto const features = device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceDescriptorIndexingFeatures>();
+	auto const& indexing = features.get<vk::PhysicalDeviceDescriptorIndexingFeatures>();
+	return features.get<vk::PhysicalDeviceFeatures2>().features.shaderSampledImageArrayDynamicIndexing && indexing.runtimeDescriptorArray &&
+		   indexing.descriptorBindingPartiallyBound && indexing.descriptorBindingSampledImageUpdateAfterBind &&
+		   indexing.descriptorBindingUpdateUnusedWhilePending;
+}
 
+auto make_device(Gpu const& gpu, bool const headless, bool const bindless) -> vk::UniqueDevice {
+	static constexpr float priority_v = 1.0f;
+	auto required_extensions = std::vector<char const*>{};
+	// headless devices never present, and software implementations (eg lavapipe) may not support swapchains.
+	if (!headless) { required_extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME); }
 #if defined(__APPLE__)
-		"VK_KHR_portability_subset",
+	required_extensions.push_back("VK_KHR_portability_subset");
 #endif
-	};
 
-	auto qci = vk::DeviceQueueCreateInfo{{}, gpu.queue_family, 1, &priority_v};
+	auto qcis = std::vector<vk::DeviceQueueCreateInfo>{vk::DeviceQueueCreateInfo{{}, gpu.queue_family, 1, &priority_v}};
+	if (gpu.transfer_family) { qcis.emplace_back(vk::DeviceQueueCreateFlags{}, *gpu.transfer_family, 1, &priority_v); }
 	auto dci = vk::DeviceCreateInfo{};
 	auto enabled = vk::PhysicalDeviceFeatures{};
 	auto available_features = gpu.device.getFeatures();
@@ -137,8 +163,9 @@ auto make_device(Gpu const& gpu) -> vk::UniqueDevice {
 	enabled.wideLines = available_features.wideLines;
 	enabled.samplerAnisotropy = available_features.samplerAnisotropy;
 	enabled.sampleRateShading = available_features.sampleRateShading;
+	enabled.shaderSampledImageArrayDynamicIndexing = static_cast<vk::Bool32>(bindless);
 	auto const available_extensions = gpu.device.enumerateDeviceExtensionProperties();
-	for (auto const* ext : required_extensions_v) {
+	for (auto const* ext : required_extensions) {
 		auto const found = [ext](vk::ExtensionProperties const& props) { return std::string_view{props.extensionName} == ext; };
 		if (std::ranges::find_if(available_extensions, found) == available_extensions.end()) {
 			throw Error{std::format("Required extension '{}' not supported by selected GPU '{}'", ext, gpu.properties.deviceName.data())};
@@ -148,11 +175,22 @@ auto make_device(Gpu const& gpu) -> vk::UniqueDevice {
 	auto dynamic_rendering_feature = vk::PhysicalDeviceDynamicRenderingFeatures{vk::True};
 	auto synchronization_2_feature = vk::PhysicalDeviceSynchronization2FeaturesKHR{vk::True};
 	synchronization_2_feature.pNext = &dynamic_rendering_feature;
+	// UploadQueue signals completion through timeline semaphores (core in Vulkan 1.2).
+	auto timeline_semaphore_feature = vk::PhysicalDeviceTimelineSemaphoreFeatures{vk::True};
+	dynamic_rendering_feature.pNext = &timeline_semaphore_feature;
+	auto descriptor_indexing_feature = vk::PhysicalDeviceDescriptorIndexingFeatures{};
+	if (bindless) {
+		descriptor_indexing_feature.runtimeDescriptorArray = vk::True;
+		descriptor_indexing_feature.descriptorBindingPartiallyBound = vk::True;
+		descriptor_indexing_feature.descriptorBindingSampledImageUpdateAfterBind = vk::True;
+		descriptor_indexing_feature.descriptorBindingUpdateUnusedWhilePending = vk::True;
+		timeline_semaphore_feature.pNext = &descriptor_indexing_feature;
+	}
 
-	dci.queueCreateInfoCount = 1;
-	dci.pQueueCreateInfos = &qci;
-	dci.enabledExtensionCount = static_cast<std::uint32_t>(required_extensions_v.size());
-	dci.ppEnabledExtensionNames = required_extensions_v.data();
+	dci.queueCreateInfoCount = static_cast<std::uint32_t>(qcis.size());
+	dci.pQueueCreateInfos = qcis.data();
+	dci.enabledExtensionCount = static_cast<std::uint32_t>(required_extensions.size());
+	dci.ppEnabledExtensionNames = required_extensions.data();
 	dci.pEnabledFeatures = &enabled;
 	dci.pNext = &synchronization_2_feature;
 
@@ -165,32 +203,48 @@ auto make_device(Gpu const& gpu) -> vk::UniqueDevice {
 } // namespace
 
 Device::Device(Ptr<GLFWwindow> window, CreateInfo const& create_info) {
-	auto count = std::uint32_t{};
-	auto const* result = glfwGetRequiredInstanceExtensions(&count);
-	// NOLINTNEXTLINE
-	auto extensions = std::vector<char const*>(result, result + static_cast<std::size_t>(count));
+	m_info.headless = window == nullptr;
+	auto extensions = std::vector<char const*>{};
+	if (!m_info.headless) {
+		auto count = std::uint32_t{};
+		auto const* result = glfwGetRequiredInstanceExtensions(&count);
+		// NOLINTNEXTLINE
+		extensions.assign(result, result + static_cast<std::size_t>(count));
+	}
 	m_instance = make_instance(std::move(extensions), create_info, m_info);
 
 	if (m_info.validation) { m_debug_messenger = make_debug_messenger(*m_instance); }
 
-	// NOLINTNEXTLINE
-	auto glfw_surface = VkSurfaceKHR{};
-	if (glfwCreateWindowSurface(get_instance(), window, {}, &glfw_surface) != VK_SUCCESS) { throw Error{"Failed to create Vulkan Surface"}; }
-	m_surface = vk::UniqueSurfaceKHR{glfw_surface, get_instance()};
+	if (!m_info.headless) {
+		// NOLINTNEXTLINE
+		auto glfw_surface = VkSurfaceKHR{};
+		if (glfwCreateWindowSurface(get_instance(), window, {}, &glfw_surface) != VK_SUCCESS) { throw Error{"Failed to create Vulkan Surface"}; }
+		m_surface = vk::UniqueSurfaceKHR{glfw_surface, get_instance()};
+	}
 
 	auto const gpu = select_gpu(get_instance(), get_surface());
 	m_physical_device = gpu.device;
 	m_device_properties = gpu.properties;
 	m_queue_family = gpu.queue_family;
 
-	m_device = make_device(gpu);
+	m_info.bindless = create_info.bindless && supports_bindless(gpu.device);
+	m_device = make_device(gpu, m_info.headless, m_info.bindless);
 	m_queue = m_device->getQueue(get_queue_family(), 0);
+	m_info.dedicated_transfer = gpu.transfer_family.has_value();
+	m_transfer_family = gpu.transfer_family.value_or(m_queue_family);
+	m_transfer_queue = m_info.dedicated_transfer ? m_device->getQueue(m_transfer_family, 0) : m_queue;
+	m_queue_families = {m_queue_family, m_transfer_family};
 
 	m_allocator = std::make_unique<graphics::Allocator>(get_instance(), get_physical_device(), get_device());
+	m_upload_queue = std::make_unique<UploadQueue>();
 }
 
 Device::~Device() { m_device->waitIdle(); }
 
+auto Device::get_queue_families() const -> std::span<std::uint32_t const> {
+	return std::span{m_queue_families}.first(m_info.dedicated_transfer ? 2 : 1);
+}
+
 auto Device::wait_for(vk::Fence const fence, std::uint64_t const timeout) const -> bool {
 	return get_device().waitForFences(fence, vk::True, timeout) == vk::Result::eSuccess;
 }
@@ -211,6 +265,12 @@ auto Device::submit(vk::SubmitInfo2 const& submit_info, vk::Fence const signal)
 	return get_queue().submit2(1, &submit_info, signal) == vk::Result::eSuccess;
 }
 
+auto Device::submit_transfer(vk::SubmitInfo2 const& submit_info, vk::Fence const signal) const -> bool {
+	if (!m_info.dedicated_transfer) { return submit(submit_info, signal); }
+	auto lock = std::scoped_lock{m_transfer_mutex};
+	return get_transfer_queue().submit2(1, &submit_info, signal) == vk::Result::eSuccess;
+}
+
 auto Device::submit_and_present(vk::SubmitInfo2 const& submit_info, vk::Fence const submit_signal, vk::PresentInfoKHR const& present_info) const -> vk::Result {
 	auto lock = std::scoped_lock{m_mutex};
 	[[maybe_unused]] auto const result = get_queue().submit2(1, &submit_info, submit_signal);
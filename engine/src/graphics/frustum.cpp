@@ -0,0 +1,135 @@
+#include <glm/geometric.hpp>
+#include <le/graphics/frustum.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LE_FRUSTUM_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace le::graphics {
+namespace {
+constexpr std::size_t lanes_v{4};
+constexpr auto infinity_v = std::numeric_limits<float>::infinity();
+
+auto row(glm::mat4 const& mat, int index) -> glm::vec4 { return {mat[0][index], mat[1][index], mat[2][index], mat[3][index]}; }
+
+auto normalize_plane(glm::vec4 const& plane) -> glm::vec4 { return plane / glm::length(glm::vec3{plane}); }
+
+auto max_scale(glm::mat4 const& mat) -> float {
+	return std::sqrt(std::max({glm::dot(glm::vec3{mat[0]}, glm::vec3{mat[0]}), glm::dot(glm::vec3{mat[1]}, glm::vec3{mat[1]}),
+							   glm::dot(glm::vec3{mat[2]}, glm::vec3{mat[2]})}));
+}
+
+auto merge(Sphere const& a, Sphere const& b) -> Sphere {
+	auto const offset = b.centre - a.centre;
+	auto const distance = glm::length(offset);
+	if (distance + b.radius <= a.radius) { return a; }
+	if (distance + a.radius <= b.radius) { return b; }
+	auto const radius = 0.5f * (distance + a.radius + b.radius);
+	return Sphere{.centre = a.centre + offset * ((radius - a.radius) / distance), .radius = radius};
+}
+} // namespace
+
+auto Frustum::from(glm::mat4 const& view_projection) -> Frustum {
+	// Gribb-Hartmann, for clip space depth in [0, 1].
+	auto const r0 = row(view_projection, 0);
+	auto const r1 = row(view_projection, 1);
+	auto const r2 = row(view_projection, 2);
+	auto const r3 = row(view_projection, 3);
+	return Frustum{.planes = {
+					   normalize_plane(r3 + r0),
+					   normalize_plane(r3 - r0),
+					   normalize_plane(r3 + r1),
+					   normalize_plane(r3 - r1),
+					   normalize_plane(r2),
+					   normalize_plane(r3 - r2),
+				   }};
+}
+
+auto Frustum::intersects(Sphere const& sphere) const -> bool {
+	return std::ranges::all_of(planes, [&sphere](glm::vec4 const& plane) {
+		return (plane.x * sphere.centre.x + plane.y * sphere.centre.y) + (plane.z * sphere.centre.z + plane.w) >= -sphere.radius;
+	});
+}
+
+auto FrustumCuller::world_sphere(RenderObject const& object) -> Sphere {
+	auto const& bounds = object.primitive->layout().bounds;
+	if (!bounds.is_bounded() || !object.joints.empty()) { return Sphere{.radius = infinity_v}; }
+	auto const to_world = [&](glm::mat4 const& mat) {
+		return Sphere{.centre = glm::vec3{mat * glm::vec4{bounds.centre, 1.0f}}, .radius = bounds.radius * max_scale(mat)};
+	};
+	if (object.instances.empty()) { return to_world(object.parent); }
+	auto ret = to_world(object.parent * object.instances.front().transform.matrix());
+	for (auto const& instance : object.instances.subspan(1)) { ret = merge(ret, to_world(object.parent * instance.transform.matrix())); }
+	return ret;
+}
+
+auto FrustumCuller::clear() -> void {
+	m_x.clear();
+	m_y.clear();
+	m_z.clear();
+	m_radius.clear();
+	m_count = {};
+}
+
+auto FrustumCuller::push(Sphere const& sphere) -> void {
+	// keep arrays padded to a multiple of lanes_v, padding spheres are always visible.
+	if (m_count == m_x.size()) {
+		for (std::size_t i = 0; i < lanes_v; ++i) {
+			m_x.push_back({});
+			m_y.push_back({});
+			m_z.push_back({});
+			m_radius.push_back(infinity_v);
+		}
+	}
+	m_x[m_count] = sphere.centre.x;
+	m_y[m_count] = sphere.centre.y;
+	m_z[m_count] = sphere.centre.z;
+	m_radius[m_count] = sphere.radius;
+	++m_count;
+}
+
+auto FrustumCuller::cull(Frustum const& frustum, std::span<std::uint8_t> out_visible) const -> std::size_t {
+#if defined(LE_FRUSTUM_SSE2)
+	assert(out_visible.size() >= m_count);
+	auto ret = std::size_t{};
+	for (std::size_t i = 0; i < m_count; i += lanes_v) {
+		auto const x = _mm_loadu_ps(m_x.data() + i); // NOLINT
+		auto const y = _mm_loadu_ps(m_y.data() + i); // NOLINT
+		auto const z = _mm_loadu_ps(m_z.data() + i); // NOLINT
+		auto const neg_radius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(m_radius.data() + i)); // NOLINT
+		auto inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (auto const& plane : frustum.planes) {
+			auto const xy = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+			auto const zw = _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(xy, zw), neg_radius));
+		}
+		auto const mask = _mm_movemask_ps(inside);
+		auto const count = std::min(lanes_v, m_count - i);
+		for (std::size_t lane = 0; lane < count; ++lane) {
+			auto const visible = (mask >> lane) & 1;
+			out_visible[i + lane] = static_cast<std::uint8_t>(visible);
+			ret += static_cast<std::size_t>(visible);
+		}
+	}
+	return ret;
+#else
+	return cull_scalar(frustum, out_visible);
+#endif
+}
+
+auto FrustumCuller::cull_scalar(Frustum const& frustum, std::span<std::uint8_t> out_visible) const -> std::size_t {
+	assert(out_visible.size() >= m_count);
+	auto ret = std::size_t{};
+	for (std::size_t i = 0; i < m_count; ++i) {
+		auto const visible = frustum.intersects(Sphere{.centre = {m_x[i], m_y[i], m_z[i]}, .radius = m_radius[i]});
+		out_visible[i] = visible ? 1 : 0;
+		if (visible) { ++ret; }
+	}
+	return ret;
+}
+} // namespace le::graphics
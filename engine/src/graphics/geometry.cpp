@@ -497,4 +497,12 @@ auto graphics::make_manipulator(float stalk_diam, float stalk_height, std::uint3
 	x.append(z.vertices, z.indices);
 	return x;
 }
+
+auto graphics::skin_vertex(Vertex vertex, Bone const& bone, std::span<glm::mat4 const> joints) -> Vertex {
+	auto const skin_mat = bone.weight.x * joints[bone.joint.x] + bone.weight.y * joints[bone.joint.y] + bone.weight.z * joints[bone.joint.z] +
+						  bone.weight.w * joints[bone.joint.w];
+	vertex.position = glm::vec3{skin_mat * glm::vec4{vertex.position, 1.0f}};
+	vertex.normal = glm::normalize(glm::vec3{skin_mat * glm::vec4{vertex.normal, 0.0f}});
+	return vertex;
+}
 } // namespace le
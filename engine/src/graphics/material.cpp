@@ -1,7 +1,18 @@
 #include <le/graphics/descriptor_updater.hpp>
 #include <le/graphics/material.hpp>
+#include <le/graphics/material_table.hpp>
 
 namespace le::graphics {
+namespace {
+auto to_std140(LitMaterial const& material) -> LitMaterial::Std140 {
+	return LitMaterial::Std140{
+		.albedo = Rgba::to_linear(material.albedo.to_vec4()),
+		.m_r_aco_am = {material.metallic, material.roughness, 0.0f, std::bit_cast<float>(material.alpha_mode)},
+		.emissive = Rgba::to_linear({material.emissive_factor, 1.0f}),
+	};
+}
+} // namespace
+
 auto Material::or_default(Ptr<Material const> material) -> Material const& {
 	static auto const ret = UnlitMaterial{};
 	return material != nullptr ? *material : ret;
@@ -12,13 +23,17 @@ auto UnlitMaterial::bind_set(vk::CommandBuffer const cmd) const -> void {
 	DescriptorUpdater{layout.set}.update_texture(layout.textures[0], Fallback::self().or_white(texture)).bind_set(cmd);
 }
 
+auto UnlitMaterial::push_to(MaterialTable& table) const -> std::optional<std::uint32_t> {
+	if (!uses_bindless()) { return {}; }
+	if (auto const ret = table.find(*this)) { return ret; }
+	auto const index = table.texture_index(Fallback::self().or_white(texture));
+	if (!index) { return {}; }
+	return table.push(*this, MaterialTable::Std430{.albedo = glm::vec4{1.0f}, .textures = {*index, 0u, 0u, 0u}});
+}
+
 auto LitMaterial::bind_set(vk::CommandBuffer const cmd) const -> void {
 	auto const& layout = PipelineCache::self().shader_layout().material;
-	auto const data = Std140{
-		.albedo = Rgba::to_linear(albedo.to_vec4()),
-		.m_r_aco_am = {metallic, roughness, 0.0f, std::bit_cast<float>(alpha_mode)},
-		.emissive = Rgba::to_linear({emissive_factor, 1.0f}),
-	};
+	auto const data = to_std140(*this);
 	DescriptorUpdater{layout.set}
 		.write_uniform(layout.data, &data, sizeof(data))
 		.update_texture(layout.textures[0], Fallback::self().or_white(base_colour))
@@ -26,4 +41,21 @@ auto LitMaterial::bind_set(vk::CommandBuffer const cmd) const -> void {
 		.update_texture(layout.textures[2], Fallback::self().or_black(emissive))
 		.bind_set(cmd);
 }
+
+auto LitMaterial::push_to(MaterialTable& table) const -> std::optional<std::uint32_t> {
+	if (!uses_bindless()) { return {}; }
+	if (auto const ret = table.find(*this)) { return ret; }
+	auto const base = table.texture_index(Fallback::self().or_white(base_colour));
+	auto const mr = table.texture_index(Fallback::self().or_white(metallic_roughness));
+	auto const em = table.texture_index(Fallback::self().or_black(emissive));
+	if (!base || !mr || !em) { return {}; }
+	auto const data = to_std140(*this);
+	auto const params = MaterialTable::Std430{
+		.albedo = data.albedo,
+		.m_r_aco_am = data.m_r_aco_am,
+		.emissive = data.emissive,
+		.textures = {*base, *mr, *em, 0u},
+	};
+	return table.push(*this, params);
+}
 } // namespace le::graphics
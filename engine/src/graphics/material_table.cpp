@@ -0,0 +1,189 @@
+#include <le/core/hash_combine.hpp>
+#include <le/core/zip_ranges.hpp>
+#include <le/error.hpp>
+#include <le/graphics/cache/sampler_cache.hpp>
+#include <le/graphics/defer.hpp>
+#include <le/graphics/descriptor_updater.hpp>
+#include <le/graphics/device.hpp>
+#include <le/graphics/material_table.hpp>
+#include <le/graphics/renderer.hpp>
+#include <vulkan/vulkan_hash.hpp>
+#include <cstring>
+#include <utility>
+
+namespace le::graphics {
+auto MaterialTable::TextureHasher::operator()(TextureKey const& key) const -> std::size_t { return make_combined_hash(key.image_serial, key.sampler); }
+
+auto MaterialTable::MaterialHasher::operator()(Ptr<Material const> material) const -> std::uint64_t {
+	return hash_mix(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(material))); // NOLINT
+}
+
+MaterialTable::MaterialTable() {
+	if (!Device::self().get_info().bindless) { throw Error{"Bindless descriptors not supported by Device"}; }
+	for (auto& frame : m_frames) {
+		frame.params = std::make_unique<HostBuffer>(vk::BufferUsageFlagBits::eStorageBuffer, m_material_capacity * sizeof(Std430));
+	}
+	create_sets();
+}
+
+auto MaterialTable::texture_index(Texture const& texture) -> std::optional<std::uint32_t> {
+	auto const sampler = SamplerCache::self().get(texture.sampler);
+	if (!sampler) { return {}; }
+	auto const key = TextureKey{.image_serial = texture.image().serial(), .sampler = sampler};
+	if (auto const it = m_textures.find(key); it != m_textures.end()) {
+		m_slots[it->second].last_used = m_frame_count;
+		return it->second;
+	}
+
+	auto const ret = allocate_slot();
+	if (!ret) {
+		++m_stats.overflows;
+		return {};
+	}
+	m_slots[*ret] = Slot{.key = key, .last_used = m_frame_count};
+	m_textures.insert_or_assign(key, *ret);
+
+	// the slot is not referenced by any pending command buffer: safe to write into every frame's set (eUpdateUnusedWhilePending).
+	auto const& layout = PipelineCache::self().shader_layout().material_table;
+	auto const dii = vk::DescriptorImageInfo{sampler, texture.image().image_view(), vk::ImageLayout::eReadOnlyOptimal};
+	auto writes = Buffered<vk::WriteDescriptorSet>{};
+	for (auto [frame, wds] : zip_ranges(m_frames, writes)) {
+		wds.dstSet = frame.descriptor_set;
+		wds.dstBinding = layout.textures;
+		wds.dstArrayElement = *ret;
+		wds.descriptorCount = 1;
+		wds.descriptorType = vk::DescriptorType::eCombinedImageSampler;
+		wds.pImageInfo = &dii;
+	}
+	Device::self().get_device().updateDescriptorSets(writes, {});
+	++m_stats.texture_writes;
+	return ret;
+}
+
+auto MaterialTable::find(Material const& material) const -> std::optional<std::uint32_t> {
+	auto const& frame = m_frames[Renderer::self().get_frame_index()];
+	if (auto const* ret = frame.materials.find(&material)) { return *ret; }
+	return {};
+}
+
+auto MaterialTable::push(Material const& material, Std430 const& params) -> std::optional<std::uint32_t> {
+	auto& frame = m_frames[Renderer::self().get_frame_index()];
+	auto const ret = static_cast<std::uint32_t>(frame.materials.size());
+	if ((ret + 1) * sizeof(Std430) > frame.params->capacity()) {
+		++m_stats.overflows;
+		return {};
+	}
+	std::memcpy(static_cast<std::byte*>(frame.params->mapped()) + ret * sizeof(Std430), &params, sizeof(Std430)); // NOLINT
+	frame.materials.insert_or_assign(&material, ret);
+	++m_stats.materials;
+	return ret;
+}
+
+auto MaterialTable::bind_set(vk::CommandBuffer const cmd) const -> void {
+	auto const& layout = PipelineCache::self().shader_layout().material_table;
+	DescriptorUpdater::bind_set(layout.set, m_frames[Renderer::self().get_frame_index()].descriptor_set, cmd);
+}
+
+auto MaterialTable::bind_material(std::uint32_t const index, vk::CommandBuffer const cmd) -> void {
+	cmd.pushConstants(PipelineCache::self().pipeline_layout(), vk::ShaderStageFlagBits::eFragment, 0, sizeof(index), &index);
+}
+
+auto MaterialTable::get_stats() const -> Stats {
+	auto ret = m_last_stats;
+	ret.textures = static_cast<std::uint32_t>(m_textures.size());
+	return ret;
+}
+
+auto MaterialTable::next_frame() -> void {
+	++m_frame_count;
+	// grow parameter buffers (one frame at a time, as their previous contents are no longer in use) if the last frame overflowed.
+	if (m_stats.overflows > 0 && m_stats.materials >= m_material_capacity) { m_material_capacity *= 2; }
+	m_last_stats = std::exchange(m_stats, {});
+
+	auto const set_layouts = PipelineCache::self().descriptor_set_layouts();
+	auto const& layout = PipelineCache::self().shader_layout().material_table;
+	if (layout.set < set_layouts.size() && set_layouts[layout.set] != m_layout) {
+		// shader layout changed: the texture array must be repopulated.
+		create_sets();
+		return;
+	}
+
+	auto& frame = m_frames[Renderer::self().get_frame_index()];
+	frame.materials.clear();
+	if (frame.params->capacity() < m_material_capacity * sizeof(Std430)) {
+		frame.params->resize(m_material_capacity * sizeof(Std430));
+		write_params_descriptor(frame);
+	}
+}
+
+auto MaterialTable::create_sets() -> void {
+	auto const set_layouts = PipelineCache::self().descriptor_set_layouts();
+	auto const& layout = PipelineCache::self().shader_layout().material_table;
+	if (layout.set >= set_layouts.size()) { throw Error{"MaterialTable set number out of range"}; }
+	m_layout = set_layouts[layout.set];
+
+	// sets from the previous pool may still be in use by frames in flight.
+	if (m_pool) { DeferQueue::self().push(std::move(m_pool)); }
+	auto const pool_sizes = std::array{
+		vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler, layout.texture_capacity * static_cast<std::uint32_t>(buffering_v)},
+		vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer, static_cast<std::uint32_t>(buffering_v)},
+	};
+	auto dpci = vk::DescriptorPoolCreateInfo{};
+	dpci.flags = vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind;
+	dpci.maxSets = static_cast<std::uint32_t>(buffering_v);
+	dpci.poolSizeCount = static_cast<std::uint32_t>(pool_sizes.size());
+	dpci.pPoolSizes = pool_sizes.data();
+	auto const device = Device::self().get_device();
+	m_pool = device.createDescriptorPoolUnique(dpci);
+
+	auto layouts = Buffered<vk::DescriptorSetLayout>{};
+	layouts.fill(m_layout);
+	auto dsai = vk::DescriptorSetAllocateInfo{};
+	dsai.descriptorPool = *m_pool;
+	dsai.descriptorSetCount = static_cast<std::uint32_t>(layouts.size());
+	dsai.pSetLayouts = layouts.data();
+	auto sets = Buffered<vk::DescriptorSet>{};
+	if (device.allocateDescriptorSets(&dsai, sets.data()) != vk::Result::eSuccess) { throw Error{"Failed to allocate MaterialTable Descriptor Sets"}; }
+
+	for (auto [frame, set] : zip_ranges(m_frames, sets)) {
+		frame.descriptor_set = set;
+		frame.materials.clear();
+		write_params_descriptor(frame);
+	}
+	m_textures.clear();
+	m_slots.clear();
+	m_free.clear();
+	m_slots.reserve(layout.texture_capacity);
+}
+
+auto MaterialTable::allocate_slot() -> std::optional<std::uint32_t> {
+	auto const capacity = PipelineCache::self().shader_layout().material_table.texture_capacity;
+	if (m_free.empty() && m_slots.size() < capacity) {
+		m_slots.emplace_back();
+		return static_cast<std::uint32_t>(m_slots.size() - 1);
+	}
+	if (m_free.empty()) {
+		// recycle slots not referenced by any frame in flight.
+		for (std::size_t i = 0; i < m_slots.size(); ++i) {
+			if (m_slots[i].last_used + buffering_v > m_frame_count || m_textures.erase(m_slots[i].key) == 0) { continue; }
+			m_free.push_back(static_cast<std::uint32_t>(i));
+		}
+	}
+	if (m_free.empty()) { return {}; }
+	auto const ret = m_free.back();
+	m_free.pop_back();
+	return ret;
+}
+
+auto MaterialTable::write_params_descriptor(Frame const& frame) const -> void {
+	auto const& layout = PipelineCache::self().shader_layout().material_table;
+	auto const dbi = vk::DescriptorBufferInfo{frame.params->buffer(), 0, frame.params->capacity()};
+	auto wds = vk::WriteDescriptorSet{};
+	wds.dstSet = frame.descriptor_set;
+	wds.dstBinding = layout.params;
+	wds.descriptorCount = 1;
+	wds.descriptorType = vk::DescriptorType::eStorageBuffer;
+	wds.pBufferInfo = &dbi;
+	Device::self().get_device().updateDescriptorSets(wds, {});
+}
+} // namespace le::graphics
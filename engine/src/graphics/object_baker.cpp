@@ -0,0 +1,144 @@
+#include <le/core/hash_combine.hpp>
+#include <le/graphics/object_baker.hpp>
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+namespace le::graphics {
+namespace {
+constexpr auto align_up(std::size_t const value, std::size_t const alignment) -> std::size_t { return (value + alignment - 1) & ~(alignment - 1); }
+
+constexpr auto instance_count(RenderObject const& object) -> std::size_t { return object.instances.empty() ? std::size_t{1} : object.instances.size(); }
+
+auto const default_instance_v{RenderInstance{}};
+} // namespace
+
+auto ObjectBaker::Hasher::operator()(Key const& key) const -> std::size_t {
+	auto const& state = key.pipeline_state;
+	return make_combined_hash(key.material, key.primitive, state.topology, state.depth_compare, state.depth_test_write, state.line_width, key.layer,
+							  key.passes);
+}
+
+auto ObjectBaker::is_batchable(RenderObject const& object) -> bool {
+	// draw order only matters for blended or non depth-writing objects.
+	return object.joints.empty() && !Material::or_default(object.material).is_transparent() && object.pipeline_state.depth_test_write == vk::True;
+}
+
+auto ObjectBaker::set_alignment(std::size_t const alignment) -> void {
+	assert(std::has_single_bit(alignment));
+	m_alignment = std::max(alignment, alignof(Std430Instance));
+}
+
+auto ObjectBaker::clear() -> void {
+	m_entries.clear();
+	m_objects.clear();
+	m_size = {};
+}
+
+auto ObjectBaker::push(std::span<RenderObject const> objects, PassMask const passes) -> std::size_t {
+	m_pointers.clear();
+	m_pointers.reserve(objects.size());
+	for (auto const& object : objects) { m_pointers.push_back(&object); }
+	m_passes.assign(objects.size(), passes);
+	return push(m_pointers, m_passes);
+}
+
+auto ObjectBaker::push(std::span<Ptr<RenderObject const> const> objects, std::span<PassMask const> passes) -> std::size_t {
+	static constexpr auto npos_v = std::size_t(-1);
+	assert(passes.size() >= objects.size());
+
+	auto group_count = std::size_t{};
+	auto const add_group = [&](Key const& key) -> std::size_t {
+		if (group_count >= m_groups.size()) { m_groups.emplace_back(); }
+		auto& group = m_groups[group_count];
+		group.key = key;
+		group.objects.clear();
+		return group_count++;
+	};
+
+	m_batches.clear();
+	auto previous = npos_v;
+	for (std::size_t i = 0; i < objects.size(); ++i) {
+		auto const& object = *objects[i];
+		// recompute dirty instance matrices here: write() may run concurrently over objects sharing the same instances.
+		for (auto const& instance : object.instances) { [[maybe_unused]] auto const& matrix = instance.transform.matrix(); }
+		auto const key = Key{
+			.material = object.material,
+			.primitive = object.primitive,
+			.pipeline_state = object.pipeline_state,
+			.layer = object.layer,
+			.passes = passes[i],
+		};
+		auto group = npos_v;
+		if (!batching || !object.joints.empty()) {
+			group = add_group(key);
+			m_groups[group].objects.push_back(&object);
+			previous = npos_v;
+			continue;
+		}
+		if (is_batchable(object)) {
+			auto const [it, inserted] = m_batches.try_emplace(key, group_count);
+			group = inserted ? add_group(key) : it->second;
+		} else if (previous != npos_v && m_groups[previous].key == key) {
+			group = previous;
+		} else {
+			group = add_group(key);
+		}
+		m_groups[group].objects.push_back(&object);
+		previous = group;
+	}
+
+	m_entries.reserve(m_entries.size() + group_count);
+	m_objects.reserve(m_objects.size() + objects.size());
+	for (auto const& group : std::span{m_groups}.first(group_count)) {
+		auto const& object = *group.objects.front();
+		auto entry = Entry{.object = &object, .objects = {.offset = m_objects.size(), .size = group.objects.size()}, .passes = group.key.passes};
+		auto count = std::size_t{};
+		for (auto const member : group.objects) {
+			count += instance_count(*member);
+			m_objects.push_back(member);
+		}
+		entry.instance_count = static_cast<std::uint32_t>(count);
+		entry.instances = allocate(count * sizeof(Std430Instance));
+		if (!object.joints.empty()) { entry.joints = allocate(object.joints.size_bytes()); }
+		m_entries.push_back(entry);
+	}
+
+	return group_count;
+}
+
+auto ObjectBaker::write(std::span<std::byte> out, std::size_t const first, std::size_t const last) const -> void {
+	assert(out.size() >= m_size && first <= last && last <= m_entries.size());
+	for (auto const& entry : std::span{m_entries}.subspan(first, last - first)) {
+		auto* dst = out.subspan(entry.instances.offset, entry.instances.size).data();
+		for (auto const object : std::span{m_objects}.subspan(entry.objects.offset, entry.objects.size)) {
+			auto const instances = object->instances.empty() ? std::span{&default_instance_v, 1} : object->instances;
+			for (auto const& instance : instances) {
+				auto const std430 = Std430Instance{
+					.transform = object->parent * instance.transform.matrix(),
+					.tint = Rgba::to_linear(instance.tint.to_tint()),
+				};
+				std::memcpy(dst, &std430, sizeof(std430));
+				dst += sizeof(std430); // NOLINT
+			}
+		}
+		if (entry.joints.size > 0) { std::memcpy(out.subspan(entry.joints.offset).data(), entry.object->joints.data(), entry.joints.size); }
+	}
+}
+
+auto ObjectBaker::write(std::span<std::byte> out, Ptr<ThreadPool> pool) const -> void {
+	if (pool == nullptr) {
+		write(out, 0, m_entries.size());
+		return;
+	}
+	auto const write_chunk = [this, out](std::size_t const first, std::size_t const last) { write(out, first, last); };
+	pool->for_each_chunk(m_entries.size(), write_chunk, min_chunk);
+}
+
+auto ObjectBaker::allocate(std::size_t const size) -> Range {
+	auto const ret = Range{.offset = align_up(m_size, m_alignment), .size = size};
+	m_size = ret.offset + ret.size;
+	return ret;
+}
+} // namespace le::graphics
@@ -1,59 +1,124 @@
-#include <le/core/nvec3.hpp>
-#include <le/core/random.hpp>
+#include <glm/gtc/constants.hpp>
 #include <le/core/visitor.hpp>
-#include <le/core/zip_ranges.hpp>
 #include <le/graphics/device.hpp>
 #include <le/graphics/particle.hpp>
 #include <algorithm>
+#include <array>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LE_PARTICLE_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace le::graphics {
 namespace {
-auto random_vec3(InclusiveRange<glm::vec3> const& range) -> glm::vec3 {
-	auto ret = glm::vec3{};
-	ret.x = random_range(range.lo.x, range.hi.x);
-	ret.y = random_range(range.lo.y, range.hi.y);
-	ret.z = random_range(range.lo.z, range.hi.z);
+constexpr auto two_pi_v = 2.0f * glm::pi<float>();
+
+// rotations are kept in [-pi, pi]: half angles stay within the range where the polynomials below are accurate.
+auto wrap_angle(float const rad) -> float { return rad - two_pi_v * std::nearbyint(rad / two_pi_v); }
+
+// Taylor series coefficients in x^2 for x in [-pi/2, pi/2] (max error ~6e-8): sin(x) = x * poly(x^2), cos(x) = poly(x^2).
+constexpr auto sin_coefficients_v = std::array{1.0f, -1.0f / 6.0f, 1.0f / 120.0f, -1.0f / 5040.0f, 1.0f / 362880.0f, -1.0f / 39916800.0f};
+constexpr auto cos_coefficients_v =
+	std::array{1.0f, -1.0f / 2.0f, 1.0f / 24.0f, -1.0f / 720.0f, 1.0f / 40320.0f, -1.0f / 3628800.0f, 1.0f / 479001600.0f};
+
+// Horner's method, highest power first.
+template <std::size_t Size>
+auto poly(float const x2, std::array<float, Size> const& coefficients) -> float {
+	auto ret = 0.0f;
+	for (auto it = coefficients.rbegin(); it != coefficients.rend(); ++it) { ret = *it + x2 * ret; }
 	return ret;
 }
 
-auto translate(Particle& out, Duration dt) -> void { out.position += out.velocity.linear * dt.count(); }
-auto rotate(Particle& out, Duration dt) -> void { out.rotation.value += out.velocity.angular.value * dt.count(); }
-auto scaleify(Particle& out) -> void { out.scale = glm::mix(out.lerp.scale.lo, out.lerp.scale.hi, out.alpha); }
-auto tintify(Particle& out) -> void { out.tint.channels = glm::mix(out.lerp.tint.lo.channels, out.lerp.tint.hi.channels, out.alpha); }
-} // namespace
-
-auto Particle::Emitter::make_particle() const -> Particle {
-	auto ret = Particle{};
+#if defined(LE_PARTICLE_SSE2)
+template <std::size_t Size>
+auto poly(__m128 const x2, std::array<float, Size> const& coefficients) -> __m128 {
+	auto ret = _mm_setzero_ps();
+	for (auto it = coefficients.rbegin(); it != coefficients.rend(); ++it) { ret = _mm_add_ps(_mm_set1_ps(*it), _mm_mul_ps(x2, ret)); }
+	return ret;
+}
+#endif
 
-	auto const spread = Degrees{random_range(config.velocity.linear.angle.lo.value, config.velocity.linear.angle.hi.value)};
-	auto const direction = glm::vec3{glm::sin(spread), glm::cos(spread), 0.0f};
-	ret.velocity.linear = random_range(config.velocity.linear.speed.lo, config.velocity.linear.speed.hi) * direction;
-	ret.velocity.angular = random_range(config.velocity.angular.lo.value, config.velocity.angular.hi.value);
+auto lerp_tint(glm::vec4 const& lo, glm::vec4 const& hi, float const alpha) -> Rgba {
+	auto const channels = lo * (1.0f - alpha) + hi * alpha;
+	return Rgba{.channels = glm::tvec4<std::uint8_t>{channels}};
+}
+} // namespace
 
-	ret.lerp.scale = config.lerp.scale;
-	ret.lerp.tint = config.lerp.tint;
+struct Particle::Emitter::Step {
+	// zero if the corresponding modifier is disabled.
+	float translate{};
+	float rotate{};
+	float elapsed{};
+	// view inverse: billboards each quad.
+	glm::quat view{};
+	InclusiveRange<glm::vec2> scale{};
+	InclusiveRange<glm::vec4> tint{};
+};
 
-	auto const initial_position = [&] {
-		auto ret = config.initial.position;
-		if (std::abs(ret.lo.z - ret.hi.z) < 0.01f) {
-			// minimize z fighting
-			ret.hi.z = ret.lo.z + 0.1f;
+auto Particle::Emitter::prepare(glm::quat const& view, Duration const dt) -> Step {
+	auto& ttl = m_particles[Field::eTtl];
+	auto& elapsed = m_particles[Field::eElapsed];
+	for (std::size_t i = 0; i < ttl.size();) {
+		if (elapsed[i] >= ttl[i]) {
+			swap_remove(i);
+		} else {
+			++i;
 		}
-		return ret;
-	}();
-	ret.position = random_vec3(initial_position);
-	ret.rotation = random_range(config.initial.rotation.lo.value, config.initial.rotation.hi.value);
-	ret.scale = config.lerp.scale.lo;
+	}
 
-	ret.ttl = Duration{random_range(config.ttl.lo.count(), config.ttl.hi.count())};
-	ret.tint = ret.lerp.tint.lo;
+	if (config.respawn) {
+		for (auto& field : m_particles.values) { field.reserve(config.count); }
+		while (active_particles() < config.count) { spawn(); }
+	}
 
+	m_instances.resize(active_particles());
+
+	auto ret = Step{
+		.elapsed = dt.count(),
+		.view = glm::inverse(view),
+		.scale = config.lerp.scale,
+		.tint = {glm::vec4{config.lerp.tint.lo.channels}, glm::vec4{config.lerp.tint.hi.channels}},
+	};
+	if ((modifiers & eTranslate) != 0) { ret.translate = dt.count(); }
+	if ((modifiers & eRotate) != 0) { ret.rotate = dt.count(); }
+	if ((modifiers & eScale) == 0) { ret.scale.hi = ret.scale.lo; }
+	if ((modifiers & eTint) == 0) { ret.tint.hi = ret.tint.lo; }
 	return ret;
 }
 
+auto Particle::Emitter::spawn() -> void {
+	auto const spread = m_random.in_range(config.velocity.linear.angle.lo, config.velocity.linear.angle.hi);
+	auto const speed = m_random.in_range(config.velocity.linear.speed.lo, config.velocity.linear.speed.hi);
+	m_particles[Field::eVx].push_back(speed * std::sin(spread));
+	m_particles[Field::eVy].push_back(speed * std::cos(spread));
+	m_particles[Field::eVz].push_back(0.0f);
+	m_particles[Field::eAngular].push_back(m_random.in_range(config.velocity.angular.lo, config.velocity.angular.hi));
+
+	auto position = config.initial.position;
+	if (std::abs(position.lo.z - position.hi.z) < 0.01f) {
+		// minimize z fighting
+		position.hi.z = position.lo.z + 0.1f;
+	}
+	m_particles[Field::eX].push_back(m_random.in_range(position.lo.x, position.hi.x));
+	m_particles[Field::eY].push_back(m_random.in_range(position.lo.y, position.hi.y));
+	m_particles[Field::eZ].push_back(m_random.in_range(position.lo.z, position.hi.z));
+	m_particles[Field::eRotation].push_back(wrap_angle(m_random.in_range(config.initial.rotation.lo, config.initial.rotation.hi)));
+
+	m_particles[Field::eTtl].push_back(m_random.in_range(config.ttl.lo.count(), config.ttl.hi.count()));
+	m_particles[Field::eElapsed].push_back(0.0f);
+}
+
+auto Particle::Emitter::swap_remove(std::size_t const index) -> void {
+	for (auto& field : m_particles.values) {
+		field[index] = field.back();
+		field.pop_back();
+	}
+}
+
 void Particle::Emitter::respawn_all(glm::quat const& view) {
-	m_particles.clear();
-	m_particles.reserve(config.count);
+	for (auto& field : m_particles.values) { field.clear(); }
 	auto respawn = config.respawn;
 	config.respawn = true;
 	update(view, {});
@@ -61,35 +126,148 @@ void Particle::Emitter::respawn_all(glm::quat const& view) {
 }
 
 void Particle::Emitter::update(glm::quat const& view, Duration dt) {
-	std::erase_if(m_particles, [](Particle const& p) { return p.elapsed >= p.ttl; });
+	auto const step = prepare(view, dt);
+	integrate(step, 0, active_particles());
+}
 
-	if (config.respawn) {
-		m_particles.reserve(config.count);
-		while (m_particles.size() < config.count) { m_particles.push_back(make_particle()); }
-	}
+void Particle::Emitter::update_scalar(glm::quat const& view, Duration dt) {
+	auto const step = prepare(view, dt);
+	integrate_scalar(step, 0, active_particles());
+}
+
+auto Particle::Emitter::integrate(Step const& step, std::size_t first, std::size_t const last) -> void {
+#if defined(LE_PARTICLE_SSE2)
+	auto* x = m_particles[Field::eX].data();
+	auto* y = m_particles[Field::eY].data();
+	auto* z = m_particles[Field::eZ].data();
+	auto const* vx = m_particles[Field::eVx].data();
+	auto const* vy = m_particles[Field::eVy].data();
+	auto const* vz = m_particles[Field::eVz].data();
+	auto* rotation = m_particles[Field::eRotation].data();
+	auto const* angular = m_particles[Field::eAngular].data();
+	auto* elapsed = m_particles[Field::eElapsed].data();
+	auto const* ttl = m_particles[Field::eTtl].data();
+
+	auto const translate = _mm_set1_ps(step.translate);
+	auto const rotate = _mm_set1_ps(step.rotate);
+	auto const dt = _mm_set1_ps(step.elapsed);
+	auto const zero = _mm_setzero_ps();
+	auto const one = _mm_set1_ps(1.0f);
+	auto const half = _mm_set1_ps(0.5f);
+	auto const two_pi = _mm_set1_ps(two_pi_v);
+	auto const view_w = _mm_set1_ps(step.view.w);
+	auto const view_x = _mm_set1_ps(step.view.x);
+	auto const view_y = _mm_set1_ps(step.view.y);
+	auto const view_z = _mm_set1_ps(step.view.z);
+	auto const scale_lo_x = _mm_set1_ps(step.scale.lo.x);
+	auto const scale_lo_y = _mm_set1_ps(step.scale.lo.y);
+	auto const scale_hi_x = _mm_set1_ps(step.scale.hi.x);
+	auto const scale_hi_y = _mm_set1_ps(step.scale.hi.y);
+	auto const tint_lo = _mm_loadu_ps(&step.tint.lo.x);
+	auto const tint_hi = _mm_loadu_ps(&step.tint.hi.x);
+
+	for (; first + 4 <= last; first += 4) {
+		auto px = _mm_loadu_ps(x + first); // NOLINT
+		auto py = _mm_loadu_ps(y + first); // NOLINT
+		auto pz = _mm_loadu_ps(z + first); // NOLINT
+		px = _mm_add_ps(px, _mm_mul_ps(_mm_loadu_ps(vx + first), translate)); // NOLINT
+		py = _mm_add_ps(py, _mm_mul_ps(_mm_loadu_ps(vy + first), translate)); // NOLINT
+		pz = _mm_add_ps(pz, _mm_mul_ps(_mm_loadu_ps(vz + first), translate)); // NOLINT
+		_mm_storeu_ps(x + first, px);										   // NOLINT
+		_mm_storeu_ps(y + first, py);										   // NOLINT
+		_mm_storeu_ps(z + first, pz);										   // NOLINT
 
-	m_instances.resize(m_particles.size());
-
-	// invert view to billboard each quad
-	auto const view_inverse = glm::inverse(view);
-	for (auto [particle, instance] : zip_ranges(m_particles, m_instances)) {
-		particle.elapsed += dt;
-		particle.alpha = std::clamp(particle.elapsed / particle.ttl, 0.0f, 1.0f);
-		if ((modifiers & eTranslate) != 0) { translate(particle, dt); }
-		if ((modifiers & eRotate) != 0) { rotate(particle, dt); }
-		if ((modifiers & eScale) != 0) { scaleify(particle); }
-		if ((modifiers & eTint) != 0) { tintify(particle); }
-		auto const orientation = view_inverse * glm::rotate(glm::identity<glm::quat>(), particle.rotation.value, front_v);
-		instance.transform.set_orientation(orientation);
-		instance.transform.set_position(particle.position);
-		instance.transform.set_scale(glm::vec3{particle.scale, 1.0f});
-		instance.tint = particle.tint;
+		auto rad = _mm_add_ps(_mm_loadu_ps(rotation + first), _mm_mul_ps(_mm_loadu_ps(angular + first), rotate)); // NOLINT
+		// cvtps rounds to nearest (even), matching std::nearbyint in the default rounding mode.
+		rad = _mm_sub_ps(rad, _mm_mul_ps(two_pi, _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_div_ps(rad, two_pi)))));
+		_mm_storeu_ps(rotation + first, rad); // NOLINT
+
+		auto const time = _mm_add_ps(_mm_loadu_ps(elapsed + first), dt); // NOLINT
+		_mm_storeu_ps(elapsed + first, time);							  // NOLINT
+		auto const alpha = _mm_min_ps(_mm_max_ps(_mm_div_ps(time, _mm_loadu_ps(ttl + first)), zero), one); // NOLINT
+		auto const beta = _mm_sub_ps(one, alpha);
+
+		// orientation = view * angleAxis(rad, front_v)
+		auto const h = _mm_mul_ps(rad, half);
+		auto const h2 = _mm_mul_ps(h, h);
+		auto const s = _mm_mul_ps(h, poly(h2, sin_coefficients_v));
+		auto const c = poly(h2, cos_coefficients_v);
+
+		alignas(16) float qw[4]{};
+		alignas(16) float qx[4]{};
+		alignas(16) float qy[4]{};
+		alignas(16) float qz[4]{};
+		alignas(16) float sx[4]{};
+		alignas(16) float sy[4]{};
+		alignas(16) float a[4]{};
+		alignas(16) float b[4]{};
+		_mm_store_ps(qw, _mm_sub_ps(_mm_mul_ps(view_w, c), _mm_mul_ps(view_z, s)));
+		_mm_store_ps(qx, _mm_add_ps(_mm_mul_ps(view_x, c), _mm_mul_ps(view_y, s)));
+		_mm_store_ps(qy, _mm_sub_ps(_mm_mul_ps(view_y, c), _mm_mul_ps(view_x, s)));
+		_mm_store_ps(qz, _mm_add_ps(_mm_mul_ps(view_z, c), _mm_mul_ps(view_w, s)));
+		_mm_store_ps(sx, _mm_add_ps(_mm_mul_ps(scale_lo_x, beta), _mm_mul_ps(scale_hi_x, alpha)));
+		_mm_store_ps(sy, _mm_add_ps(_mm_mul_ps(scale_lo_y, beta), _mm_mul_ps(scale_hi_y, alpha)));
+		_mm_store_ps(a, alpha);
+		_mm_store_ps(b, beta);
+		alignas(16) float positions[3][4]{};
+		_mm_store_ps(positions[0], px);
+		_mm_store_ps(positions[1], py);
+		_mm_store_ps(positions[2], pz);
+
+		for (std::size_t lane = 0; lane < 4; ++lane) {
+			auto& instance = m_instances[first + lane];
+			instance.transform.set_data({
+				.position = {positions[0][lane], positions[1][lane], positions[2][lane]},
+				.orientation = glm::quat{qw[lane], qx[lane], qy[lane], qz[lane]},
+				.scale = {sx[lane], sy[lane], 1.0f},
+			});
+			// lerp and truncate all four channels at once, like the scalar path.
+			auto const channels = _mm_add_ps(_mm_mul_ps(tint_lo, _mm_set1_ps(b[lane])), _mm_mul_ps(tint_hi, _mm_set1_ps(a[lane])));
+			alignas(16) std::int32_t tint[4]{};
+			_mm_store_si128(reinterpret_cast<__m128i*>(tint), _mm_cvttps_epi32(channels)); // NOLINT
+			for (glm::length_t channel = 0; channel < 4; ++channel) { instance.tint.channels[channel] = static_cast<std::uint8_t>(tint[channel]); } // NOLINT
+		}
 	}
+#endif
+	integrate_scalar(step, first, last);
+}
+
+auto Particle::Emitter::integrate_scalar(Step const& step, std::size_t const first, std::size_t const last) -> void {
+	auto& x = m_particles[Field::eX];
+	auto& y = m_particles[Field::eY];
+	auto& z = m_particles[Field::eZ];
+	auto& rotation = m_particles[Field::eRotation];
+	auto& elapsed = m_particles[Field::eElapsed];
+	for (std::size_t i = first; i < last; ++i) {
+		x[i] += m_particles[Field::eVx][i] * step.translate;
+		y[i] += m_particles[Field::eVy][i] * step.translate;
+		z[i] += m_particles[Field::eVz][i] * step.translate;
+		rotation[i] = wrap_angle(rotation[i] + m_particles[Field::eAngular][i] * step.rotate);
+		elapsed[i] += step.elapsed;
+		auto const alpha = std::clamp(elapsed[i] / m_particles[Field::eTtl][i], 0.0f, 1.0f);
+		auto const beta = 1.0f - alpha;
 
-	m_primitive->set_geometry(Geometry::from(Quad{.size = config.quad_size}));
+		// orientation = view * angleAxis(rotation, front_v)
+		auto const h = rotation[i] * 0.5f;
+		auto const s = h * poly(h * h, sin_coefficients_v);
+		auto const c = poly(h * h, cos_coefficients_v);
+		auto const& v = step.view;
+		auto& instance = m_instances[i];
+		instance.transform.set_data({
+			.position = {x[i], y[i], z[i]},
+			.orientation = glm::quat{v.w * c - v.z * s, v.x * c + v.y * s, v.y * c - v.x * s, v.z * c + v.w * s},
+			.scale = {step.scale.lo * beta + step.scale.hi * alpha, 1.0f},
+		});
+		instance.tint = lerp_tint(step.tint.lo, step.tint.hi, alpha);
+	}
 }
 
 auto Particle::Emitter::render_object() const -> RenderObject {
+	if (!m_primitive) { m_primitive = std::make_unique<DynamicPrimitive>(); }
+	if (m_quad_size != config.quad_size) {
+		m_primitive->set_geometry(Geometry::from(Quad{.size = config.quad_size}));
+		m_quad_size = config.quad_size;
+	}
 	auto ret = RenderObject{
 		.material = &material,
 		.primitive = m_primitive.get(),
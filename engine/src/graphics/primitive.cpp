@@ -25,7 +25,7 @@ auto write_vertices_indices(Buffer& out, Geometry const& geometry) -> vk::Device
 auto write_bones(std::unique_ptr<DeviceBuffer>& out, Geometry const& geometry) {
 	auto const bones = std::span{geometry.bones};
 	if (!bones.empty()) {
-		if (!out) { out = std::make_unique<DeviceBuffer>(vk::BufferUsageFlagBits::eVertexBuffer, bones.size_bytes()); }
+		if (!out) { out = std::make_unique<DeviceBuffer>(vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eStorageBuffer, bones.size_bytes()); }
 		out->write(bones.data(), bones.size_bytes());
 	} else {
 		out.reset();
@@ -61,8 +61,9 @@ auto StaticPrimitive::set_geometry(Geometry const& geometry) -> void {
 	auto const vibo_size = std::span{geometry.vertices}.size_bytes() + std::span{geometry.indices}.size_bytes();
 
 	if (!m_data.get().vertices_indices || m_data.get().vertices_indices->size() < vibo_size) {
-		m_data.get().vertices_indices =
-			std::make_unique<DeviceBuffer>(vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer, vibo_size);
+		// storage usage: vertices may be read by ComputeSkinning.
+		static constexpr auto usage_v = vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eStorageBuffer;
+		m_data.get().vertices_indices = std::make_unique<DeviceBuffer>(usage_v, vibo_size);
 	}
 
 	m_data.get().index_offset = write_vertices_indices(*m_data.get().vertices_indices, geometry);
@@ -71,6 +72,8 @@ auto StaticPrimitive::set_geometry(Geometry const& geometry) -> void {
 	m_layout.vertex_count = static_cast<std::uint32_t>(geometry.vertices.size());
 	m_layout.index_count = static_cast<std::uint32_t>(geometry.indices.size());
 	m_layout.bone_count = static_cast<std::uint32_t>(geometry.bones.size());
+	m_layout.bounds = Bounds::from(geometry.vertices);
+	++m_generation;
 }
 
 auto StaticPrimitive::draw(std::uint32_t const instances, vk::CommandBuffer const cmd) const -> void {
@@ -84,6 +87,25 @@ auto StaticPrimitive::draw(std::uint32_t const instances, vk::CommandBuffer cons
 	Primitive::draw(buffers, instances, cmd);
 }
 
+auto StaticPrimitive::get_skin_source() const -> SkinSource {
+	if (!m_data.get().vertices_indices || !m_data.get().bones) { return {}; }
+	return SkinSource{
+		.vertices = m_data.get().vertices_indices->buffer(),
+		.bones = m_data.get().bones->buffer(),
+		.generation = m_generation,
+	};
+}
+
+auto StaticPrimitive::draw_skinned(vk::Buffer const skinned_vertices, std::uint32_t const instances, vk::CommandBuffer const cmd) const -> void {
+	if (!m_data.get().vertices_indices) { return; }
+	auto const buffers = Buffers{
+		.vertices = skinned_vertices,
+		.indices = m_data.get().index_offset > 0 ? m_data.get().vertices_indices->buffer() : vk::Buffer{},
+		.index_offset = m_data.get().index_offset,
+	};
+	Primitive::draw(buffers, instances, cmd);
+}
+
 DynamicPrimitive::DynamicPrimitive() { m_vertices_indices = VertexBufferCache::self().allocate(); }
 
 auto DynamicPrimitive::set_geometry(Geometry const& geometry) -> void {
@@ -96,6 +118,7 @@ auto DynamicPrimitive::set_geometry(Geometry&& geometry) -> void {
 
 	m_layout.vertex_count = static_cast<std::uint32_t>(m_geometry.vertices.size());
 	m_layout.index_count = static_cast<std::uint32_t>(m_geometry.indices.size());
+	m_layout.bounds = Bounds::from(m_geometry.vertices);
 }
 
 auto DynamicPrimitive::draw(std::uint32_t instances, vk::CommandBuffer cmd) const -> void {
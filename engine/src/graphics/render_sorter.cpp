@@ -0,0 +1,57 @@
+#include <le/core/hash_combine.hpp>
+#include <le/graphics/render_sorter.hpp>
+#include <algorithm>
+
+namespace le::graphics {
+namespace {
+auto depth_of(RenderObject const& object, glm::vec3 const& eye) -> float {
+	auto const local = object.instances.empty() ? glm::vec3{} : object.instances.front().transform.position();
+	auto const position = glm::vec3{object.parent * glm::vec4{local, 1.0f}};
+	auto const to_object = position - eye;
+	return glm::dot(to_object, to_object);
+}
+} // namespace
+
+auto RenderSorter::make_key(RenderObject const& object, glm::vec3 const& eye, bool const bindless) -> Key {
+	auto const& material = Material::or_default(object.material);
+	auto const& state = object.pipeline_state;
+	auto const& shader = material.get_shader();
+	auto fragment = shader.fragment.hash();
+	// the shader that will be bound (only built for bindless materials).
+	if (bindless && material.uses_bindless()) { fragment = material.get_bindless_shader().fragment.hash(); }
+	auto const depth = depth_of(object, eye);
+	auto ret = Key{
+		.layer = object.layer,
+		.ordered = material.is_transparent() || state.depth_test_write != vk::True ? 1u : 0u,
+		.pipeline = make_combined_hash(shader.vertex.hash(), fragment, state.topology, state.depth_compare, state.depth_test_write),
+		.material = reinterpret_cast<std::uintptr_t>(&material), // NOLINT
+		.primitive = reinterpret_cast<std::uintptr_t>(object.primitive.get()), // NOLINT
+	};
+	if (ret.ordered != 0) {
+		ret.back_to_front = -depth;
+	} else {
+		ret.front_to_back = depth;
+	}
+	return ret;
+}
+
+auto RenderSorter::sort(std::span<RenderObject const> objects, glm::vec3 const& eye) -> std::span<Ptr<RenderObject const> const> {
+	m_sorted.clear();
+	m_sorted.reserve(objects.size());
+	if (mode == Mode::eNone) {
+		for (auto const& object : objects) { m_sorted.push_back(&object); }
+		return m_sorted;
+	}
+
+	m_items.clear();
+	m_items.reserve(objects.size());
+	for (std::size_t i = 0; i < objects.size(); ++i) {
+		auto key = mode == Mode::eLayer ? Key{.layer = objects[i].layer} : make_key(objects[i], eye, bindless);
+		m_items.push_back(Item{.key = key, .index = i});
+	}
+	std::ranges::stable_sort(m_items, [](Item const& a, Item const& b) { return a.key < b.key; });
+
+	for (auto const& item : m_items) { m_sorted.push_back(&objects[item.index]); }
+	return m_sorted;
+}
+} // namespace le::graphics
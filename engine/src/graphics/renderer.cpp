@@ -1,9 +1,12 @@
 #include <impl/frame_profiler.hpp>
 #include <le/core/logger.hpp>
+#include <le/core/profiler.hpp>
 #include <le/graphics/descriptor_updater.hpp>
 #include <le/graphics/device.hpp>
 #include <le/graphics/image_barrier.hpp>
 #include <le/graphics/renderer.hpp>
+#include <le/graphics/upload_queue.hpp>
+#include <array>
 #include <bit>
 
 namespace le::graphics {
@@ -21,6 +24,19 @@ constexpr auto image_extent(vk::SurfaceCapabilitiesKHR const& caps, vk::Extent2D
 	return vk::Extent2D{x, y};
 }
 
+constexpr auto offscreen_format_v{vk::Format::eR8G8B8A8Srgb};
+// frame start, shadow pass end, scene pass end, imgui pass end.
+constexpr std::uint32_t timestamp_count_v{4};
+constexpr auto shadow_fragment_shader_v{"shaders/noop.frag"};
+
+// passes a scene object is drawn in (ObjectBaker::PassMask).
+enum : ObjectBaker::PassMask { eCameraPass = 1 << 0, eShadowPass = 1 << 1 };
+
+// only the stock skinning vertex shader is replaced by compute skinning outputs.
+auto is_compute_skinned(RenderObject const& object) -> bool {
+	return !object.joints.empty() && ComputeSkinning::replaces(Material::or_default(object.material).get_shader().vertex);
+}
+
 auto optimal_depth_format(vk::PhysicalDevice const gpu) -> vk::Format {
 	static constexpr auto target{vk::Format::eD32Sfloat};
 	auto const props = gpu.getFormatProperties(target);
@@ -161,12 +177,19 @@ struct RenderPass { // NOLINT
 	glm::vec2 world_frustum{};
 	vk::PolygonMode polygon_mode{};
 
+	Ptr<MaterialTable> material_table{};
+	// whether draws need material parameters (the shadow pass only writes depth).
+	bool bind_materials{true};
+
 	mutable Ptr<Material const> last_bound{};
+	mutable std::optional<std::uint32_t> last_index{};
 
 	RenderPass(RenderTarget const& render_target, ImageView const& shadow_map, glm::vec2 world_frustum, vk::PolygonMode polygon_mode)
 		: render_target(render_target), shadow_map(shadow_map), world_frustum(world_frustum), polygon_mode(polygon_mode) {}
 
-	virtual auto get_shader(Material const& material) const -> Shader { return material.get_shader(); }
+	virtual auto get_shader(Material const& material, bool const bindless) const -> Shader {
+		return bindless ? material.get_bindless_shader() : material.get_shader();
+	}
 
 	auto render_list(RenderCamera const& camera, std::span<RenderObject::Baked const> list, vk::CommandBuffer cmd) const -> std::uint32_t {
 		if (list.empty()) { return 0; }
@@ -175,28 +198,43 @@ struct RenderPass { // NOLINT
 		auto const& object_layout = PipelineCache::self().shader_layout().object;
 
 		camera.bind_set(world_frustum, shadow_map, cmd);
+		if (material_table != nullptr) { material_table->bind_set(cmd); }
 		auto ret = std::uint32_t{};
 
 		auto& renderer = Renderer::self();
 
 		for (auto const& baked : list) {
-			auto const& material = Material::or_default(baked.object.material);
-			auto shader = get_shader(material);
+			auto const& material = Material::or_default(baked.object->material);
+			auto const material_index = material_table != nullptr ? material.push_to(*material_table) : std::optional<std::uint32_t>{};
+			auto shader = get_shader(material, material_index.has_value());
 			if (!shader) { continue; }
+			if (baked.skinned_vertices) {
+				static auto const skinned_vertex_shader_v = Uri{ComputeSkinning::vertex_shader_v};
+				shader.vertex = skinned_vertex_shader_v;
+			}
 
-			auto const pipeline = PipelineCache::self().load(pipeline_format, std::move(shader), baked.object.pipeline_state, polygon_mode);
+			auto const pipeline = PipelineCache::self().load(pipeline_format, shader, baked.object->pipeline_state, polygon_mode);
 			if (!renderer.bind_pipeline(pipeline)) { continue; }
 
-			cmd.setLineWidth(renderer.get_line_width_limit().clamp(baked.object.pipeline_state.line_width));
+			cmd.setLineWidth(renderer.get_line_width_limit().clamp(baked.object->pipeline_state.line_width));
 
-			if (last_bound != &material) {
+			if (material_index) {
+				if (last_index != material_index) {
+					MaterialTable::bind_material(*material_index, cmd);
+					last_index = material_index;
+				}
+			} else if (bind_materials && last_bound != &material) {
 				material.bind_set(cmd);
 				last_bound = &material;
 			}
 
 			DescriptorUpdater::bind_set(object_layout.set, baked.descriptor_set, cmd);
 
-			baked.object.primitive->draw(baked.instance_count, cmd);
+			if (baked.skinned_vertices) {
+				baked.object->primitive->draw_skinned(baked.skinned_vertices, baked.instance_count, cmd);
+			} else {
+				baked.object->primitive->draw(baked.instance_count, cmd);
+			}
 			++ret;
 		}
 
@@ -205,18 +243,20 @@ struct RenderPass { // NOLINT
 };
 
 struct ShadowPass : RenderPass { // NOLINT
-	ShadowPass(RenderTarget const& render_target, glm::vec2 world_frustum) : RenderPass(render_target, {}, world_frustum, vk::PolygonMode::eFill) {}
+	ShadowPass(RenderTarget const& render_target, glm::vec2 world_frustum) : RenderPass(render_target, {}, world_frustum, vk::PolygonMode::eFill) {
+		bind_materials = false;
+	}
 
-	auto get_shader(Material const& material) const -> Shader final {
+	auto get_shader(Material const& material, bool const /*bindless*/) const -> Shader final {
 		if (!material.cast_shadow()) { return {}; }
-		return Shader{.vertex = material.get_shader().vertex, .fragment = "shaders/noop.frag"};
+		return Shader{.vertex = material.get_shader().vertex, .fragment = shadow_fragment_shader_v};
 	}
 };
 
 auto const g_log{logger::Logger{"Renderer"}};
 } // namespace
 
-auto Renderer::Frame::make(vk::Device const device, std::uint32_t const queue_family, vk::Format depth_format) -> Frame {
+auto Renderer::Frame::make(vk::Device const device, std::uint32_t const queue_family, vk::Format depth_format, bool const headless) -> Frame {
 	auto ret = Frame{};
 
 	auto ici = ImageCreateInfo{
@@ -226,10 +266,20 @@ auto Renderer::Frame::make(vk::Device const device, std::uint32_t const queue_fa
 		.view_type = vk::ImageViewType::e2D,
 		.mip_map = false,
 	};
-	auto const make_depth_image = [&ici] { return std::make_unique<Image>(ici); };
-	fill_buffered(ret.depth_images, make_depth_image);
+	auto const make_image = [&ici] { return std::make_unique<Image>(ici); };
+	fill_buffered(ret.depth_images, make_image);
 	ici.usage |= vk::ImageUsageFlagBits::eSampled;
-	fill_buffered(ret.shadow_maps, make_depth_image);
+	fill_buffered(ret.shadow_maps, make_image);
+
+	if (headless) {
+		ici = ImageCreateInfo{
+			.format = offscreen_format_v,
+			.usage = vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eSampled,
+			.view_type = vk::ImageViewType::e2D,
+			.mip_map = false,
+		};
+		fill_buffered(ret.offscreen_images, make_image);
+	}
 
 	for (auto& sync : ret.syncs) {
 		sync.command_pool = device.createCommandPoolUnique(vk::CommandPoolCreateInfo{vk::CommandPoolCreateFlagBits::eTransient, queue_family});
@@ -242,19 +292,37 @@ auto Renderer::Frame::make(vk::Device const device, std::uint32_t const queue_fa
 	return ret;
 }
 
-Renderer::Renderer(glm::uvec2 const framebuffer_extent) {
+Renderer::Renderer(glm::uvec2 const framebuffer_extent) : m_headless(Device::self().get_info().headless) {
 	auto& device = Device::self();
 
-	m_swapchain.present_modes = device.get_physical_device().getSurfacePresentModesKHR(device.get_surface());
-	m_swapchain.formats = Swapchain::Formats::make(device.get_physical_device().getSurfaceFormatsKHR(device.get_surface()));
-	m_swapchain.create_info = m_swapchain.make_create_info(device.get_surface(), device.get_queue_family());
+	if (m_headless) {
+		// no surface: the swapchain create info only tracks the offscreen format and extent.
+		m_swapchain.create_info.imageFormat = offscreen_format_v;
+	} else {
+		m_swapchain.present_modes = device.get_physical_device().getSurfacePresentModesKHR(device.get_surface());
+		m_swapchain.formats = Swapchain::Formats::make(device.get_physical_device().getSurfaceFormatsKHR(device.get_surface()));
+		m_swapchain.create_info = m_swapchain.make_create_info(device.get_surface(), device.get_queue_family());
+	}
 
 	recreate_swapchain(framebuffer_extent);
 
-	m_frame = Frame::make(device.get_device(), device.get_queue_family(), optimal_depth_format(device.get_physical_device()));
+	m_frame = Frame::make(device.get_device(), device.get_queue_family(), optimal_depth_format(device.get_physical_device()), m_headless);
 
 	auto const line_width_range = device.get_physical_device().getProperties().limits.lineWidthRange;
 	m_line_width_limit = {line_width_range[0], line_width_range[1]};
+
+	m_object_baker.set_alignment(m_scratch_buffer_cache.get_alignment(vk::BufferUsageFlagBits::eStorageBuffer));
+
+	if (auto const valid_bits = device.get_physical_device().getQueueFamilyProperties()[device.get_queue_family()].timestampValidBits; valid_bits > 0) {
+		m_timestamp_period = device.get_physical_device().getProperties().limits.timestampPeriod;
+		m_timestamp_mask = valid_bits >= 64 ? ~std::uint64_t{} : (std::uint64_t{1} << valid_bits) - 1;
+		for (auto& sync : m_frame.syncs) {
+			sync.timestamps = device.get_device().createQueryPoolUnique(vk::QueryPoolCreateInfo{{}, vk::QueryType::eTimestamp, timestamp_count_v});
+		}
+	}
+
+	if (device.get_info().bindless) { m_material_table = std::make_unique<MaterialTable>(); }
+	if (ComputeSkinning::is_supported()) { m_compute_skinning = std::make_unique<ComputeSkinning>(); }
 }
 
 Renderer::~Renderer() {
@@ -267,6 +335,7 @@ auto Renderer::get_colour_format() const -> vk::Format { return m_swapchain.crea
 auto Renderer::get_depth_format() const -> vk::Format { return m_frame.depth_images[0]->format(); }
 
 auto Renderer::wait_for_frame(glm::uvec2 const framebuffer_extent) -> std::optional<std::uint32_t> {
+	LE_PROFILE_SCOPE("Renderer::wait_for_frame");
 	if (framebuffer_extent.x == 0 || framebuffer_extent.y == 0) { return {}; }
 
 	auto ret = acquire_next_image(framebuffer_extent);
@@ -279,6 +348,7 @@ auto Renderer::wait_for_frame(glm::uvec2 const framebuffer_extent) -> std::optio
 	auto& sync = m_frame.syncs[get_frame_index()];
 
 	if (!device.reset(*sync.drawn)) { throw Error{"Failed to wait for frame fence"}; }
+	read_timestamps(sync);
 
 	device.get_device().resetCommandPool(*sync.command_pool);
 	m_defer.next_frame();
@@ -286,6 +356,8 @@ auto Renderer::wait_for_frame(glm::uvec2 const framebuffer_extent) -> std::optio
 	m_imgui->new_frame();
 	m_descriptor_cache.next_frame();
 	m_scratch_buffer_cache.next_frame();
+	if (m_material_table) { m_material_table->next_frame(); }
+	if (m_compute_skinning) { m_compute_skinning->next_frame(); }
 
 	m_frame.framebuffer_extent = framebuffer_extent;
 	m_frame.last_bound = vk::Pipeline{};
@@ -295,6 +367,7 @@ auto Renderer::wait_for_frame(glm::uvec2 const framebuffer_extent) -> std::optio
 
 auto Renderer::render(RenderFrame const& render_frame, std::uint32_t const image_index) -> std::uint32_t {
 	static constexpr auto ui_camera_v{Camera{.type = Camera::Orthographic{}}};
+	LE_PROFILE_SCOPE("Renderer::render");
 
 	auto const shadow_view_plane = ViewPlane{.near = -0.5f * shadow_frustum.z, .far = 0.5f * shadow_frustum.z};
 	auto shadow_camera = Camera{.type = Camera::Orthographic{.view_plane = shadow_view_plane}, .face = Camera::Face::ePositiveZ};
@@ -304,8 +377,16 @@ auto Renderer::render(RenderFrame const& render_frame, std::uint32_t const image
 
 	auto& sync = m_frame.syncs[get_frame_index()];
 	sync.command_buffer.begin({vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+	auto const write_timestamp = [&sync](std::uint32_t const query) {
+		if (!sync.timestamps) { return; }
+		sync.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eAllCommands, *sync.timestamps, query);
+	};
+	if (sync.timestamps) {
+		sync.command_buffer.resetQueryPool(*sync.timestamps, 0, timestamp_count_v);
+		sync.timestamps_written = true;
+	}
 
-	auto const swapchain_image = m_swapchain.active.images[image_index];
+	auto const swapchain_image = m_headless ? get_offscreen_image() : m_swapchain.active.images[image_index];
 	auto& depth_image = m_frame.depth_images[get_frame_index()];
 	auto& shadow_map = m_frame.shadow_maps[get_frame_index()];
 	if (depth_image->extent() != swapchain_image.extent) { depth_image->recreate(swapchain_image.extent); }
@@ -313,12 +394,17 @@ auto Renderer::render(RenderFrame const& render_frame, std::uint32_t const image
 	glm::vec2 const full_projection = glm::uvec2{swapchain_image.extent.width, swapchain_image.extent.height};
 	auto colour_image_barrier = ImageBarrier{swapchain_image.image};
 
-	bake_objects(render_frame);
+	m_counters.pipeline_binds = {};
+	auto const descriptor_binds_start = DescriptorUpdater::bind_count();
+	auto const camera_view_projection = render_frame.camera->projection(custom_world_frustum.value_or(full_projection)) * render_frame.camera->view();
+	bake_objects(render_frame, Frustum::from(camera_view_projection), Frustum::from(m_frame.primary_light_mat), sync.command_buffer);
 
 	auto rendering_info = RenderingInfo{};
 
 	auto const shadow_pass = [&] {
 		FrameProfiler::self().profile(FrameProfiler::Type::eRenderShadowMap);
+		LE_PROFILE_SCOPE("Renderer::shadow_pass");
+		write_timestamp(0);
 		auto const ret = ImageView{
 			.image = shadow_map->image(),
 			.view = shadow_map->image_view(),
@@ -328,7 +414,7 @@ auto Renderer::render(RenderFrame const& render_frame, std::uint32_t const image
 
 		auto const render_target = RenderTarget{.depth = ret};
 		m_frame.backbuffer_extent = {render_target.depth.extent.width, render_target.depth.extent.height};
-		auto const pass = ShadowPass{
+		auto pass = ShadowPass{
 			render_target,
 			glm::uvec2{shadow_frustum},
 		};
@@ -344,10 +430,11 @@ auto Renderer::render(RenderFrame const& render_frame, std::uint32_t const image
 		auto const vri = rendering_info.build_shadow(render_target.depth);
 		sync.command_buffer.beginRendering(vri);
 		m_rendering = true;
-		pass.render_list(render_camera, m_scene_objects, sync.command_buffer);
+		pass.render_list(render_camera, m_shadow_objects, sync.command_buffer);
 		m_rendering = false;
 		sync.command_buffer.endRendering();
 		image_barrier.set_optimal_to_read_only(true).transition(sync.command_buffer);
+		write_timestamp(1);
 
 		return ret;
 	};
@@ -355,6 +442,7 @@ auto Renderer::render(RenderFrame const& render_frame, std::uint32_t const image
 
 	auto const scene_ui_pass = [&] {
 		FrameProfiler::self().profile(FrameProfiler::Type::eRenderScene);
+		LE_PROFILE_SCOPE("Renderer::scene_ui_pass");
 		auto ret = std::uint32_t{};
 		auto const depth_image_view = ImageView{
 			.image = depth_image->image(),
@@ -370,6 +458,7 @@ auto Renderer::render(RenderFrame const& render_frame, std::uint32_t const image
 			custom_world_frustum.value_or(full_projection),
 			polygon_mode,
 		};
+		pass.material_table = get_material_table();
 		auto render_camera = RenderCamera{
 			.camera = render_frame.camera,
 			.lights = render_frame.lights,
@@ -390,21 +479,29 @@ auto Renderer::render(RenderFrame const& render_frame, std::uint32_t const image
 		ret += pass.render_list(render_camera, m_ui_objects, sync.command_buffer);
 		m_rendering = false;
 		sync.command_buffer.endRendering();
+		write_timestamp(2);
 		return ret;
 	};
 	auto const draw_calls = scene_ui_pass();
+	m_counters.descriptor_binds = static_cast<std::uint32_t>(DescriptorUpdater::bind_count() - descriptor_binds_start);
 
 	auto const dear_imgui_pass = [&] {
 		FrameProfiler::self().profile(FrameProfiler::Type::eRenderImGui);
+		LE_PROFILE_SCOPE("Renderer::dear_imgui_pass");
 		auto const render_target = RenderTarget{.colour = swapchain_image};
 		auto const vri = rendering_info.build(render_target, {});
 		sync.command_buffer.beginRendering(vri);
 		m_imgui->render(sync.command_buffer);
 		sync.command_buffer.endRendering();
+		write_timestamp(3);
 	};
 	dear_imgui_pass();
 
-	colour_image_barrier.set_optimal_to_present();
+	if (m_headless) {
+		colour_image_barrier.set_optimal_to_transfer_src();
+	} else {
+		colour_image_barrier.set_optimal_to_present();
+	}
 	colour_image_barrier.transition(sync.command_buffer);
 
 	sync.command_buffer.end();
@@ -412,18 +509,53 @@ auto Renderer::render(RenderFrame const& render_frame, std::uint32_t const image
 	return draw_calls;
 }
 
+auto Renderer::read_timestamps(Frame::Sync& sync) const -> void {
+	// the frame fence has been waited on: results of the previous use of this frame index are available.
+	if (!sync.timestamps_written) { return; }
+	sync.timestamps_written = false;
+	auto ticks = std::array<std::uint64_t, timestamp_count_v>{};
+	auto const result = Device::self().get_device().getQueryPoolResults(*sync.timestamps, 0, timestamp_count_v, sizeof(ticks), ticks.data(),
+																		 sizeof(std::uint64_t), vk::QueryResultFlagBits::e64);
+	if (result != vk::Result::eSuccess) { return; }
+
+	auto const elapsed = [&](std::size_t const first, std::size_t const last) {
+		auto const delta = (ticks.at(last) - ticks.at(first)) & m_timestamp_mask;
+		return Duration{FDuration<std::nano>{static_cast<float>(delta) * m_timestamp_period}};
+	};
+	auto gpu_profile = EnumArray<FrameProfile::Type, Duration>{};
+	gpu_profile[FrameProfile::Type::eRenderShadowMap] = elapsed(0, 1);
+	gpu_profile[FrameProfile::Type::eRenderScene] = elapsed(1, 2);
+	gpu_profile[FrameProfile::Type::eRenderImGui] = elapsed(2, 3);
+	FrameProfiler::self().set_gpu_profile(gpu_profile, elapsed(0, 3));
+}
+
 auto Renderer::submit_frame(std::uint32_t const image_index) -> bool {
 	FrameProfiler::self().profile(FrameProfiler::Type::eRenderSubmit);
+	LE_PROFILE_SCOPE("Renderer::submit_frame");
 	auto& sync = m_frame.syncs[get_frame_index()];
 
 	auto vsi = vk::SubmitInfo2{};
 	auto const cbsi = vk::CommandBufferSubmitInfo{sync.command_buffer};
-	auto const ssi_wait = vk::SemaphoreSubmitInfo{*sync.draw, {}, vk::PipelineStageFlagBits2::eColorAttachmentOutput};
+	// submit pending uploads and wait for them before any command in this frame.
+	m_submit_waits.clear();
+	UploadQueue::self().flush(m_submit_waits, vk::PipelineStageFlagBits2::eAllCommands);
+	if (m_headless) {
+		// nothing to acquire or present: the frame fence is the only other synchronization required.
+		vsi.commandBufferInfoCount = 1;
+		vsi.pCommandBufferInfos = &cbsi;
+		vsi.waitSemaphoreInfoCount = static_cast<std::uint32_t>(m_submit_waits.size());
+		vsi.pWaitSemaphoreInfos = m_submit_waits.data();
+		if (!Device::self().submit(vsi, *sync.drawn)) { throw Error{"Failed to submit offscreen frame"}; }
+		m_frame.frame_index.increment();
+		return true;
+	}
+
+	m_submit_waits.emplace_back(*sync.draw, 0, vk::PipelineStageFlagBits2::eColorAttachmentOutput);
 	auto const ssi_signal = vk::SemaphoreSubmitInfo{*sync.present, {}, vk::PipelineStageFlagBits2::eColorAttachmentOutput};
 	vsi.commandBufferInfoCount = 1;
 	vsi.pCommandBufferInfos = &cbsi;
-	vsi.waitSemaphoreInfoCount = 1;
-	vsi.pWaitSemaphoreInfos = &ssi_wait;
+	vsi.waitSemaphoreInfoCount = static_cast<std::uint32_t>(m_submit_waits.size());
+	vsi.pWaitSemaphoreInfos = m_submit_waits.data();
 	vsi.signalSemaphoreInfoCount = 1;
 	vsi.pSignalSemaphoreInfos = &ssi_signal;
 
@@ -448,6 +580,14 @@ auto Renderer::submit_frame(std::uint32_t const image_index) -> bool {
 }
 
 auto Renderer::recreate_swapchain(std::optional<glm::uvec2> extent, std::optional<vk::PresentModeKHR> mode) -> bool {
+	if (m_headless) {
+		// offscreen images are recreated on demand in render().
+		if (!extent || extent->x == 0 || extent->y == 0) { return false; }
+		m_swapchain.create_info.imageExtent = vk::Extent2D{extent->x, extent->y};
+		m_swapchain.active.extent = *extent;
+		return true;
+	}
+
 	auto& device = Device::self();
 
 	auto const caps = device.get_physical_device().getSurfaceCapabilitiesKHR(device.get_surface());
@@ -502,12 +642,43 @@ auto Renderer::recreate_swapchain(std::optional<glm::uvec2> extent, std::optiona
 	return true;
 }
 
+auto Renderer::prewarm(std::span<RenderObject const> objects) -> std::size_t {
+	auto const scene_format = get_pipeline_format();
+	auto const shadow_format = PipelineFormat{.depth = m_frame.shadow_maps[0]->format()};
+	auto ret = std::size_t{};
+	// assumes MaterialTable::push_to() will succeed (it only fails when full).
+	auto const bindless = get_material_table() != nullptr;
+	auto const skinning = get_compute_skinning() != nullptr;
+	for (auto const& object : objects) {
+		auto const& material = Material::or_default(object.material);
+		auto shader = bindless ? material.get_bindless_shader() : material.get_shader();
+		if (skinning && is_compute_skinned(object) && object.primitive->get_skin_source()) { shader.vertex = ComputeSkinning::vertex_shader_v; }
+		if (m_pipeline_cache.prewarm(scene_format, shader, object.pipeline_state, polygon_mode)) { ++ret; }
+		if (!material.cast_shadow()) { continue; }
+		auto shadow_shader = Shader{.vertex = shader.vertex, .fragment = shadow_fragment_shader_v};
+		if (m_pipeline_cache.prewarm(shadow_format, std::move(shadow_shader), object.pipeline_state, vk::PolygonMode::eFill)) { ++ret; }
+	}
+	return ret;
+}
+
+auto Renderer::prewarm(RenderFrame const& render_frame) -> std::size_t { return prewarm(render_frame.scene) + prewarm(render_frame.ui); }
+
+auto Renderer::prewarm(Mesh const& mesh, PipelineState const pipeline_state) -> std::size_t {
+	auto objects = std::vector<RenderObject>{};
+	objects.reserve(mesh.primitives.size());
+	for (auto const& primitive : mesh.primitives) {
+		objects.push_back(RenderObject{.material = &Material::or_default(primitive.material), .primitive = primitive.primitive, .pipeline_state = pipeline_state});
+	}
+	return prewarm(objects);
+}
+
 auto Renderer::bind_pipeline(vk::Pipeline pipeline) -> bool {
 	if (!m_rendering || !pipeline) { return false; }
 	if (m_frame.last_bound != pipeline) {
 		auto const cmd = m_frame.syncs[get_frame_index()].command_buffer;
 		cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
 		m_frame.last_bound = pipeline;
+		++m_counters.pipeline_binds;
 	}
 	// assert(m_current_pass);
 	set_viewport();
@@ -531,6 +702,11 @@ auto Renderer::set_scissor(vk::Rect2D scissor) -> bool {
 }
 
 auto Renderer::acquire_next_image(glm::uvec2 const framebuffer_extent) -> std::optional<std::uint32_t> {
+	if (m_headless) {
+		if (m_swapchain.active.extent != framebuffer_extent) { recreate_swapchain(framebuffer_extent); }
+		return 0;
+	}
+
 	auto& device = Device::self();
 	auto& sync = m_frame.syncs[get_frame_index()];
 
@@ -545,40 +721,129 @@ auto Renderer::acquire_next_image(glm::uvec2 const framebuffer_extent) -> std::o
 	}
 }
 
-auto Renderer::bake_objects(std::span<RenderObject const> objects, std::vector<RenderObject::Baked>& out) -> void {
-	out.clear();
+auto Renderer::get_offscreen_image() -> ImageView {
+	auto& image = m_frame.offscreen_images[get_frame_index()];
+	if (image->extent() != m_swapchain.create_info.imageExtent) { image->recreate(m_swapchain.create_info.imageExtent); }
+	return ImageView{
+		.image = image->image(),
+		.view = image->image_view(),
+		.extent = image->extent(),
+		.format = image->format(),
+	};
+}
 
-	static auto const default_instance{graphics::RenderInstance{}};
+auto Renderer::bake_objects(RenderFrame const& render_frame, Frustum const& camera_frustum, Frustum const& shadow_frustum, vk::CommandBuffer const cmd)
+	-> void {
+	LE_PROFILE_SCOPE("Renderer::bake_objects");
+	m_scene_objects.clear();
+	m_shadow_objects.clear();
+	m_ui_objects.clear();
+	m_object_sets.clear();
+
+	m_sorter.mode = sort_mode;
+	m_sorter.bindless = get_material_table() != nullptr;
+	auto const scene = m_sorter.sort(render_frame.scene, render_frame.camera->transform.position());
+	cull_objects(scene, camera_frustum, shadow_frustum);
+
+	m_object_baker.clear();
+	m_object_baker.batching = auto_instance;
+	// objects visible to both the camera and the shadow map are baked once, and drawn by both passes.
+	auto const scene_count = m_object_baker.push(m_visible.objects, m_visible.passes);
+	auto const ui_count = m_object_baker.push(render_frame.ui);
+	m_counters.draws_saved = static_cast<std::uint32_t>(m_object_baker.merged_count());
+	auto const entries = m_object_baker.get_entries();
+	if (entries.empty()) { return; }
+
+	auto const allocation = m_scratch_buffer_cache.allocate(vk::BufferUsageFlagBits::eStorageBuffer, m_object_baker.size_bytes());
+
+	// descriptor sets are allocated serially (DescriptorCache is not thread safe), updated in parallel below.
 	auto const& object_layout = PipelineCache::self().shader_layout().object;
-
-	auto build_instances = [this](glm::mat4 const& parent, std::span<RenderInstance const> in) -> std::span<Std430Instance const> {
-		m_instances.clear();
-		m_instances.reserve(in.size());
-		for (auto const& instance : in) {
-			m_instances.push_back({
-				.transform = parent * instance.transform.matrix(),
-				.tint = Rgba::to_linear(instance.tint.to_tint()),
-			});
+	m_object_sets.reserve(entries.size());
+	for (std::size_t i = 0; i < entries.size(); ++i) { m_object_sets.emplace_back(object_layout.set); }
+
+	auto const& empty = m_scratch_buffer_cache.get_empty_buffer(vk::BufferUsageFlagBits::eStorageBuffer);
+	auto const bake_chunk = [&](std::size_t const first, std::size_t const last) {
+		LE_PROFILE_SCOPE("Renderer::bake_chunk");
+		m_object_baker.write(allocation.mapped, first, last);
+		for (std::size_t i = first; i < last; ++i) {
+			auto const& entry = entries[i];
+			auto& object_set = m_object_sets[i];
+			auto const instances = vk::DescriptorBufferInfo{allocation.buffer, allocation.offset + entry.instances.offset, entry.instances.size};
+			auto const joints = entry.joints.size > 0 ? vk::DescriptorBufferInfo{allocation.buffer, allocation.offset + entry.joints.offset, entry.joints.size}
+													  : vk::DescriptorBufferInfo{empty.buffer(), {}, empty.size()};
+			object_set.update(object_layout.instances, vk::DescriptorType::eStorageBuffer, instances, 1);
+			object_set.update(object_layout.joints, vk::DescriptorType::eStorageBuffer, joints, 1);
 		}
-		return m_instances;
 	};
+	if (parallel_bake) {
+		m_bake_pool.for_each_chunk(entries.size(), bake_chunk, m_object_baker.min_chunk);
+	} else {
+		bake_chunk(0, entries.size());
+	}
 
-	for (auto const& object : objects) {
-		auto const instances = object.instances.empty() ? std::span{&default_instance, 1} : object.instances;
-		auto const render_instances = build_instances(object.parent, instances);
-		auto object_set = DescriptorUpdater{object_layout.set};
-		object_set.write_storage(object_layout.instances, render_instances.data(), render_instances.size_bytes());
-		if (!object.joints.empty()) { object_set.write_storage(object_layout.joints, object.joints.data(), std::span{object.joints}.size_bytes()); }
-		out.push_back(RenderObject::Baked{
-			.object = object,
-			.descriptor_set = object_set.get_descriptor_set(),
-			.instance_count = static_cast<std::uint32_t>(instances.size()),
-		});
+	auto const bake = [&](std::size_t const index) {
+		return RenderObject::Baked{
+			.object = entries[index].object,
+			.descriptor_set = m_object_sets[index].get_descriptor_set(),
+			.instance_count = entries[index].instance_count,
+		};
+	};
+	auto const skinning = get_compute_skinning();
+	m_scene_objects.reserve(scene_count);
+	m_shadow_objects.reserve(scene_count);
+	for (std::size_t i = 0; i < scene_count; ++i) {
+		auto baked = bake(i);
+		auto const& object = *baked.object;
+		// skinned once, shared by both passes.
+		if (skinning != nullptr && is_compute_skinned(object)) { baked.skinned_vertices = skinning->skin(*object.primitive, object.joints, cmd); }
+		if ((entries[i].passes & eCameraPass) != 0) { m_scene_objects.push_back(baked); }
+		if ((entries[i].passes & eShadowPass) != 0) { m_shadow_objects.push_back(baked); }
 	}
+	if (skinning != nullptr) { skinning->barrier(cmd); }
+	m_ui_objects.reserve(ui_count);
+	for (std::size_t i = scene_count; i < scene_count + ui_count; ++i) { m_ui_objects.push_back(bake(i)); }
 }
 
-auto Renderer::bake_objects(RenderFrame const& render_frame) -> void {
-	bake_objects(render_frame.scene, m_scene_objects);
-	bake_objects(render_frame.ui, m_ui_objects);
+auto Renderer::cull_objects(std::span<Ptr<RenderObject const> const> scene, Frustum const& camera_frustum, Frustum const& shadow_frustum) -> void {
+	m_visible.objects.clear();
+	m_visible.passes.clear();
+	m_visible.camera_mask.resize(scene.size());
+	m_visible.shadow_mask.resize(scene.size());
+
+	if (frustum_culling) {
+		m_culler.clear();
+		for (auto const* object : scene) { m_culler.push(*object); }
+		m_culler.cull(camera_frustum, m_visible.camera_mask);
+		m_culler.cull(shadow_frustum, m_visible.shadow_mask);
+	} else {
+		std::ranges::fill(m_visible.camera_mask, std::uint8_t{1});
+		std::ranges::fill(m_visible.shadow_mask, std::uint8_t{1});
+	}
+
+	auto counters = Counters{};
+	auto shadow_casters = std::uint32_t{};
+	for (std::size_t i = 0; i < scene.size(); ++i) {
+		auto const* object = scene[i];
+		auto passes = ObjectBaker::PassMask{};
+		if (m_visible.camera_mask[i] != 0) {
+			passes |= eCameraPass;
+			++counters.visible;
+		}
+		if (Material::or_default(object->material).cast_shadow()) {
+			++shadow_casters;
+			if (m_visible.shadow_mask[i] != 0) {
+				passes |= eShadowPass;
+				++counters.shadow_visible;
+			}
+		}
+		if (passes == 0) { continue; }
+		m_visible.objects.push_back(object);
+		m_visible.passes.push_back(passes);
+	}
+
+	m_counters.visible = counters.visible;
+	m_counters.culled = static_cast<std::uint32_t>(scene.size()) - counters.visible;
+	m_counters.shadow_visible = counters.shadow_visible;
+	m_counters.shadow_culled = shadow_casters - counters.shadow_visible;
 }
 } // namespace le::graphics
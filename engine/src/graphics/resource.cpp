@@ -1,5 +1,5 @@
 #include <le/graphics/allocator.hpp>
-#include <le/graphics/command_buffer.hpp>
+#include <le/graphics/defer.hpp>
 #include <le/graphics/device.hpp>
 #include <le/graphics/image_barrier.hpp>
 #include <le/graphics/resource.hpp>
@@ -7,6 +7,8 @@
 #include <atomic>
 #include <cmath>
 #include <numeric>
+#include <utility>
+#include <vector>
 
 namespace le::graphics {
 namespace {
@@ -29,6 +31,13 @@ struct VmaImage {
 		ici.extent = vk::Extent3D{extent, 1};
 		ici.format = m_create_info.format;
 		ici.samples = m_create_info.samples;
+		// uploads may be recorded on a dedicated transfer queue.
+		auto const queue_families = Device::self().get_queue_families();
+		if (queue_families.size() > 1 && (ici.usage & vk::ImageUsageFlagBits::eTransferDst)) {
+			ici.sharingMode = vk::SharingMode::eConcurrent;
+			ici.queueFamilyIndexCount = static_cast<std::uint32_t>(queue_families.size());
+			ici.pQueueFamilyIndices = queue_families.data();
+		}
 		auto const vici = static_cast<VkImageCreateInfo>(ici);
 
 		// NOLINTNEXTLINE
@@ -124,6 +133,7 @@ struct CopyBufferToImage {
 	vk::Extent2D image_extent{};
 	vk::Offset2D target_offset{};
 	vk::Buffer source_bytes{};
+	vk::DeviceSize source_offset{};
 	vk::Extent2D source_extent{};
 	std::uint32_t array_layers{1};
 	std::uint32_t mip_levels{1};
@@ -131,7 +141,7 @@ struct CopyBufferToImage {
 	auto operator()(vk::CommandBuffer cmd) const {
 		auto const isrl = vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, array_layers);
 		auto const vk_extent = vk::Extent3D{source_extent, 1u};
-		auto const bic = vk::BufferImageCopy({}, {}, {}, isrl, vk::Offset3D{target_offset, 0}, vk_extent);
+		auto const bic = vk::BufferImageCopy(source_offset, {}, {}, isrl, vk::Offset3D{target_offset, 0}, vk_extent);
 		auto barrier = ImageBarrier{target_image, mip_levels, array_layers};
 		barrier.set_full_barrier(vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal).transition(cmd);
 		cmd.copyBufferToImage(source_bytes, target_image, vk::ImageLayout::eTransferDstOptimal, bic);
@@ -146,6 +156,7 @@ struct CopyImage {
 	vk::ImageLayout layout{};
 	vk::Extent2D extent{};
 	vk::Offset2D offset{};
+	std::uint32_t mip_levels{1};
 };
 
 struct CopyImageToImage {
@@ -153,12 +164,11 @@ struct CopyImageToImage {
 	CopyImage target{};
 
 	std::uint32_t array_layers{1};
-	std::uint32_t mip_levels{1};
 
 	auto operator()(vk::CommandBuffer cmd) const {
 		auto const isrl = vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, array_layers);
-		auto source_barrier = ImageBarrier{source.image, mip_levels, array_layers};
-		auto target_barrier = ImageBarrier{target.image, mip_levels, array_layers};
+		auto source_barrier = ImageBarrier{source.image, source.mip_levels, array_layers};
+		auto target_barrier = ImageBarrier{target.image, target.mip_levels, array_layers};
 		source_barrier.set_full_barrier(source.layout, vk::ImageLayout::eTransferSrcOptimal).transition(cmd);
 		target_barrier.set_full_barrier(target.layout, vk::ImageLayout::eTransferDstOptimal).transition(cmd);
 		auto image_copy = vk::ImageCopy{isrl, vk::Offset3D{source.offset, 0}, isrl, vk::Offset3D{target.offset, 0}, vk::Extent3D{source.extent, 1}};
@@ -166,19 +176,57 @@ struct CopyImageToImage {
 		source_barrier.set_full_barrier(vk::ImageLayout::eTransferSrcOptimal, vk::ImageLayout::eShaderReadOnlyOptimal).transition(cmd);
 		target_barrier.set_full_barrier(vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal).transition(cmd);
 
-		if (mip_levels > 1) { MipMapWriter{target_barrier, target.extent, cmd, mip_levels, array_layers}(); }
+		if (target.mip_levels > 1) { MipMapWriter{target_barrier, target.extent, cmd, target.mip_levels, array_layers}(); }
 	}
 };
 
 std::atomic<vk::DeviceSize> g_buffer_bytes{}; // NOLINT
 std::atomic<vk::DeviceSize> g_image_bytes{};  // NOLINT
+std::atomic<std::uint64_t> g_image_serial{};   // NOLINT
+
+// owns a replaced image until it is no longer in use.
+struct RetiredImage {
+	VmaImage image{};
+	vk::DeviceSize bytes{};
+
+	RetiredImage(VmaImage vma_image, vk::DeviceSize const size) : image(std::move(vma_image)), bytes(size) {}
+
+	RetiredImage(RetiredImage&& rhs) noexcept : image(std::move(rhs.image)), bytes(std::exchange(rhs.bytes, {})) {
+		rhs.image.image = vk::Image{};
+		rhs.image.allocation = {};
+	}
+
+	RetiredImage(RetiredImage const&) = delete;
+	auto operator=(RetiredImage const&) -> RetiredImage& = delete;
+	auto operator=(RetiredImage&&) -> RetiredImage& = delete;
+
+	~RetiredImage() {
+		vmaDestroyImage(Allocator::instance(), image.image, image.allocation);
+		g_image_bytes -= bytes;
+	}
+};
 } // namespace
 
+auto Resource::prepare_upload(UploadLane const lane) -> UploadQueue& {
+	auto& ret = UploadQueue::self();
+	// uploads recorded on different lanes are not ordered relative to each other.
+	auto other_lanes = m_upload;
+	other_lanes.values[lane] = 0;
+	if (!other_lanes.is_empty()) { ret.wait(other_lanes); }
+	return ret;
+}
+
+auto Resource::wait_upload() -> void {
+	if (!m_upload.is_empty() && UploadQueue::exists()) { UploadQueue::self().wait(m_upload); }
+	m_upload = {};
+}
+
 Buffer::Buffer(vk::BufferUsageFlags usage, vk::DeviceSize capacity, bool host_visible) : m_usage(usage), m_host(host_visible) { resize(capacity); }
 
 Buffer::~Buffer() { destroy(); }
 
 auto Buffer::destroy() -> void {
+	wait_upload();
 	vmaDestroyBuffer(Allocator::instance(), m_buffer, m_allocation);
 	g_buffer_bytes -= m_capacity;
 }
@@ -187,7 +235,14 @@ auto Buffer::resize(std::size_t new_capacity) -> void {
 	auto vaci = VmaAllocationCreateInfo{};
 	vaci.usage = VMA_MEMORY_USAGE_AUTO;
 	if (m_host) { vaci.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT; }
-	auto const bci = vk::BufferCreateInfo{{}, new_capacity, m_usage | vk::BufferUsageFlagBits::eTransferDst};
+	auto bci = vk::BufferCreateInfo{{}, new_capacity, m_usage | vk::BufferUsageFlagBits::eTransferDst};
+	// uploads may be recorded on a dedicated transfer queue.
+	auto const queue_families = Device::self().get_queue_families();
+	if (!m_host && queue_families.size() > 1) {
+		bci.sharingMode = vk::SharingMode::eConcurrent;
+		bci.queueFamilyIndexCount = static_cast<std::uint32_t>(queue_families.size());
+		bci.pQueueFamilyIndices = queue_families.data();
+	}
 	auto vbci = static_cast<VkBufferCreateInfo>(bci);
 
 	// NOLINTNEXTLINE
@@ -221,14 +276,26 @@ auto HostBuffer::write(void const* data, std::size_t size) -> void {
 }
 
 auto DeviceBuffer::write(void const* data, std::size_t size) -> void {
-	auto scratch_buffer = std::make_unique<HostBuffer>(vk::BufferUsageFlagBits::eTransferSrc, size);
-	scratch_buffer->write(data, size);
 	if (size > m_capacity) { resize(size); }
-	auto cmd = CommandBuffer{};
-	auto const bcr = vk::BufferCopy{{}, {}, size};
-	cmd.get().copyBuffer(scratch_buffer->buffer(), m_buffer, bcr);
 	m_size = size;
-	cmd.submit();
+	if (size == 0) { return; }
+
+	static constexpr auto lane_v = UploadLane::eTransfer;
+	auto const copy = [&](vk::CommandBuffer const cmd, UploadQueue::Staging const& staging) {
+		std::memcpy(staging.mapped.data(), data, size);
+		if (m_upload.values[lane_v] == staging.batch.values[lane_v]) {
+			// already written in this batch: order the copies.
+			auto barrier = vk::MemoryBarrier2{};
+			barrier.srcStageMask = barrier.dstStageMask = vk::PipelineStageFlagBits2::eTransfer;
+			barrier.srcAccessMask = barrier.dstAccessMask = vk::AccessFlagBits2::eTransferWrite;
+			auto vdi = vk::DependencyInfo{};
+			vdi.memoryBarrierCount = 1;
+			vdi.pMemoryBarriers = &barrier;
+			cmd.pipelineBarrier2(vdi);
+		}
+		cmd.copyBuffer(staging.buffer, m_buffer, vk::BufferCopy{staging.offset, 0, size});
+	};
+	m_upload.merge(prepare_upload(lane_v).record(lane_v, size, copy));
 }
 
 auto Image::compute_mip_levels(vk::Extent2D extent) -> std::uint32_t {
@@ -244,6 +311,7 @@ Image::Image(ImageCreateInfo const& info, vk::Extent2D extent) {
 Image::~Image() { destroy(); }
 
 auto Image::destroy() -> void {
+	wait_upload();
 	vmaDestroyImage(Allocator::instance(), m_image, m_allocation);
 	g_image_bytes -= m_bytes_allocated;
 }
@@ -262,6 +330,7 @@ auto Image::recreate(vk::Extent2D extent) -> void {
 	m_extent = extent;
 	m_layout = vk::ImageLayout::eUndefined;
 	m_mip_levels = mip_levels;
+	m_serial = ++g_image_serial;
 
 	auto info = VmaAllocationInfo{};
 	vmaGetAllocationInfo(Allocator::self(), m_allocation, &info);
@@ -278,27 +347,27 @@ auto Image::copy_from(std::span<Layer const> layers, vk::Extent2D target_extent)
 	if (m_extent != target_extent) { recreate(target_extent); }
 	auto const accumulate_size = [](std::size_t total, Layer const layer) { return total + layer.size_bytes(); };
 	auto const size = std::accumulate(layers.begin(), layers.end(), std::size_t{}, accumulate_size);
-	auto staging = HostBuffer{vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst, size};
 
-	auto* ptr = static_cast<std::byte*>(staging.mapped());
-	for (auto const& image : layers) {
-		std::memcpy(ptr, image.data(), image.size_bytes());
-		// NOLINTNEXTLINE
-		ptr += image.size_bytes();
-	}
-
-	auto cmd = CommandBuffer{};
-	CopyBufferToImage{
-		.target_image = m_image,
-		.image_extent = m_extent,
-		.target_offset = {},
-		.source_bytes = staging.buffer(),
-		.source_extent = target_extent,
-		.array_layers = array_layers,
-		.mip_levels = m_mip_levels,
-	}(cmd.get());
-
-	cmd.submit();
+	auto const copy = [&](vk::CommandBuffer const cmd, UploadQueue::Staging const& staging) {
+		auto* ptr = staging.mapped.data();
+		for (auto const& image : layers) {
+			std::memcpy(ptr, image.data(), image.size_bytes());
+			// NOLINTNEXTLINE
+			ptr += image.size_bytes();
+		}
+		CopyBufferToImage{
+			.target_image = m_image,
+			.image_extent = m_extent,
+			.target_offset = {},
+			.source_bytes = staging.buffer,
+			.source_offset = staging.offset,
+			.source_extent = target_extent,
+			.array_layers = array_layers,
+			.mip_levels = m_mip_levels,
+		}(cmd);
+	};
+	auto const lane = UploadQueue::self().image_lane(m_mip_levels);
+	m_upload.merge(prepare_upload(lane).record(lane, size, copy));
 
 	return true;
 }
@@ -310,22 +379,22 @@ auto Image::overwrite(Bitmap const& bitmap, glm::uvec2 top_left) -> bool {
 	auto const current_extent = glm::uvec2{m_extent.width, m_extent.height};
 	if (overwrite_extent.x > current_extent.x || overwrite_extent.y > current_extent.y) { return false; }
 
-	auto staging = HostBuffer{vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst, bitmap.bytes.size_bytes()};
-	std::memcpy(staging.mapped(), bitmap.bytes.data(), bitmap.bytes.size_bytes());
-
-	auto cmd = CommandBuffer{};
-	auto const offset = glm::ivec2{top_left};
-	CopyBufferToImage{
-		.target_image = m_image,
-		.image_extent = m_extent,
-		.target_offset = {offset.x, offset.y},
-		.source_bytes = staging.buffer(),
-		.source_extent = {bitmap.extent.x, bitmap.extent.y},
-		.array_layers = 1,
-		.mip_levels = m_mip_levels,
-	}(cmd.get());
-
-	cmd.submit();
+	auto const copy = [&](vk::CommandBuffer const cmd, UploadQueue::Staging const& staging) {
+		std::memcpy(staging.mapped.data(), bitmap.bytes.data(), bitmap.bytes.size_bytes());
+		auto const offset = glm::ivec2{top_left};
+		CopyBufferToImage{
+			.target_image = m_image,
+			.image_extent = m_extent,
+			.target_offset = {offset.x, offset.y},
+			.source_bytes = staging.buffer,
+			.source_offset = staging.offset,
+			.source_extent = {bitmap.extent.x, bitmap.extent.y},
+			.array_layers = 1,
+			.mip_levels = m_mip_levels,
+		}(cmd);
+	};
+	auto const lane = UploadQueue::self().image_lane(m_mip_levels);
+	m_upload.merge(prepare_upload(lane).record(lane, bitmap.bytes.size_bytes(), copy));
 
 	return true;
 }
@@ -335,31 +404,31 @@ auto Image::overwrite(std::span<ImageWrite const> writes) -> bool {
 
 	auto const accumulate_size = [](std::size_t total, ImageWrite const& iw) { return total + iw.bitmap.bytes.size_bytes(); };
 	auto const size = std::accumulate(writes.begin(), writes.end(), std::size_t{}, accumulate_size);
-	auto staging = HostBuffer{vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst, size};
-
-	auto const isrl = vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1);
-	auto bics = std::vector<vk::BufferImageCopy>{};
-	bics.reserve(writes.size());
-	auto* ptr = static_cast<std::byte*>(staging.mapped());
-	auto buffer_offset = vk::DeviceSize{};
-	for (auto const& iw : writes) {
-		// NOLINTNEXTLINE
-		std::memcpy(ptr + buffer_offset, iw.bitmap.bytes.data(), iw.bitmap.bytes.size_bytes());
-		auto const image_offset = glm::ivec2{iw.top_left};
-		auto const bic = vk::BufferImageCopy{
-			buffer_offset, {}, {}, isrl, vk::Offset3D{image_offset.x, image_offset.y, 0}, {iw.bitmap.extent.x, iw.bitmap.extent.y, 1},
-		};
-		bics.push_back(bic);
-		buffer_offset += iw.bitmap.bytes.size_bytes();
-	}
 
-	auto cmd = CommandBuffer{};
-	auto barrier = ImageBarrier{m_image, m_mip_levels, 1};
-	barrier.set_full_barrier(vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal).transition(cmd);
-	cmd.get().copyBufferToImage(staging.buffer(), m_image, vk::ImageLayout::eTransferDstOptimal, bics);
-	barrier.set_full_barrier(vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal).transition(cmd);
+	auto const copy = [&](vk::CommandBuffer const cmd, UploadQueue::Staging const& staging) {
+		auto const isrl = vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1);
+		auto bics = std::vector<vk::BufferImageCopy>{};
+		bics.reserve(writes.size());
+		auto buffer_offset = vk::DeviceSize{};
+		for (auto const& iw : writes) {
+			std::memcpy(staging.mapped.subspan(buffer_offset).data(), iw.bitmap.bytes.data(), iw.bitmap.bytes.size_bytes());
+			auto const image_offset = glm::ivec2{iw.top_left};
+			auto const bic = vk::BufferImageCopy{
+				staging.offset + buffer_offset, {}, {}, isrl, vk::Offset3D{image_offset.x, image_offset.y, 0}, {iw.bitmap.extent.x, iw.bitmap.extent.y, 1},
+			};
+			bics.push_back(bic);
+			buffer_offset += iw.bitmap.bytes.size_bytes();
+		}
+
+		auto barrier = ImageBarrier{m_image, m_mip_levels, 1};
+		barrier.set_full_barrier(vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal).transition(cmd);
+		cmd.copyBufferToImage(staging.buffer, m_image, vk::ImageLayout::eTransferDstOptimal, bics);
+		barrier.set_full_barrier(vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal).transition(cmd);
 
-	if (m_mip_levels > 1) { MipMapWriter{barrier, m_extent, cmd, m_mip_levels, 1}(); }
+		if (m_mip_levels > 1) { MipMapWriter{barrier, m_extent, cmd, m_mip_levels, 1}(); }
+	};
+	auto const lane = UploadQueue::self().image_lane(m_mip_levels);
+	m_upload.merge(prepare_upload(lane).record(lane, size, copy));
 	return true;
 }
 
@@ -371,22 +440,45 @@ auto Image::resize(vk::Extent2D extent) -> void {
 		.image = m_image,
 		.layout = vk::ImageLayout::eShaderReadOnlyOptimal,
 		.extent = m_extent,
+		.mip_levels = m_mip_levels,
 	};
 	auto const copy_dst = CopyImage{
 		.image = new_image.image,
 		.layout = vk::ImageLayout::eUndefined,
 		.extent = extent,
+		.mip_levels = mip_levels,
 	};
 
-	auto cmd = CommandBuffer{};
-	CopyImageToImage{
-		.source = copy_src,
-		.target = copy_dst,
-		.array_layers = m_create_info.view_type == vk::ImageViewType::eCube ? cubemap_layers_v : 1,
-		.mip_levels = mip_levels,
-	}(cmd);
+	auto const copy = [&](vk::CommandBuffer const cmd, UploadQueue::Staging const& /*staging*/) {
+		CopyImageToImage{
+			.source = copy_src,
+			.target = copy_dst,
+			.array_layers = m_create_info.view_type == vk::ImageViewType::eCube ? cubemap_layers_v : 1,
+		}(cmd);
+	};
+	auto const lane = UploadQueue::self().image_lane(mip_levels);
+	auto& upload_queue = prepare_upload(lane);
+	m_upload.merge(upload_queue.record(lane, 0, copy));
+
+	// the previous image is read by the copy, and may be in use by frames in flight.
+	auto retired = RetiredImage{VmaImage{.allocation = m_allocation, .image = m_image, .image_view = std::move(m_view)}, m_bytes_allocated};
+	if (DeferQueue::exists()) {
+		DeferQueue::self().push(std::move(retired));
+	} else {
+		upload_queue.release_after(m_upload, std::move(retired));
+	}
 
-	cmd.submit();
+	m_image = new_image.image;
+	m_view = std::move(new_image.image_view);
+	m_allocation = new_image.allocation;
+	m_extent = extent;
+	m_mip_levels = mip_levels;
+	m_serial = ++g_image_serial;
+
+	auto info = VmaAllocationInfo{};
+	vmaGetAllocationInfo(Allocator::self(), m_allocation, &info);
+	m_bytes_allocated = info.size;
+	g_image_bytes += m_bytes_allocated;
 }
 
 auto Image::bytes_allocated() -> vk::DeviceSize { return g_image_bytes; }
@@ -0,0 +1,213 @@
+#include <le/error.hpp>
+#include <le/graphics/device.hpp>
+#include <le/graphics/resource.hpp>
+#include <le/graphics/upload_queue.hpp>
+#include <algorithm>
+#include <array>
+
+namespace le::graphics {
+namespace {
+constexpr auto lanes_v = std::array{UploadLane::eTransfer, UploadLane::eGraphics};
+
+constexpr auto align_up(vk::DeviceSize const value, vk::DeviceSize const alignment) -> vk::DeviceSize { return (value + alignment - 1) & ~(alignment - 1); }
+
+auto make_timeline_semaphore(vk::Device const device) -> vk::UniqueSemaphore {
+	auto stci = vk::SemaphoreTypeCreateInfo{vk::SemaphoreType::eTimeline, 0};
+	auto sci = vk::SemaphoreCreateInfo{};
+	sci.pNext = &stci;
+	return device.createSemaphoreUnique(sci);
+}
+
+auto make_block(std::size_t const size) -> std::unique_ptr<HostBuffer> { return std::make_unique<HostBuffer>(vk::BufferUsageFlagBits::eTransferSrc, size); }
+} // namespace
+
+auto UploadTicket::merge(UploadTicket const& rhs) -> UploadTicket& {
+	for (auto const lane : lanes_v) { values[lane] = std::max(values[lane], rhs.values[lane]); }
+	return *this;
+}
+
+UploadQueue::UploadQueue() {
+	auto const& device = Device::self();
+	auto const families = EnumArray<UploadLane, std::uint32_t>{.values = {device.get_transfer_queue_family(), device.get_queue_family()}};
+	for (auto const id : lanes_v) {
+		auto& lane = m_lanes[id];
+		auto const flags = vk::CommandPoolCreateFlagBits::eTransient | vk::CommandPoolCreateFlagBits::eResetCommandBuffer;
+		lane.pool = device.get_device().createCommandPoolUnique(vk::CommandPoolCreateInfo{flags, families[id]});
+		lane.semaphore = make_timeline_semaphore(device.get_device());
+	}
+
+	auto const gpu = device.get_physical_device();
+	// transfer-only families may restrict image copies to coarser granularities than individual texels.
+	auto const granularity = gpu.getQueueFamilyProperties()[device.get_transfer_queue_family()].minImageTransferGranularity;
+	m_transfer_images = granularity == vk::Extent3D{1, 1, 1};
+	m_alignment = std::max(vk::DeviceSize{16}, gpu.getProperties().limits.optimalBufferCopyOffsetAlignment);
+}
+
+UploadQueue::~UploadQueue() = default;
+
+auto UploadQueue::image_lane(std::uint32_t const mip_levels) const -> UploadLane {
+	return mip_levels > 1 || !m_transfer_images ? UploadLane::eGraphics : UploadLane::eTransfer;
+}
+
+auto UploadQueue::flush() -> UploadTicket {
+	auto lock = std::scoped_lock{m_mutex};
+	collect();
+	return submit();
+}
+
+auto UploadQueue::flush(std::vector<vk::SemaphoreSubmitInfo>& out_waits, vk::PipelineStageFlags2 const stages) -> void {
+	auto lock = std::scoped_lock{m_mutex};
+	collect();
+	auto const ticket = submit();
+	for (auto const id : lanes_v) {
+		if (ticket.values[id] <= m_lanes[id].completed) { continue; }
+		out_waits.emplace_back(get_semaphore(id), ticket.values[id], stages);
+	}
+}
+
+auto UploadQueue::is_complete(UploadTicket const& ticket) const -> bool {
+	auto const device = Device::self().get_device();
+	return std::ranges::all_of(lanes_v, [&](UploadLane const id) {
+		return ticket.values[id] == 0 || device.getSemaphoreCounterValue(get_semaphore(id)) >= ticket.values[id];
+	});
+}
+
+auto UploadQueue::wait(UploadTicket const& ticket) -> void {
+	auto lock = std::scoped_lock{m_mutex};
+	collect();
+	block_until(ticket);
+}
+
+auto UploadQueue::allocate(UploadLane const lane, std::size_t const size) -> Staging {
+	// may submit pending batches to free up space: begin the lane's batch afterwards.
+	auto* block = size > 0 ? &acquire_block(size) : nullptr;
+	if (!m_lanes[lane].recording) { begin_batch(lane); }
+	auto ret = Staging{.batch = pending_ticket(lane)};
+	if (block == nullptr) { return ret; }
+
+	ret.buffer = block->buffer->buffer();
+	ret.offset = block->offset;
+	ret.mapped = std::span{static_cast<std::byte*>(block->buffer->mapped()) + block->offset, size}; // NOLINT
+	block->offset = align_up(block->offset + size, m_alignment);
+	block->ticket.merge(ret.batch);
+	return ret;
+}
+
+auto UploadQueue::begin_batch(UploadLane const id) -> void {
+	auto& lane = m_lanes[id];
+	auto cmd = vk::CommandBuffer{};
+	if (lane.free.empty()) {
+		auto const cbai = vk::CommandBufferAllocateInfo{*lane.pool, vk::CommandBufferLevel::ePrimary, 1};
+		if (Device::self().get_device().allocateCommandBuffers(&cbai, &cmd) != vk::Result::eSuccess) {
+			throw Error{"Failed to allocate Vulkan Command Buffer"};
+		}
+	} else {
+		cmd = lane.free.back();
+		lane.free.pop_back();
+	}
+	cmd.begin({vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+	lane.pending.cmd = cmd;
+	lane.recording = true;
+}
+
+auto UploadQueue::acquire_block(std::size_t const size) -> Block& {
+	collect();
+	if (size > block_size_v) {
+		// released once its batch completes.
+		auto& ret = m_oversized.emplace_back();
+		ret.buffer = make_block(size);
+		return ret;
+	}
+
+	auto const reset = [this](std::size_t const index) -> Block& {
+		m_block = index;
+		auto& ret = m_blocks[index];
+		ret.offset = {};
+		ret.ticket = {};
+		return ret;
+	};
+	if (m_block < m_blocks.size() && m_blocks[m_block].offset + size <= m_blocks[m_block].buffer->capacity()) { return m_blocks[m_block]; }
+	for (std::size_t i = 1; i <= m_blocks.size(); ++i) {
+		auto const index = (m_block + i) % m_blocks.size();
+		if (is_reached(m_blocks[index].ticket)) { return reset(index); }
+	}
+	if ((m_blocks.size() + 1) * block_size_v <= max_staging_v) {
+		m_block = m_blocks.size();
+		auto& ret = m_blocks.emplace_back();
+		ret.buffer = make_block(block_size_v);
+		return ret;
+	}
+
+	// ring is full: submit everything and wait for the least recently used block.
+	auto const index = (m_block + 1) % m_blocks.size();
+	block_until(m_blocks[index].ticket);
+	return reset(index);
+}
+
+auto UploadQueue::pending_ticket(UploadLane const lane) const -> UploadTicket {
+	auto ret = UploadTicket{};
+	ret.values[lane] = m_lanes[lane].pending.value;
+	return ret;
+}
+
+auto UploadQueue::is_reached(UploadTicket const& ticket) const -> bool {
+	return std::ranges::all_of(lanes_v, [&](UploadLane const id) { return ticket.values[id] <= m_lanes[id].completed; });
+}
+
+auto UploadQueue::submit() -> UploadTicket {
+	auto const& device = Device::self();
+	auto ret = UploadTicket{};
+	for (auto const id : lanes_v) {
+		auto& lane = m_lanes[id];
+		if (lane.recording) {
+			lane.pending.cmd.end();
+			auto const cbsi = vk::CommandBufferSubmitInfo{lane.pending.cmd};
+			auto const ssi = vk::SemaphoreSubmitInfo{*lane.semaphore, lane.pending.value, vk::PipelineStageFlagBits2::eAllCommands};
+			auto vsi = vk::SubmitInfo2{};
+			vsi.commandBufferInfoCount = 1;
+			vsi.pCommandBufferInfos = &cbsi;
+			vsi.signalSemaphoreInfoCount = 1;
+			vsi.pSignalSemaphoreInfos = &ssi;
+			auto const submitted = id == UploadLane::eTransfer ? device.submit_transfer(vsi) : device.submit(vsi);
+			if (!submitted) { throw Error{"Failed to submit uploads"}; }
+			lane.submitted.push_back(lane.pending);
+			lane.pending = Batch{.value = lane.pending.value + 1};
+			lane.recording = false;
+		}
+		ret.values[id] = lane.pending.value - 1;
+	}
+	return ret;
+}
+
+auto UploadQueue::block_until(UploadTicket const& ticket) -> void {
+	if (is_reached(ticket)) { return; }
+	submit();
+
+	auto semaphores = std::array<vk::Semaphore, lanes_v.size()>{};
+	auto values = std::array<std::uint64_t, lanes_v.size()>{};
+	auto count = std::uint32_t{};
+	for (auto const id : lanes_v) {
+		if (ticket.values[id] <= m_lanes[id].completed) { continue; }
+		semaphores.at(count) = get_semaphore(id);
+		values.at(count) = ticket.values[id];
+		++count;
+	}
+	auto const swi = vk::SemaphoreWaitInfo{{}, count, semaphores.data(), values.data()};
+	if (Device::self().get_device().waitSemaphores(swi, Device::max_timeout_v) != vk::Result::eSuccess) { throw Error{"Failed to wait for uploads"}; }
+	collect();
+}
+
+auto UploadQueue::collect() -> void {
+	auto const device = Device::self().get_device();
+	for (auto& lane : m_lanes.values) {
+		if (lane.submitted.empty()) { continue; }
+		lane.completed = device.getSemaphoreCounterValue(*lane.semaphore);
+		while (!lane.submitted.empty() && lane.submitted.front().value <= lane.completed) {
+			lane.free.push_back(lane.submitted.front().cmd);
+			lane.submitted.pop_front();
+		}
+	}
+	std::erase_if(m_oversized, [this](Block const& block) { return is_reached(block.ticket); });
+	std::erase_if(m_retired, [this](Retired const& retired) { return is_reached(retired.ticket); });
+}
+} // namespace le::graphics
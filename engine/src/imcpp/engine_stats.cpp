@@ -37,6 +37,11 @@ auto EngineStats::draw_to(OpenWindow /*w*/) -> void {
 	}
 	bool is_wireframe = renderer.polygon_mode == vk::PolygonMode::eLine;
 	if (ImGui::Checkbox("wireframe", &is_wireframe)) { renderer.polygon_mode = is_wireframe ? vk::PolygonMode::eLine : vk::PolygonMode::eFill; }
+	ImGui::Checkbox("auto instance", &renderer.auto_instance);
+	auto sort_state = renderer.sort_mode == graphics::RenderSorter::Mode::eState;
+	if (ImGui::Checkbox("sort by state", &sort_state)) {
+		renderer.sort_mode = sort_state ? graphics::RenderSorter::Mode::eState : graphics::RenderSorter::Mode::eLayer;
+	}
 
 	auto const framebuffer_extent = engine.framebuffer_extent();
 	ImGui::Text("%s", FixedString{"framebuffer: {}x{}", framebuffer_extent.x, framebuffer_extent.y}.c_str());
@@ -47,6 +52,9 @@ auto EngineStats::draw_to(OpenWindow /*w*/) -> void {
 	if (auto tn = TreeNode{"frame"}) {
 		ImGui::Text("%s", FixedString{"count: {}", stats.frame.count}.c_str());
 		ImGui::Text("%s", FixedString{"draw calls: {}", stats.frame.draw_calls}.c_str());
+		ImGui::Text("%s", FixedString{"draws saved: {}", stats.frame.draws_saved}.c_str());
+		ImGui::Text("%s", FixedString{"pipeline binds: {}", stats.frame.pipeline_binds}.c_str());
+		ImGui::Text("%s", FixedString{"descriptor binds: {}", stats.frame.descriptor_binds}.c_str());
 		auto min_ft = FDuration<std::milli>{engine.min_frame_time}.count();
 		if (ImGui::DragFloat("min frame time", &min_ft, 1.0f, 0.0f, 100.0f)) { engine.min_frame_time = FDuration<std::milli>{min_ft}; }
 		ImGui::DragInt("samples", &frame_samples, 5.0f, 5, 1000);
@@ -55,11 +63,50 @@ auto EngineStats::draw_to(OpenWindow /*w*/) -> void {
 						 overlay_text.c_str(), 0.1f, 30.0f, {0.0f, 50.0f});
 		ImGui::TextColored(get_fps_colour(fps_rgb, stats.frame.rate), "%s", FixedString{"rate: {}FPS", stats.frame.rate}.c_str());
 	}
+	if (auto tn = TreeNode{"culling"}) {
+		ImGui::Checkbox("enabled", &renderer.frustum_culling);
+		ImGui::Text("%s", FixedString{"visible: {}", stats.culling.visible}.c_str());
+		ImGui::Text("%s", FixedString{"culled: {}", stats.culling.culled}.c_str());
+		ImGui::Text("%s", FixedString{"shadow visible: {}", stats.culling.shadow_visible}.c_str());
+		ImGui::Text("%s", FixedString{"shadow culled: {}", stats.culling.shadow_culled}.c_str());
+	}
 	if (auto tn = TreeNode{"cache"}) {
 		ImGui::Text("%s", FixedString{"shaders: {}", stats.cache.shaders}.c_str());
 		ImGui::Text("%s", FixedString{"pipelines: {}", stats.cache.pipelines}.c_str());
+		ImGui::Text("%s", FixedString{"pipeline cache hits: {}", stats.cache.pipeline_hits}.c_str());
+		ImGui::Text("%s", FixedString{"pipeline cache misses: {}", stats.cache.pipeline_misses}.c_str());
+		ImGui::Text("%s", FixedString{"pipelines pending: {}", stats.cache.pipelines_pending}.c_str());
+		ImGui::Text("%s", FixedString{"pipeline compile time: {:.1f}ms", FDuration<std::milli>{stats.cache.pipeline_compile_time}.count()}.c_str());
+		ImGui::Checkbox("skip unready pipelines", &renderer.get_pipeline_cache().skip_unready);
 		ImGui::Text("%s", FixedString{"vertex buffers: {}", stats.cache.vertex_buffers}.c_str());
 	}
+	if (auto tn = TreeNode{"bindless"}) {
+		if (renderer.supports_bindless()) {
+			ImGui::Checkbox("enabled", &renderer.bindless_materials);
+		} else {
+			ImGui::Text("unsupported");
+		}
+		ImGui::Text("%s", FixedString{"textures: {}", stats.bindless.textures}.c_str());
+		ImGui::Text("%s", FixedString{"materials: {}", stats.bindless.materials}.c_str());
+		ImGui::Text("%s", FixedString{"texture writes: {}", stats.bindless.texture_writes}.c_str());
+		ImGui::Text("%s", FixedString{"overflows: {}", stats.bindless.overflows}.c_str());
+	}
+	if (auto tn = TreeNode{"compute skinning"}) {
+		if (renderer.supports_compute_skinning()) {
+			ImGui::Checkbox("enabled", &renderer.compute_skinning);
+		} else {
+			ImGui::Text("unsupported");
+		}
+		ImGui::Text("%s", FixedString{"outputs: {}", stats.skinning.outputs}.c_str());
+		ImGui::Text("%s", FixedString{"dispatches: {}", stats.skinning.dispatches}.c_str());
+		ImGui::Text("%s", FixedString{"skipped: {}", stats.skinning.skipped}.c_str());
+	}
+	if (auto tn = TreeNode{"scratch"}) {
+		ImGui::Text("%s", FixedString{"used: {}", format_bytes(stats.scratch.bytes_used)}.c_str());
+		ImGui::Text("%s", FixedString{"high water: {}", format_bytes(stats.scratch.high_water)}.c_str());
+		ImGui::Text("%s", FixedString{"capacity: {}", format_bytes(stats.scratch.capacity)}.c_str());
+		ImGui::Text("%s", FixedString{"buffers: {}", stats.scratch.buffers}.c_str());
+	}
 	if (auto tn = TreeNode{"vram"}) {
 		ImGui::Text("%s", FixedString{"buffers: {}", format_bytes(graphics::Buffer::bytes_allocated())}.c_str());
 		ImGui::Text("%s", FixedString{"images: {}", format_bytes(graphics::Image::bytes_allocated())}.c_str());
@@ -72,9 +119,16 @@ auto EngineStats::draw_to(OpenWindow /*w*/) -> void {
 		for (auto type = FrameProfile::Type{}; type < FrameProfile::Type::eCOUNT_; type = FrameProfile::Type(int(type) + 1)) {
 			auto const ratio = frame_profile.profile[type] / frame_profile.frame_time;
 			auto const label = FrameProfile::to_string_v[type];
-			auto const overlay = FixedString{"{} ({:.0f}%)", label, ratio * 100.0f};
+			auto const cpu_ms = FDuration<std::milli>{frame_profile.profile[type]}.count();
+			auto overlay = FixedString{"{} ({:.0f}%) cpu: {:.2f}ms", label, ratio * 100.0f, cpu_ms};
+			if (FrameProfile::has_gpu_time(type)) {
+				overlay = FixedString{"{} ({:.0f}%) cpu: {:.2f}ms gpu: {:.2f}ms", label, ratio * 100.0f, cpu_ms,
+									  FDuration<std::milli>{frame_profile.gpu_profile[type]}.count()};
+			}
 			ImGui::ProgressBar(ratio, {-1.0f, 0.0f}, overlay.c_str());
 		}
+		ImGui::Text("%s", FixedString{"gpu frame: {:.2f}ms", FDuration<std::milli>{frame_profile.gpu_frame_time}.count()}.c_str());
+		ImGui::Text("%s", FixedString{"pipeline compile: {:.2f}ms", FDuration<std::milli>{frame_profile.pipeline_compile}.count()}.c_str());
 	}
 }
 
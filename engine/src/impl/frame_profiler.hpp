@@ -14,7 +14,21 @@ struct FrameProfiler {
 	Clock::time_point frame_start{};
 	std::optional<Type> previous_type{};
 
-	void start() { frame_start = Clock::now(); }
+	void start() {
+		frame_start = Clock::now();
+		auto& current = frame_profiles.get_current();
+		current.pipeline_compile = {};
+		current.gpu_profile = {};
+		current.gpu_frame_time = {};
+	}
+
+	void add_pipeline_compile(Duration const duration) { frame_profiles.get_current().pipeline_compile += duration; }
+
+	void set_gpu_profile(EnumArray<Type, Duration> const& gpu_profile, Duration const gpu_frame_time) {
+		auto& current = frame_profiles.get_current();
+		current.gpu_profile = gpu_profile;
+		current.gpu_frame_time = gpu_frame_time;
+	}
 
 	void profile(Type type) {
 		start_map[type] = stop_previous();
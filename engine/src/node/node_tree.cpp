@@ -1,7 +1,9 @@
 #include <le/core/logger.hpp>
+#include <le/core/mat4_batch.hpp>
 #include <le/error.hpp>
 #include <le/node/node_tree.hpp>
 #include <algorithm>
+#include <cassert>
 #include <format>
 #include <utility>
 
@@ -11,24 +13,33 @@ auto const g_log{logger::Logger{"NodeTree"}};
 }
 
 auto NodeTree::insert_or_assign(Id<Node> id, CreateInfo const& create_info) -> Node& {
-	auto node = Node{};
-	node.m_id = id;
-	m_next_id = std::max(m_next_id, id.value() + 1);
-	node.transform = create_info.transform;
-	node.entity_id = create_info.entity_id;
-	assert(!create_info.parent || node.m_id != *create_info.parent);
-	node.name = create_info.name.empty() ? "(Unnamed)" : create_info.name;
+	assert(!create_info.parent || id != *create_info.parent);
+	auto parent = null_index_v;
 	if (create_info.parent) {
-		if (auto it = m_nodes.find(*create_info.parent); it != m_nodes.end()) {
-			it->second.m_children.push_back(node.m_id);
-			node.m_parent = create_info.parent;
-		} else {
-			g_log.warn("Invalid parent Id<Node>: {}", create_info.parent->value());
-		}
+		parent = index_of(*create_info.parent);
+		if (parent == null_index_v) { g_log.warn("Invalid parent Id<Node>: {}", create_info.parent->value()); }
+	}
+	auto name = create_info.name.empty() ? std::string{"(Unnamed)"} : create_info.name;
+
+	if (auto* node = find(id)) {
+		node->transform = create_info.transform;
+		node->entity_id = create_info.entity_id;
+		rename(*node, std::move(name));
+		auto const new_parent = parent != null_index_v ? create_info.parent : std::nullopt;
+		if (node->m_parent != new_parent) { reparent(*node, new_parent); }
+		// reparenting may have reordered nodes.
+		return get(id);
+	}
+
+	auto node = make_node(id, {}, {.transform = create_info.transform, .name = std::move(name), .entity_id = create_info.entity_id});
+	m_next_id = std::max(m_next_id, id.value() + 1);
+	if (parent != null_index_v) {
+		m_nodes[parent].m_children.push_back(id);
+		node.m_parent = create_info.parent;
+	} else {
+		m_roots.push_back(id);
 	}
-	if (!node.m_parent) { m_roots.push_back(node.m_id); }
-	auto [it, _] = m_nodes.insert_or_assign(node.m_id, std::move(node));
-	return it->second;
+	return append(std::move(node), parent);
 }
 
 auto NodeTree::add(CreateInfo const& create_info) -> Node& { return insert_or_assign(m_next_id, create_info); }
@@ -39,35 +50,76 @@ void NodeTree::remove(Id<Node> id) {
 
 void NodeTree::reparent(Node& out, std::optional<Id<Node>> new_parent) {
 	assert(!new_parent || out.m_id != *new_parent);
+	auto const index = index_of(out);
+	auto parent = null_index_v;
+	if (new_parent) {
+		parent = index_of(*new_parent);
+		if (parent == null_index_v) {
+			g_log.warn("Invalid parent Id<Node>: {}", new_parent->value());
+			return;
+		}
+		for (auto ancestor = parent; ancestor != null_index_v; ancestor = m_parents[ancestor]) {
+			if (ancestor == index) {
+				g_log.warn("Cannot parent Id<Node>: {} to its descendant: {}", out.m_id.value(), new_parent->value());
+				return;
+			}
+		}
+	}
+
 	if ((!out.m_parent) && (new_parent)) { std::erase(m_roots, out.m_id); }
 	if ((out.m_parent) && (!new_parent)) { m_roots.push_back(out.m_id); }
 	remove_child_from_parent(out);
-	if (new_parent) {
-		if (auto* parent = find(*new_parent)) { parent->m_children.push_back(out.m_id); }
-	}
+	if (parent != null_index_v) { m_nodes[parent].m_children.push_back(out.m_id); }
 	out.m_parent = new_parent;
+	m_parents[index] = parent;
+	// restore parent-before-child order.
+	if (parent != null_index_v && parent > index) { sort_nodes(); }
+}
+
+void NodeTree::rename(Node& out, std::string name) {
+	if (out.m_name == name) { return; }
+	remove_name(out);
+	out.m_name = std::move(name);
+	add_name(out);
 }
 
-// NOLINTNEXTLINE
 auto NodeTree::global_transform(Node const& node) const -> glm::mat4 {
-	auto ret = node.transform.matrix();
-	if (!node.m_parent) { return ret; }
-	assert(*node.m_parent != node.id());
-	if (auto const* parent = find(*node.m_parent)) { return global_transform(*parent) * ret; }
-	return ret;
+	++m_epoch;
+	return resolve(index_of(node));
 }
 
 auto NodeTree::global_transform(Id<Node> id) const -> glm::mat4 {
-	auto const* node = find(id);
-	if (node == nullptr) { return glm::identity<glm::mat4>(); }
-	return global_transform(*node);
+	auto const index = index_of(id);
+	if (index == null_index_v) { return glm::identity<glm::mat4>(); }
+	++m_epoch;
+	return resolve(index);
+}
+
+auto NodeTree::global_transforms(std::span<Id<Node> const> ids, std::span<glm::mat4> out) const -> void {
+	assert(out.size() >= ids.size());
+	// ancestors shared between ids are validated once per call.
+	++m_epoch;
+	for (std::size_t i = 0; i < ids.size(); ++i) {
+		auto const index = index_of(ids[i]);
+		out[i] = index != null_index_v ? resolve(index) : glm::identity<glm::mat4>();
+	}
+}
+
+auto NodeTree::update_transforms() const -> void {
+	static_assert(null_index_v == mat4_batch::root_v);
+	++m_epoch;
+	// parents precede their children: every parent is revalidated by the time its children are visited,
+	// and dirty indices are in an order concatenate() can consume.
+	m_dirty.clear();
+	for (Index index = 0; index < m_nodes.size(); ++index) {
+		if (revalidate(index)) { m_dirty.push_back(index); }
+	}
+	mat4_batch::concatenate(m_locals, m_parents, m_dirty, m_globals);
 }
 
-// NOLINTNEXTLINE
 auto NodeTree::global_position(Node const& node) const -> glm::vec3 {
-	auto ret = node.transform.position();
-	if (!node.m_parent) { return ret; }
-	if (auto const* parent = find(*node.m_parent)) { return global_position(*parent) + ret; }
+	auto ret = glm::vec3{};
+	for (auto index = index_of(node); index != null_index_v; index = m_parents[index]) { ret += m_nodes[index].transform.position(); }
 	return ret;
 }
 
@@ -79,32 +131,36 @@ auto NodeTree::global_position(Id<Node> id) const -> glm::vec3 {
 
 void NodeTree::clear() {
 	m_nodes.clear();
+	m_parents.clear();
+	m_locals.clear();
+	m_globals.clear();
+	m_stamps.clear();
+	m_indices.clear();
+	m_names.clear();
 	m_roots.clear();
 }
 
 auto NodeTree::find_by_name(std::string_view name) const -> std::optional<Id<Node>> {
+	auto const ids = find_all_by_name(name);
+	if (ids.empty()) { return {}; }
+	return ids.front();
+}
+
+auto NodeTree::find_all_by_name(std::string_view name) const -> std::span<Id<Node> const> {
 	if (name.empty()) { return {}; }
-	for (auto const& [id, node] : m_nodes) {
-		if (node.name == name) { return id; }
-	}
+	if (auto it = m_names.find(name); it != m_names.end()) { return it->second; }
 	return {};
 }
 
 // NOLINTNEXTLINE
 auto NodeTree::import_tree(DataMap nodes, std::vector<Id<Node>> roots) -> void {
-	m_nodes.clear();
-	m_next_id = {};
+	auto in_nodes = std::vector<Node>{};
+	in_nodes.reserve(nodes.size());
 	for (auto& [id, data] : nodes) {
-		auto node = Node{};
-		node.m_id = data.id;
-		node.m_children = std::move(data.children);
+		auto& node = in_nodes.emplace_back(make_node(data.id, std::move(data.children), {.transform = data.transform, .name = std::move(data.name)}));
 		node.m_parent = data.parent;
-		node.transform = data.transform;
-		node.name = std::move(data.name);
-		m_nodes.insert_or_assign(id, std::move(node));
-		m_next_id = std::max(m_next_id, id + 1);
 	}
-	m_roots = std::move(roots);
+	assign(std::move(in_nodes), std::move(roots));
 }
 
 auto NodeTree::make_node(Id<Node> self, std::vector<Id<Node>> children, CreateInfo create_info) -> Node {
@@ -114,10 +170,195 @@ auto NodeTree::make_node(Id<Node> self, std::vector<Id<Node>> children, CreateIn
 	ret.m_children = std::move(children);
 	ret.entity_id = create_info.entity_id;
 	ret.transform = create_info.transform;
-	ret.name = std::move(create_info.name);
+	ret.m_name = std::move(create_info.name);
 	return ret;
 }
 
+auto NodeTree::index_of(Id<Node> id) const -> Index {
+	if (auto it = m_indices.find(id.value()); it != m_indices.end()) { return it->second; }
+	return null_index_v;
+}
+
+auto NodeTree::index_of(Node const& node) const -> Index {
+	assert(!m_nodes.empty() && &node >= m_nodes.data() && &node < m_nodes.data() + m_nodes.size());
+	return static_cast<Index>(&node - m_nodes.data());
+}
+
+auto NodeTree::assign(std::vector<Node> nodes, std::vector<Id<Node>> roots) -> void {
+	clear();
+	m_next_id = {};
+	m_nodes = std::move(nodes);
+	m_roots = std::move(roots);
+	for (Index index = 0; index < m_nodes.size(); ++index) {
+		auto const id = m_nodes[index].m_id.value();
+		m_indices.insert_or_assign(id, index);
+		m_next_id = std::max(m_next_id, id + 1);
+	}
+	sort_nodes();
+	for (auto const& node : m_nodes) { add_name(node); }
+}
+
+auto NodeTree::append(Node node, Index const parent) -> Node& {
+	assert(m_nodes.size() < null_index_v);
+	m_indices.insert_or_assign(node.m_id.value(), static_cast<Index>(m_nodes.size()));
+	m_parents.push_back(parent);
+	m_locals.push_back(glm::identity<glm::mat4>());
+	m_globals.push_back(glm::identity<glm::mat4>());
+	m_stamps.emplace_back();
+	add_name(node);
+	return m_nodes.emplace_back(std::move(node));
+}
+
+auto NodeTree::mark_removed(std::span<Id<Node> const> ids) -> bool {
+	m_removed.assign(m_nodes.size(), 0);
+	auto ret = false;
+	for (auto const id : ids) {
+		if (auto const index = index_of(id); index != null_index_v) {
+			m_removed[index] = 1;
+			ret = true;
+		}
+	}
+	if (!ret) { return false; }
+	// parents precede their children: a single pass marks every descendant.
+	for (Index index = 0; index < m_nodes.size(); ++index) {
+		if (auto const parent = m_parents[index]; parent != null_index_v && m_removed[parent] != 0) { m_removed[index] = 1; }
+	}
+	return true;
+}
+
+auto NodeTree::erase_removed() -> void {
+	auto const is_removed = [this](Id<Node> id) {
+		auto const index = index_of(id);
+		return index != null_index_v && m_removed[index] != 0;
+	};
+	std::erase_if(m_roots, is_removed);
+
+	// one pass per affected name: erasing removed nodes one by one is quadratic in the number sharing a name.
+	auto names = std::vector<NameIndex::iterator>{};
+	for (Index index = 0; index < m_nodes.size(); ++index) {
+		if (m_removed[index] == 0) { continue; }
+		if (auto const it = m_names.find(m_nodes[index].m_name); it != m_names.end()) { names.push_back(it); }
+	}
+	std::ranges::sort(names, {}, [](NameIndex::iterator const it) { return &it->second; });
+	names.erase(std::unique(names.begin(), names.end()), names.end());
+	for (auto const it : names) {
+		// preserves order of addition.
+		std::erase_if(it->second, is_removed);
+		if (it->second.empty()) { m_names.erase(it); }
+	}
+
+	// compact in place, preserving order.
+	auto remap = std::vector<Index>(m_nodes.size(), null_index_v);
+	auto count = Index{};
+	for (Index index = 0; index < m_nodes.size(); ++index) {
+		auto const parent = m_parents[index];
+		if (m_removed[index] != 0) {
+			if (parent != null_index_v && m_removed[parent] == 0) { std::erase(m_nodes[remap[parent]].m_children, m_nodes[index].m_id); }
+			m_indices.erase(m_nodes[index].m_id.value());
+			continue;
+		}
+		remap[index] = count;
+		if (count != index) {
+			m_nodes[count] = std::move(m_nodes[index]);
+			m_locals[count] = m_locals[index];
+			m_globals[count] = m_globals[index];
+			m_stamps[count] = m_stamps[index];
+			m_indices.insert_or_assign(m_nodes[count].m_id.value(), count);
+		}
+		m_parents[count] = parent != null_index_v ? remap[parent] : null_index_v;
+		++count;
+	}
+	m_nodes.resize(count);
+	m_parents.resize(count);
+	m_locals.resize(count);
+	m_globals.resize(count);
+	m_stamps.resize(count);
+	m_removed.clear();
+}
+
+auto NodeTree::sort_nodes() -> void {
+	auto const count = m_nodes.size();
+	auto order = std::vector<Index>{};
+	order.reserve(count);
+	auto visited = std::vector<std::uint8_t>(count);
+	auto stack = std::vector<Index>{};
+	// depth-first, pre-order: subtrees end up contiguous.
+	auto const visit = [&](Index const root) {
+		stack.push_back(root);
+		while (!stack.empty()) {
+			auto const index = stack.back();
+			stack.pop_back();
+			if (visited[index] != 0) { continue; }
+			visited[index] = 1;
+			order.push_back(index);
+			auto const children = m_nodes[index].children();
+			for (auto it = children.rbegin(); it != children.rend(); ++it) {
+				if (auto const child = index_of(*it); child != null_index_v && visited[child] == 0) { stack.push_back(child); }
+			}
+		}
+	};
+	for (auto const id : m_roots) {
+		if (auto const index = index_of(id); index != null_index_v) { visit(index); }
+	}
+	// nodes unreachable from the roots (eg imported): visit from their topmost unvisited ancestor.
+	for (Index index = 0; index < count; ++index) {
+		if (visited[index] != 0) { continue; }
+		auto top = index;
+		for (auto steps = count; steps > 0; --steps) {
+			auto const& parent_id = m_nodes[top].m_parent;
+			auto const parent = parent_id ? index_of(*parent_id) : null_index_v;
+			if (parent == null_index_v || visited[parent] != 0) { break; }
+			top = parent;
+		}
+		visit(top);
+	}
+
+	auto nodes = std::vector<Node>{};
+	nodes.reserve(count);
+	for (auto const index : order) { nodes.push_back(std::move(m_nodes[index])); }
+	m_nodes = std::move(nodes);
+	for (Index index = 0; index < count; ++index) { m_indices.insert_or_assign(m_nodes[index].m_id.value(), index); }
+	m_parents.assign(count, null_index_v);
+	for (Index index = 0; index < count; ++index) {
+		if (auto const& parent_id = m_nodes[index].m_parent) {
+			// inconsistent links (cycles, parents not listing their children) are treated as roots here.
+			if (auto const parent = index_of(*parent_id); parent < index) { m_parents[index] = parent; }
+		}
+	}
+	// recomputed on demand.
+	m_locals.assign(count, glm::identity<glm::mat4>());
+	m_globals.assign(count, glm::identity<glm::mat4>());
+	m_stamps.assign(count, {});
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+auto NodeTree::resolve(Index const index) const -> glm::mat4 const& {
+	if (m_stamps[index].epoch == m_epoch) { return m_globals[index]; }
+	if (auto const parent = m_parents[index]; parent != null_index_v) { resolve(parent); }
+	refresh(index);
+	return m_globals[index];
+}
+
+auto NodeTree::refresh(Index const index) const -> void {
+	if (!revalidate(index)) { return; }
+	auto const parent = m_parents[index];
+	m_globals[index] = parent != null_index_v ? m_globals[parent] * m_locals[index] : m_locals[index];
+}
+
+auto NodeTree::revalidate(Index const index) const -> bool {
+	auto& stamp = m_stamps[index];
+	stamp.epoch = m_epoch;
+	auto const& local = m_nodes[index].transform.matrix();
+	auto const parent = m_parents[index];
+	auto const parent_revision = parent != null_index_v ? m_stamps[parent].revision : std::uint64_t{};
+	// transforms may be assigned / modified directly: compare the local matrix instead of tracking writes.
+	if (stamp.revision != 0 && stamp.parent_revision == parent_revision && m_locals[index] == local) { return false; }
+	m_locals[index] = local;
+	stamp.parent_revision = parent_revision;
+	stamp.revision = ++m_revision;
+	return true;
+}
+
 void NodeTree::remove_child_from_parent(Node& out) {
 	if (!out.m_parent) { return; }
 	if (auto* parent = find(*out.m_parent)) {
@@ -126,9 +367,27 @@ void NodeTree::remove_child_from_parent(Node& out) {
 	}
 }
 
+auto NodeTree::add_name(Node const& node) -> void {
+	if (node.m_name.empty()) { return; }
+	if (auto it = m_names.find(node.m_name); it != m_names.end()) {
+		it->second.push_back(node.m_id);
+		return;
+	}
+	m_names.emplace(node.m_name, std::vector<Id<Node>>{node.m_id});
+}
+
+auto NodeTree::remove_name(Node const& node) -> void {
+	auto it = m_names.find(node.m_name);
+	if (it == m_names.end()) { return; }
+	// preserve order of addition.
+	std::erase(it->second, node.m_id);
+	if (it->second.empty()) { m_names.erase(it); }
+}
+
 auto NodeTree::find(Id<Node> id) const -> Ptr<Node const> {
-	if (auto it = m_nodes.find(id); it != m_nodes.end()) { return &it->second; }
-	return {};
+	auto const index = index_of(id);
+	if (index == null_index_v) { return {}; }
+	return &m_nodes[index];
 }
 
 // NOLINTNEXTLINE
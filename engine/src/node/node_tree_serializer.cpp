@@ -43,9 +43,9 @@ auto io::to_json(dj::Json& out, Transform const& transform) -> void { to_json(ou
 
 auto NodeTree::Serializer::serialize(dj::Json& out, NodeTree const& tree) -> void {
 	auto& out_nodes = out["nodes"];
-	for (auto const& [id, in_node] : tree.m_nodes) {
+	for (auto const& in_node : tree.m_nodes) {
 		auto out_node = dj::Json{};
-		out_node["name"] = in_node.name;
+		out_node["name"] = in_node.name();
 		io::to_json(out_node["transform"], in_node.transform);
 		out_node["id"] = in_node.id().value();
 		if (auto parent = in_node.parent()) { out_node["parent"] = parent.value().value(); }
@@ -62,6 +62,7 @@ auto NodeTree::Serializer::serialize(dj::Json& out, NodeTree const& tree) -> voi
 }
 
 auto NodeTree::Serializer::deserialize(dj::Json const& json, NodeTree& out) -> void {
+	auto nodes = std::vector<Node>{};
 	for (auto const& in_node : json["nodes"].array_view()) {
 		auto transform = Transform{};
 		io::from_json(in_node["transform"], transform);
@@ -73,10 +74,11 @@ auto NodeTree::Serializer::deserialize(dj::Json const& json, NodeTree& out) -> v
 		auto children = std::vector<Id<Node>>{};
 		for (auto const& in_child : in_node["children"].array_view()) { children.emplace_back(in_child.as<Id<Node>::id_type>()); }
 		auto const id = in_node["id"].as<std::size_t>();
-		out.m_nodes.insert_or_assign(id, make_node(id, std::move(children), std::move(nci)));
-		out.m_next_id = std::max(out.m_next_id, id);
+		nodes.push_back(make_node(id, std::move(children), std::move(nci)));
 	}
-	for (auto const& in_root : json["roots"].array_view()) { out.m_roots.emplace_back(in_root.as<std::size_t>()); }
+	auto roots = std::vector<Id<Node>>{};
+	for (auto const& in_root : json["roots"].array_view()) { roots.emplace_back(in_root.as<std::size_t>()); }
+	out.assign(std::move(nodes), std::move(roots));
 	out.m_next_id = std::max(out.m_next_id, json["max_id"].as<Id<Node>::id_type>());
 }
 } // namespace le
@@ -0,0 +1,82 @@
+#include <djson/json.hpp>
+#include <le/perf_capture.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace le {
+namespace {
+auto make_summary(std::vector<Duration> samples) -> PerfCapture::Summary {
+	if (samples.empty()) { return {}; }
+	std::ranges::sort(samples);
+	auto const p99 = static_cast<std::size_t>(std::ceil(0.99f * static_cast<float>(samples.size())));
+	return PerfCapture::Summary{
+		.median = samples[samples.size() / 2],
+		.p99 = samples[std::clamp(p99, std::size_t{1}, samples.size()) - 1],
+		.max = samples.back(),
+	};
+}
+
+auto to_json(dj::Json& out, PerfCapture::Summary const& summary) -> void {
+	using Ms = FDuration<std::milli>;
+	out["median_ms"] = Ms{summary.median}.count();
+	out["p99_ms"] = Ms{summary.p99}.count();
+	out["max_ms"] = Ms{summary.max}.count();
+}
+} // namespace
+
+PerfCapture::PerfCapture(std::uint64_t const frames, std::uint64_t const warmup) : m_frames(frames), m_warmup(warmup) {
+	m_profiles.reserve(static_cast<std::size_t>(frames));
+}
+
+auto PerfCapture::push(FrameProfile const& profile) -> bool {
+	if (m_warmup > 0) {
+		--m_warmup;
+		return false;
+	}
+	if (!is_complete()) { m_profiles.push_back(profile); }
+	return is_complete();
+}
+
+auto PerfCapture::summarize(FrameProfile::Type const type) const -> Summary {
+	auto samples = std::vector<Duration>{};
+	samples.reserve(m_profiles.size());
+	for (auto const& profile : m_profiles) { samples.push_back(profile.profile[type]); }
+	return make_summary(std::move(samples));
+}
+
+auto PerfCapture::summarize_gpu(FrameProfile::Type const type) const -> Summary {
+	auto samples = std::vector<Duration>{};
+	samples.reserve(m_profiles.size());
+	for (auto const& profile : m_profiles) { samples.push_back(profile.gpu_profile[type]); }
+	return make_summary(std::move(samples));
+}
+
+auto PerfCapture::summarize_frame_time() const -> Summary {
+	auto samples = std::vector<Duration>{};
+	samples.reserve(m_profiles.size());
+	for (auto const& profile : m_profiles) { samples.push_back(profile.frame_time); }
+	return make_summary(std::move(samples));
+}
+
+auto PerfCapture::summarize_pipeline_compile() const -> Summary {
+	auto samples = std::vector<Duration>{};
+	samples.reserve(m_profiles.size());
+	for (auto const& profile : m_profiles) { samples.push_back(profile.pipeline_compile); }
+	return make_summary(std::move(samples));
+}
+
+auto PerfCapture::write_json(char const* path) const -> bool {
+	auto json = dj::Json{};
+	json["frames"] = m_profiles.size();
+	to_json(json["frame_time"], summarize_frame_time());
+	to_json(json["pipeline_compile"], summarize_pipeline_compile());
+	auto& out_profile = json["profile"];
+	auto& out_gpu_profile = json["gpu_profile"];
+	for (std::size_t i = 0; i < std::size_t(FrameProfile::Type::eCOUNT_); ++i) {
+		auto const type = static_cast<FrameProfile::Type>(i);
+		to_json(out_profile[FrameProfile::to_string_v[type]], summarize(type));
+		if (FrameProfile::has_gpu_time(type)) { to_json(out_gpu_profile[FrameProfile::to_string_v[type]], summarize_gpu(type)); }
+	}
+	return json.to_file(path);
+}
+} // namespace le
@@ -1,10 +1,17 @@
 #include <le/core/visitor.hpp>
+#include <le/core/zip_ranges.hpp>
 #include <le/resources/animation_asset.hpp>
 #include <le/resources/bin_data.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <numeric>
 
 namespace le {
 namespace {
 constexpr auto bin_sign_v{BinSign{0xffff0001}};
+constexpr auto compressed_sign_v{BinSign{0xffff0002}};
 
 enum class SamplerType : std::uint8_t { eTranslate, eRotate, eScale };
 
@@ -15,6 +22,26 @@ struct SamplerHeader {
 	std::uint64_t count;
 };
 
+// cubic splines are followed by one Tangents per keyframe.
+template <typename T>
+auto has_tangents(T const& in) -> bool {
+	return in.interpolation == graphics::Interpolation::eCubicSpline && in.tangents.size() == in.keyframes.size();
+}
+
+// cubic splines without (matching) tangents are sampled linearly, and packed as such.
+template <typename T>
+auto packed_interpolation(T const& in) -> graphics::Interpolation {
+	if (in.interpolation == graphics::Interpolation::eCubicSpline && !has_tangents(in)) { return graphics::Interpolation::eLinear; }
+	return in.interpolation;
+}
+
+template <typename T>
+auto read_tangents(BinReader& out, T& in) -> bool {
+	if (in.interpolation != graphics::Interpolation::eCubicSpline) { return true; }
+	in.tangents.resize(in.keyframes.size());
+	return out.read(std::span{in.tangents});
+}
+
 struct BinChannel {
 	Id<Node>::id_type joint_id{};
 	std::variant<graphics::Animation::Translate, graphics::Animation::Rotate, graphics::Animation::Scale> storage{};
@@ -24,11 +51,12 @@ template <typename T>
 auto pack_channel(BinWriter& out, SamplerType type, Id<Node> const joint_id, T const& in) -> void {
 	auto const header = SamplerHeader{
 		.type = type,
-		.interpolation = in.interpolation,
+		.interpolation = packed_interpolation(in),
 		.joint_id = joint_id,
 		.count = in.keyframes.size(),
 	};
 	out.write(std::span{&header, 1}).write(std::span{in.keyframes});
+	if (has_tangents(in)) { out.write(std::span{in.tangents}); }
 }
 
 template <typename T>
@@ -36,7 +64,7 @@ auto channel_storage_from(BinReader& out, SamplerHeader const& header, BinChanne
 	auto ret = T{};
 	ret.interpolation = header.interpolation;
 	ret.keyframes.resize(header.count);
-	if (!out.read(std::span{ret.keyframes})) { return false; }
+	if (!out.read(std::span{ret.keyframes}) || !read_tangents(out, ret)) { return false; }
 	out_channel.storage = std::move(ret);
 	return true;
 }
@@ -61,6 +89,219 @@ auto pack_channel(BinWriter& out, graphics::Animation::Channel const& channel) -
 	};
 	std::visit(visitor, channel.storage);
 }
+
+// compressed layout: header, count timestamps (f32), count quantized values, [count tangents (raw)].
+struct CompressedHeader {
+	SamplerType type{};
+	graphics::Interpolation interpolation{};
+	std::array<std::uint8_t, 6> padding{};
+	std::uint64_t joint_id{};
+	std::uint64_t count{};
+	// quantization range of translations / scales, unused for rotations.
+	glm::vec3 origin{};
+	glm::vec3 extent{};
+};
+
+using Quantized = std::array<std::uint16_t, 3>;
+
+constexpr auto range_max_v{65535.0f};
+constexpr auto component_max_v{32767.0f};
+// all but the largest component of a unit quaternion lie in [-1/sqrt(2), 1/sqrt(2)].
+constexpr auto component_range_v{0.70710678f};
+
+auto to_array(glm::quat const& q) -> std::array<float, 4> { return {q.x, q.y, q.z, q.w}; }
+
+auto distance(glm::vec3 const& a, glm::vec3 const& b) -> float { return glm::length(a - b); }
+
+auto distance(glm::quat const& a, glm::quat const& b) -> float {
+	auto const lhs = to_array(a);
+	auto const rhs = to_array(b);
+	auto dot = 0.0f;
+	for (std::size_t i = 0; i < lhs.size(); ++i) { dot += lhs[i] * rhs[i]; }
+	// q and -q represent the same rotation.
+	auto const sign = dot < 0.0f ? -1.0f : 1.0f;
+	auto ret = 0.0f;
+	for (std::size_t i = 0; i < lhs.size(); ++i) { ret += (lhs[i] - sign * rhs[i]) * (lhs[i] - sign * rhs[i]); }
+	return std::sqrt(ret);
+}
+
+auto quantize(float const value, float const origin, float const extent) -> std::uint16_t {
+	if (extent <= 0.0f) { return 0; }
+	auto const normalized = std::clamp((value - origin) / extent, 0.0f, 1.0f);
+	return static_cast<std::uint16_t>(std::lround(normalized * range_max_v));
+}
+
+auto dequantize(std::uint16_t const value, float const origin, float const extent) -> float {
+	return origin + static_cast<float>(value) / range_max_v * extent;
+}
+
+// smallest three: the largest component is dropped (and made positive), its index stored in the top bits of the first two values.
+// the sign flip is stored in the top bit of the third value: cubic spline tangents are stored as is, and need the original sign.
+auto quantize(glm::quat const& rotation) -> Quantized {
+	auto const components = to_array(glm::normalize(rotation));
+	auto largest = std::size_t{};
+	for (std::size_t i = 1; i < components.size(); ++i) {
+		if (std::abs(components[i]) > std::abs(components[largest])) { largest = i; }
+	}
+	auto const sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+	auto ret = Quantized{};
+	auto out = ret.begin();
+	for (std::size_t i = 0; i < components.size(); ++i) {
+		if (i == largest) { continue; }
+		auto const normalized = std::clamp((sign * components[i] / component_range_v + 1.0f) * 0.5f, 0.0f, 1.0f);
+		*out++ = static_cast<std::uint16_t>(std::lround(normalized * component_max_v));
+	}
+	ret[0] = static_cast<std::uint16_t>(ret[0] | ((largest & 1) << 15));
+	ret[1] = static_cast<std::uint16_t>(ret[1] | ((largest >> 1) << 15));
+	if (sign < 0.0f) { ret[2] = static_cast<std::uint16_t>(ret[2] | (1 << 15)); }
+	return ret;
+}
+
+auto dequantize_rotation(Quantized const& value) -> glm::quat {
+	auto const largest = static_cast<std::size_t>((value[0] >> 15) | ((value[1] >> 15) << 1));
+	auto components = std::array<float, 4>{};
+	auto in = value.begin();
+	auto sum = 0.0f;
+	for (std::size_t i = 0; i < components.size(); ++i) {
+		if (i == largest) { continue; }
+		auto const normalized = static_cast<float>(*in++ & 0x7fff) / component_max_v;
+		components[i] = (normalized * 2.0f - 1.0f) * component_range_v;
+		sum += components[i] * components[i];
+	}
+	components[largest] = std::sqrt(std::max(1.0f - sum, 0.0f));
+	if ((value[2] >> 15) != 0) {
+		for (auto& component : components) { component = -component; }
+	}
+	return glm::normalize(glm::quat{components[3], components[0], components[1], components[2]});
+}
+
+// true if every keyframe strictly between first and last is reproduced by sampling [first, last] within tolerance.
+template <typename T>
+auto is_redundant(T const& in, std::size_t const first, std::size_t const last, float const tolerance) -> bool {
+	auto const& a = in.keyframes[first];
+	auto const& b = in.keyframes[last];
+	if (!(a.timestamp < b.timestamp)) { return false; }
+	for (auto i = first + 1; i < last; ++i) {
+		auto const& keyframe = in.keyframes[i];
+		if (in.interpolation == graphics::Interpolation::eStep) {
+			if (distance(a.value, keyframe.value) > tolerance) { return false; }
+			continue;
+		}
+		auto const t = (keyframe.timestamp - a.timestamp) / (b.timestamp - a.timestamp);
+		if (distance(graphics::lerp(a.value, b.value, t), keyframe.value) > tolerance) { return false; }
+	}
+	return true;
+}
+
+// greedily removes keyframes in constant / linear runs; the first and last keyframes are always kept (to preserve duration).
+// cubic spline keys are already sparse (and shaped by their tangents), and are all kept.
+template <typename T>
+auto reduce_keyframes(T const& in, float const tolerance) -> std::vector<std::size_t> {
+	auto ret = std::vector<std::size_t>{};
+	auto const size = in.keyframes.size();
+	if (size == 0) { return ret; }
+	if (has_tangents(in)) {
+		ret.resize(size);
+		std::iota(ret.begin(), ret.end(), std::size_t{});
+		return ret;
+	}
+	ret.push_back(0);
+	for (std::size_t i = 1; i + 1 < size; ++i) {
+		if (!is_redundant(in, ret.back(), i + 1, tolerance)) { ret.push_back(i); }
+	}
+	if (size > 1) { ret.push_back(size - 1); }
+	return ret;
+}
+
+template <typename T>
+auto pack_compressed(BinWriter& out, SamplerType type, Id<Node> const joint_id, T const& in, float const tolerance) -> void {
+	auto const indices = reduce_keyframes(in, tolerance);
+	auto header = CompressedHeader{
+		.type = type,
+		.interpolation = packed_interpolation(in),
+		.joint_id = joint_id,
+		.count = indices.size(),
+	};
+	auto timestamps = std::vector<float>{};
+	auto values = std::vector<Quantized>{};
+	timestamps.reserve(indices.size());
+	values.reserve(indices.size());
+	for (auto const index : indices) { timestamps.push_back(in.keyframes[index].timestamp.count()); }
+	if constexpr (std::same_as<typename T::value_type, glm::quat>) {
+		for (auto const index : indices) { values.push_back(quantize(in.keyframes[index].value)); }
+	} else {
+		if (!indices.empty()) {
+			auto lo = in.keyframes[indices.front()].value;
+			auto hi = lo;
+			for (auto const index : indices) {
+				auto const& value = in.keyframes[index].value;
+				lo = {std::min(lo.x, value.x), std::min(lo.y, value.y), std::min(lo.z, value.z)};
+				hi = {std::max(hi.x, value.x), std::max(hi.y, value.y), std::max(hi.z, value.z)};
+			}
+			header.origin = lo;
+			header.extent = hi - lo;
+		}
+		for (auto const index : indices) {
+			auto const& value = in.keyframes[index].value;
+			values.push_back({
+				quantize(value.x, header.origin.x, header.extent.x),
+				quantize(value.y, header.origin.y, header.extent.y),
+				quantize(value.z, header.origin.z, header.extent.z),
+			});
+		}
+	}
+	out.write(std::span{&header, 1}).write(std::span{timestamps}).write(std::span{values});
+	if (has_tangents(in)) { out.write(std::span{in.tangents}); }
+}
+
+auto pack_compressed(BinWriter& out, graphics::Animation::Channel const& channel, AnimationAsset::Compression const& compression) -> void {
+	auto const visitor = Visitor{
+		[&](graphics::Animation::Translate const& translate) {
+			pack_compressed(out, SamplerType::eTranslate, channel.joint_id, translate, compression.translation_tolerance);
+		},
+		[&](graphics::Animation::Rotate const& rotate) { pack_compressed(out, SamplerType::eRotate, channel.joint_id, rotate, compression.rotation_tolerance); },
+		[&](graphics::Animation::Scale const& scale) { pack_compressed(out, SamplerType::eScale, channel.joint_id, scale, compression.scale_tolerance); },
+	};
+	std::visit(visitor, channel.storage);
+}
+
+template <typename T>
+auto compressed_storage_from(BinReader& out, CompressedHeader const& header, BinChannel& out_channel) -> bool {
+	auto timestamps = std::vector<float>(header.count);
+	auto values = std::vector<Quantized>(header.count);
+	if (!out.read(std::span{timestamps}) || !out.read(std::span{values})) { return false; }
+	auto ret = T{};
+	ret.interpolation = header.interpolation;
+	ret.keyframes.reserve(header.count);
+	for (auto const [timestamp, value] : zip_ranges(timestamps, values)) {
+		auto& keyframe = ret.keyframes.emplace_back();
+		keyframe.timestamp = Duration{timestamp};
+		if constexpr (std::same_as<typename T::value_type, glm::quat>) {
+			keyframe.value = dequantize_rotation(value);
+		} else {
+			keyframe.value = {
+				dequantize(value[0], header.origin.x, header.extent.x),
+				dequantize(value[1], header.origin.y, header.extent.y),
+				dequantize(value[2], header.origin.z, header.extent.z),
+			};
+		}
+	}
+	if (!read_tangents(out, ret)) { return false; }
+	out_channel.storage = std::move(ret);
+	return true;
+}
+
+auto unpack_compressed(BinReader& out, BinChannel& out_channel) -> bool {
+	auto header = CompressedHeader{};
+	if (!out.read(std::span{&header, 1})) { return false; }
+	out_channel.joint_id = header.joint_id;
+	switch (header.type) {
+	case SamplerType::eTranslate: return compressed_storage_from<graphics::Animation::Translate>(out, header, out_channel);
+	case SamplerType::eRotate: return compressed_storage_from<graphics::Animation::Rotate>(out, header, out_channel);
+	case SamplerType::eScale: return compressed_storage_from<graphics::Animation::Scale>(out, header, out_channel);
+	default: return false;
+	}
+}
 } // namespace
 
 auto AnimationAsset::try_load(Uri const& uri) -> bool {
@@ -92,10 +333,20 @@ auto AnimationAsset::bin_pack_to(std::vector<std::byte>& out, graphics::Animatio
 	for (auto const& channel : animation.channels) { pack_channel(writer, channel); }
 }
 
+auto AnimationAsset::bin_pack_to(std::vector<std::byte>& out, graphics::Animation const& animation, Compression const& compression) -> void {
+	auto writer = BinWriter{out};
+	writer.write(std::span{&compressed_sign_v, 1});
+	auto count = static_cast<std::uint64_t>(animation.channels.size());
+	writer.write(std::span{&count, 1});
+	for (auto const& channel : animation.channels) { pack_compressed(writer, channel, compression); }
+}
+
 auto AnimationAsset::bin_unpack_from(std::span<std::byte const> bytes, graphics::Animation& out) -> bool {
 	auto reader = BinReader{bytes};
 	auto sign = BinSign{};
-	if (!reader.read(std::span{&sign, 1}) || sign != bin_sign_v) { return false; }
+	if (!reader.read(std::span{&sign, 1})) { return false; }
+	if (sign != bin_sign_v && sign != compressed_sign_v) { return false; }
+	auto const unpack = sign == compressed_sign_v ? &unpack_compressed : &unpack_channel;
 	auto count = std::uint64_t{};
 	if (!reader.read(std::span{&count, 1})) { return false; }
 	if (count == 0) { return true; }
@@ -104,7 +355,7 @@ auto AnimationAsset::bin_unpack_from(std::span<std::byte const> bytes, graphics:
 	auto const span = std::span{bin_channels}.subspan(offset);
 	out.channels.reserve(out.channels.size() + count);
 	for (auto& channel : span) {
-		if (!unpack_channel(reader, channel)) { return false; }
+		if (!unpack(reader, channel)) { return false; }
 		out.channels.push_back({channel.joint_id, std::move(channel.storage)});
 	}
 	return true;
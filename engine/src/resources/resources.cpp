@@ -1,4 +1,5 @@
 #include <le/core/logger.hpp>
+#include <le/core/profiler.hpp>
 #include <le/core/time.hpp>
 #include <le/resources/resources.hpp>
 
@@ -8,6 +9,7 @@ auto const g_log{logger::Logger{"Resources"}};
 }
 
 auto Resources::try_load(Uri const& uri, Asset& out) -> bool {
+	LE_PROFILE_SCOPE("Resources::try_load");
 	auto delta_time = DeltaTime{};
 	if (!out.try_load(uri)) {
 		g_log.error("failed to load {}: '{}'", out.type_name(), uri.value());
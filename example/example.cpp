@@ -14,6 +14,7 @@
 #include <le/scene/ui/text.hpp>
 #include <le/vfs/file_reader.hpp>
 #include <le/vfs/vfs.hpp>
+#include <span>
 
 namespace example {
 using namespace le;
@@ -180,7 +181,11 @@ class BrainStem : public Scene {
 	auto update_futures() -> void {
 		// check if MeshAsset future is valid and ready.
 		if (Resources::is_ready(m_mesh_future)) {
-			if (auto const* mesh_asset = m_mesh_future.get()) { spawn_mesh(&mesh_asset->mesh, m_loading_uri); }
+			if (auto const* mesh_asset = m_mesh_future.get()) {
+				// start compiling its pipelines in the background before the first draw.
+				graphics::Renderer::self().prewarm(mesh_asset->mesh);
+				spawn_mesh(&mesh_asset->mesh, m_loading_uri);
+			}
 			// reset loading modal.
 			m_loading_uri = {};
 		}
@@ -271,9 +276,28 @@ class App : public Runtime, public input::Receiver {
 
 auto main(int argc, char** argv) -> int {
 	if (argc < 1) { return EXIT_FAILURE; }
+	auto const args = std::span{argv, static_cast<std::size_t>(argc)};
 
 	try {
-		example::App{*argv}.run();
+		auto app = example::App{args[0]};
+		// '--perf-capture <frames>': render frames headless (no window / swapchain, eg on CI with lavapipe),
+		// with a fixed delta time and scripted input, and write per-stage timings to perf_capture.json.
+		if (args.size() > 2 && std::string_view{args[1]} == "--perf-capture") {
+			app.build_engine(le::Engine::Builder{"le-example"}.set_headless(true));
+			auto& engine = le::Engine::self();
+			engine.fixed_delta_time = le::Duration{1.0f / 60.0f};
+			engine.input_script = [](le::input::State& out, std::uint64_t const frame) {
+				// fly forwards with the freecam for the first half of every 240 frames.
+				auto const action = frame % 240 < 120 ? le::input::Action::eHold : le::input::Action::eNone;
+				out.mouse_buttons[GLFW_MOUSE_BUTTON_RIGHT] = action;
+				out.keyboard[GLFW_KEY_W] = action;
+			};
+			engine.start_capture(std::stoull(args[2]), 10);
+		}
+		app.run();
+		if (auto const* capture = le::Engine::self().get_capture()) {
+			if (!capture->write_json("perf_capture.json")) { example::g_log.error("failed to write perf_capture.json"); }
+		}
 	} catch (std::exception const& e) {
 		example::g_log.error("fatal error: {}", e.what());
 		return EXIT_FAILURE;
@@ -20,10 +20,18 @@ class MeshAnimator : public Component {
 	[[nodiscard]] auto get_animation() const -> Ptr<graphics::Animation const>;
 
 	Duration elapsed{};
+	///
+	/// \brief Multiplier for Scene::animation_lod tier distances (eg the size of the mesh).
+	///
+	float lod_scale{1.0f};
 
   protected:
 	Ptr<graphics::Skeleton const> m_skeleton{};
 	std::optional<Id<graphics::Animation>> m_active{};
 	NodeTree m_joint_tree{};
+	// active animation bound to m_joint_tree.
+	graphics::Animation::Binding m_binding{};
+	// time accumulated since the last update (throttled by animation LOD).
+	Duration m_pending{};
 };
 } // namespace le
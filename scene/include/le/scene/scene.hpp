@@ -1,4 +1,5 @@
 #pragma once
+#include <le/graphics/animation/animation_lod.hpp>
 #include <le/graphics/camera.hpp>
 #include <le/graphics/lights.hpp>
 #include <le/node/node_tree.hpp>
@@ -35,6 +36,7 @@ class Scene {
 
 	auto reparent(Entity& entity, Entity& parent) -> void;
 	auto unparent(Entity& entity) -> void;
+	auto rename(Entity& entity, std::string name) -> void;
 
 	[[nodiscard]] auto entity_count() const -> std::size_t { return m_entity_map.size(); }
 	auto clear_entities() -> void;
@@ -49,6 +51,10 @@ class Scene {
 	Ptr<graphics::Cubemap const> skybox{};
 
 	Collision collision{};
+	///
+	/// \brief Update rate tiers of MeshAnimators, centred on main_camera.
+	///
+	graphics::AnimationLod animation_lod{};
 
   private:
 	std::unordered_map<Id<Entity>::id_type, Entity> m_entity_map{};
@@ -60,6 +66,6 @@ class Scene {
 		std::vector<Ptr<Entity>> entities{};
 		mutable std::vector<NotNull<RenderComponent const*>> render_components{};
 	} m_active{};
-	std::vector<Id<Entity>> m_destroyed{};
+	std::vector<Id<Node>> m_destroyed{};
 };
 } // namespace le
@@ -15,6 +15,11 @@ class SceneRenderer {
 	explicit SceneRenderer();
 
 	auto render(Scene const& scene) -> graphics::RenderFrame;
+	///
+	/// \brief Enqueue background compilation of all pipelines required to render scene in its current state.
+	/// \returns Number of pipelines enqueued
+	///
+	auto prewarm(Scene const& scene) -> std::size_t;
 
   protected:
 	graphics::StaticPrimitive m_skybox_cube{};
@@ -1,3 +1,4 @@
+#include <le/core/profiler.hpp>
 #include <le/core/zip_ranges.hpp>
 #include <le/scene/collision.hpp>
 #include <le/scene/scene.hpp>
@@ -30,6 +31,7 @@ auto Collision::setup() -> void {
 }
 
 auto Collision::tick(Scene const& scene, Duration dt) -> void {
+	LE_PROFILE_SCOPE("Collision::tick");
 	auto colliders = std::vector<Ptr<Entry>>{};
 	for (auto it = m_entries.begin(); it != m_entries.end();) {
 		auto const* entity = scene.find_entity(it->first);
@@ -1,3 +1,4 @@
+#include <le/core/profiler.hpp>
 #include <le/scene/entity.hpp>
 #include <le/scene/scene.hpp>
 #include <algorithm>
@@ -11,6 +12,7 @@ auto Entity::get_node() -> Node& { return m_scene->make_node_locator().get(m_nod
 auto Entity::global_position() const -> glm::vec3 { return m_scene->get_node_tree().global_position(get_node()); }
 
 auto Entity::tick(Duration dt) -> void {
+	LE_PROFILE_SCOPE("Entity::tick");
 	m_cache.clear();
 	m_cache.reserve(m_components.size());
 	for (auto const& [_, comp] : m_components) { m_cache.push_back(comp.component.get()); }
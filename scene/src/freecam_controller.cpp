@@ -12,16 +12,13 @@ void FreecamController::tick(Duration dt) {
 	auto* window = Engine::self().get_window();
 	auto const& input = Engine::self().input_state();
 
-	if (input.mouse_buttons[GLFW_MOUSE_BUTTON_RIGHT] == input::Action::eHold) {
-		glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-	} else {
-		glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-	}
+	auto const is_looking = input.mouse_buttons[GLFW_MOUSE_BUTTON_RIGHT] == input::Action::eHold;
+	// headless engines have no window (input is scripted).
+	if (window != nullptr) { glfwSetInputMode(window, GLFW_CURSOR, is_looking ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL); }
 
 	auto dxy = glm::vec2{};
-	auto const input_mode = glfwGetInputMode(window, GLFW_CURSOR);
 
-	if (input_mode != GLFW_CURSOR_DISABLED) {
+	if (!is_looking) {
 		m_prev_cursor = input.cursor_position;
 	} else {
 		dxy = input.cursor_position - m_prev_cursor;
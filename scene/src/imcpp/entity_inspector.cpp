@@ -56,6 +56,7 @@ void inspect_component(OpenWindow /*w*/, MeshAnimator& animator) {
 		float const progress = animator.elapsed / animation->duration();
 		ImGui::ProgressBar(progress);
 	}
+	ImGui::DragFloat("LOD Scale", &animator.lod_scale, 0.05f, 0.0f, 100.0f);
 }
 
 void inspect_component(OpenWindow w, FreecamController& freecam_controller) {
@@ -84,8 +85,8 @@ auto inspect_if(OpenWindow w, Entity& out, char const* label) -> void {
 
 auto EntityInspector::inspect(OpenWindow w, Entity& out) -> void {
 	ImGui::Text("%s", FixedString{"{}", out.id().value()}.c_str());
-	auto& entity_name = get_entity_name(out.id(), out.get_node().name);
-	if (entity_name("Name")) { out.get_node().name = entity_name.view(); }
+	auto& entity_name = get_entity_name(out.id(), out.get_node().name());
+	if (entity_name("Name")) { out.get_scene().rename(out, std::string{entity_name.view()}); }
 	bool is_active{out.is_active()};
 	if (ImGui::Checkbox("Active", &is_active)) { out.set_active(is_active); }
 	if (auto tn = imcpp::TreeNode("Transform", ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_Framed)) {
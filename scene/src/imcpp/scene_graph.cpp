@@ -63,7 +63,7 @@ auto SceneGraph::walk_node(Node& node) -> bool {
 	flags |= (ImGuiTreeNodeFlags_SpanFullWidth | ImGuiTreeNodeFlags_OpenOnArrow);
 	if (node.entity_id && m_scene_inspector.target == node.entity_id) { flags |= ImGuiTreeNodeFlags_Selected; }
 	if (node.children().empty()) { flags |= ImGuiTreeNodeFlags_Leaf; }
-	auto tn = imcpp::TreeNode{node.name.c_str(), flags};
+	auto tn = imcpp::TreeNode{node.name().c_str(), flags};
 	if (node.entity_id) {
 		auto target = SceneInspector::Target{.payload = *node.entity_id};
 		if (ImGui::IsItemClicked()) { m_scene_inspector.target = target; }
@@ -1,17 +1,39 @@
+#include <le/core/profiler.hpp>
 #include <le/scene/mesh_animator.hpp>
 #include <le/scene/mesh_renderer.hpp>
 #include <le/scene/scene.hpp>
+#include <cmath>
+#include <utility>
 
 namespace le {
 auto MeshAnimator::tick(Duration dt) -> void {
+	LE_PROFILE_SCOPE("MeshAnimator::tick");
 	if (m_skeleton == nullptr) { return; }
 
 	if (!m_active) { return; }
 
 	auto const& animation = m_skeleton->animations[*m_active];
-	elapsed += dt;
-	animation->update(m_joint_tree, elapsed);
-	if (elapsed >= animation->duration()) { elapsed = {}; }
+	auto const& lod = get_scene().animation_lod;
+	if (m_binding.animation == animation) {
+		auto const interval = lod.get_interval(get_entity().global_position(), lod_scale);
+		// paused: time is frozen.
+		if (interval == 0) { return; }
+		m_pending += dt;
+		// throttled: advance by all the time since the last update.
+		if (!lod.is_update_frame(interval, get_entity().id().value())) { return; }
+	} else {
+		// always sampled once (replacing the bind pose).
+		m_binding = animation->bind(m_joint_tree);
+		m_pending += dt;
+	}
+	elapsed += std::exchange(m_pending, {});
+	if (auto const duration = animation->duration(); elapsed >= duration) {
+		// loop, keeping the overshoot (throttled updates can span multiple loops).
+		elapsed = duration > Duration{} ? Duration{std::fmod(elapsed.count(), duration.count())} : Duration{};
+		m_binding.reset_cursors();
+	}
+	m_binding.update(elapsed);
+	m_joint_tree.update_transforms();
 
 	auto* mesh_renderer = get_entity().find_component<MeshRenderer>();
 	if (mesh_renderer == nullptr) { return; }
@@ -23,6 +45,9 @@ auto MeshAnimator::set_skeleton(NotNull<graphics::Skeleton const*> skeleton, std
 	m_skeleton = skeleton;
 	m_joint_tree = skeleton->joint_tree;
 	if (!id || *id < m_skeleton->animations.size()) { m_active = id; }
+	// bound to the previous joint tree.
+	m_binding = {};
+	m_pending = {};
 }
 
 auto MeshAnimator::get_animations() const -> std::span<Ptr<graphics::Animation const> const> {
@@ -33,7 +58,8 @@ auto MeshAnimator::get_animations() const -> std::span<Ptr<graphics::Animation c
 auto MeshAnimator::set_animation_id(Id<graphics::Animation> index) -> bool {
 	if (m_skeleton == nullptr || index >= m_skeleton->animations.size()) { return false; }
 	m_active = index;
-	elapsed = {};
+	elapsed = m_pending = {};
+	m_binding.reset_cursors();
 	return true;
 }
 
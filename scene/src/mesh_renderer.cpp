@@ -1,6 +1,7 @@
-#include <le/core/enumerate.hpp>
+#include <le/core/mat4_batch.hpp>
 #include <le/scene/mesh_renderer.hpp>
 #include <le/scene/scene.hpp>
+#include <algorithm>
 
 namespace le {
 auto MeshRenderer::set_mesh(NotNull<graphics::Mesh const*> mesh) -> void {
@@ -10,10 +11,12 @@ auto MeshRenderer::set_mesh(NotNull<graphics::Mesh const*> mesh) -> void {
 
 auto MeshRenderer::update_joints(NodeLocator node_locator) -> void {
 	if (m_mesh == nullptr || m_mesh->skeleton == nullptr) { return; }
-	m_joint_matrices.resize(m_mesh->skeleton->ordered_joint_ids.size(), glm::mat4{1.0f});
-	for (auto const [id, index] : enumerate(m_mesh->skeleton->ordered_joint_ids)) {
-		m_joint_matrices[index] = node_locator.global_transform(node_locator.get(id)) * m_mesh->skeleton->inverse_bind_matrices[index];
-	}
+	auto const& skeleton = *m_mesh->skeleton;
+	m_joint_matrices.resize(skeleton.ordered_joint_ids.size(), glm::mat4{1.0f});
+	node_locator.global_transforms(skeleton.ordered_joint_ids, m_joint_matrices);
+	auto const count = std::min(m_joint_matrices.size(), skeleton.inverse_bind_matrices.size());
+	auto const joints = std::span{m_joint_matrices}.first(count);
+	mat4_batch::multiply(joints, skeleton.inverse_bind_matrices, joints);
 }
 
 auto MeshRenderer::render_to(std::vector<graphics::RenderObject>& out) const -> void {
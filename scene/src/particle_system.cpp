@@ -1,3 +1,4 @@
+#include <le/core/profiler.hpp>
 #include <le/scene/particle_system.hpp>
 #include <le/scene/scene.hpp>
 
@@ -7,6 +8,7 @@ auto ParticleSystem::respawn_all() -> void {
 }
 
 auto ParticleSystem::tick(Duration dt) -> void {
+	LE_PROFILE_SCOPE("ParticleSystem::tick");
 	for (auto& emitter : emitters) { emitter.update(get_scene().main_camera.view(), dt); }
 }
 
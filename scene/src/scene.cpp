@@ -1,3 +1,4 @@
+#include <le/core/profiler.hpp>
 #include <le/engine.hpp>
 #include <le/error.hpp>
 #include <le/scene/scene.hpp>
@@ -40,6 +41,8 @@ auto Scene::reparent(Entity& entity, Entity& parent) -> void { m_node_tree.repar
 
 auto Scene::unparent(Entity& entity) -> void { m_node_tree.reparent(entity.get_node(), {}); }
 
+auto Scene::rename(Entity& entity, std::string name) -> void { m_node_tree.rename(entity.get_node(), std::move(name)); }
+
 auto Scene::clear_entities() -> void {
 	m_entity_map.clear();
 	m_node_tree.clear();
@@ -54,6 +57,7 @@ auto Scene::setup() -> void {
 }
 
 auto Scene::tick(Duration dt) -> void {
+	LE_PROFILE_SCOPE("Scene::tick");
 	// clear cache
 	m_active.entities.clear();
 	m_destroyed.clear();
@@ -66,26 +70,33 @@ auto Scene::tick(Duration dt) -> void {
 
 	// sort by order of spawning
 	std::ranges::sort(m_active.entities, [](Ptr<Entity const> a, Ptr<Entity const> b) { return a->id() < b->id(); });
+	animation_lod.origin = main_camera.transform.position();
+	animation_lod.next_frame();
+
 	// tick
-	for (auto* entity : m_active.entities) { entity->tick(dt); }
+	{
+		LE_PROFILE_SCOPE("Scene::tick_entities");
+		for (auto* entity : m_active.entities) { entity->tick(dt); }
+	}
 
-	// cache destroyed entity IDs
+	// cache destroyed entities' node IDs
 	for (auto& [id, entity] : m_entity_map) {
 		if (entity.is_destroyed()) {
-			m_destroyed.emplace_back(id);
+			m_destroyed.emplace_back(entity.node_id());
 			continue;
 		}
 	}
 
-	// remove destroyed nodes, children, and their entities
+	// remove destroyed nodes, children, and their entities (in one pass over the node tree)
 	auto const destroy_entity = [this](Node const& node) { m_entity_map.erase(*node.entity_id); };
-	for (auto const destroyed : m_destroyed) {
-		auto const& entity = m_entity_map.at(destroyed);
-		m_node_tree.remove(entity.node_id(), destroy_entity);
-	}
+	m_node_tree.remove(m_destroyed, destroy_entity);
+	m_node_tree.update_transforms();
 
 	m_ui_root.transform.extent = Engine::self().framebuffer_extent();
-	m_ui_root.tick(dt);
+	{
+		LE_PROFILE_SCOPE("Scene::tick_ui");
+		m_ui_root.tick(dt);
+	}
 
 	collision.tick(*this, dt);
 }
@@ -102,7 +113,11 @@ auto Scene::render_entities(std::vector<graphics::RenderObject>& out) const -> v
 	// sort render components in order of layers (since render_entities() is const)
 	std::ranges::sort(m_active.render_components, [](Ptr<RenderComponent const> a, Ptr<RenderComponent const> b) { return a->render_layer < b->render_layer; });
 
-	for (auto const& render_component : m_active.render_components) { render_component->render_to(out); }
+	for (auto const& render_component : m_active.render_components) {
+		auto const first = out.size();
+		render_component->render_to(out);
+		for (auto& object : std::span{out}.subspan(first)) { object.layer = static_cast<std::int32_t>(render_component->render_layer); }
+	}
 
 	// render collision AABBs
 	collision.render_to(out);
@@ -22,6 +22,8 @@ auto SceneManager::tick(Duration dt) -> void {
 		m_switcher.m_active = std::move(m_switcher.m_standby);
 		g_log.debug("Setting up Scene...");
 		m_switcher.m_active->setup();
+		auto const prewarmed = m_renderer->prewarm(*m_switcher.m_active);
+		g_log.debug("Compiling [{}] pipelines in the background", prewarmed);
 		g_log.debug("... Scene switched");
 		// reset dt, it isn't valid for a new scene
 		dt = {};
@@ -1,4 +1,6 @@
+#include <le/graphics/renderer.hpp>
 #include <le/scene/scene_renderer.hpp>
+#include <limits>
 
 namespace le {
 SceneRenderer::SceneRenderer() {
@@ -16,6 +18,7 @@ auto SceneRenderer::render(Scene const& scene) -> graphics::RenderFrame {
 			.material = &m_skybox_mat,
 			.primitive = &m_skybox_cube,
 			.pipeline_state = m_skybox_pipeline,
+			.layer = std::numeric_limits<std::int32_t>::min(),
 		});
 	}
 	scene.render_entities(m_scene_objects);
@@ -28,4 +31,6 @@ auto SceneRenderer::render(Scene const& scene) -> graphics::RenderFrame {
 		.ui = m_ui_objects,
 	};
 }
+
+auto SceneRenderer::prewarm(Scene const& scene) -> std::size_t { return graphics::Renderer::self().prewarm(render(scene)); }
 } // namespace le
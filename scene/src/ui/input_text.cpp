@@ -85,7 +85,9 @@ auto InputText::goto_end() -> void {
 }
 
 auto InputText::paste_clipboard() -> void {
-	if (auto const* str = glfwGetClipboardString(Engine::self().get_window())) { write(str); }
+	auto* window = Engine::self().get_window();
+	if (window == nullptr) { return; }
+	if (auto const* str = glfwGetClipboardString(window)) { write(str); }
 }
 
 auto InputText::on_key(int key, int action, int mods) -> bool {
@@ -0,0 +1,30 @@
+#version 450 core
+#extension GL_EXT_nonuniform_qualifier : require
+
+struct Material {
+	vec4 albedo;
+	vec4 m_r_aco_am;
+	vec4 emissive;
+	uvec4 textures;
+};
+
+layout (set = 3, binding = 0) uniform sampler2D textures[];
+
+layout (set = 3, binding = 1) readonly buffer Materials {
+	Material materials[];
+};
+
+layout (push_constant) uniform PC {
+	uint material_index;
+};
+
+layout (location = 0) in vec4 in_rgba;
+layout (location = 1) in vec2 in_uv;
+layout (location = 2) in vec4 in_frag_pos;
+
+layout (location = 0) out vec4 out_rgba;
+
+void main() {
+	out_rgba = in_rgba * texture(textures[materials[material_index].textures.x], in_uv);
+	if (out_rgba.w <= 0.0) { discard; }
+}
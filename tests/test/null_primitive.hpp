@@ -0,0 +1,12 @@
+#pragma once
+#include <le/graphics/primitive.hpp>
+
+namespace test {
+///
+/// \brief Primitive without any GPU resources, for tests / benchmarks that only need its address.
+///
+struct NullPrimitive : le::graphics::Primitive {
+	auto set_geometry(le::graphics::Geometry const& /*geometry*/) -> void final {}
+	auto draw(std::uint32_t /*instances*/, vk::CommandBuffer /*cmd*/) const -> void final {}
+};
+} // namespace test
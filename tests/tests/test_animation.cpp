@@ -0,0 +1,65 @@
+#include <le/graphics/animation/animation.hpp>
+#include <test/test.hpp>
+#include <array>
+
+namespace {
+using namespace le;
+using namespace le::graphics;
+
+auto make_animation(std::span<Id<Node> const> joints) -> Animation {
+	auto ret = Animation{};
+	for (std::size_t i = 0; i < joints.size(); ++i) {
+		auto const offset = static_cast<float>(i);
+		auto translate = Animation::Translate{};
+		auto rotate = Animation::Rotate{};
+		auto scale = Animation::Scale{};
+		for (std::size_t k = 0; k < 8; ++k) {
+			auto const key = static_cast<float>(k);
+			auto const timestamp = Duration{0.25f * (key + 1.0f)};
+			translate.keyframes.push_back({.value = {offset, key, -key}, .timestamp = timestamp});
+			rotate.keyframes.push_back({.value = glm::angleAxis(0.2f * key + offset, glm::vec3{0.0f, 1.0f, 0.0f}), .timestamp = timestamp});
+			scale.keyframes.push_back({.value = glm::vec3{1.0f + 0.1f * key}, .timestamp = timestamp});
+		}
+		// interleaved types, as imported.
+		ret.channels.push_back({.joint_id = joints[i], .storage = rotate});
+		ret.channels.push_back({.joint_id = joints[i], .storage = translate});
+		if (i % 2 == 0) { ret.channels.push_back({.joint_id = joints[i], .storage = scale}); }
+	}
+	return ret;
+}
+
+ADD_TEST(AnimationBindingMatchesUpdate) {
+	auto tree = NodeTree{};
+	auto joints = std::array<Id<Node>, 4>{0, 0, 0, 0};
+	auto parent = std::optional<Id<Node>>{};
+	for (auto& joint : joints) {
+		joint = tree.add({.parent = parent}).id();
+		parent = joint;
+	}
+	auto animation = make_animation(joints);
+	// targets a missing node: dropped by bind().
+	animation.channels.push_back({.joint_id = 42, .storage = Animation::Translate{}});
+
+	auto bound_tree = tree;
+	auto binding = animation.bind(bound_tree);
+	EXPECT(binding.animation == &animation);
+	EXPECT(binding.translations.size() == joints.size());
+	EXPECT(binding.rotations.size() == joints.size());
+	EXPECT(binding.scales.size() == joints.size() / 2);
+
+	for (auto time = Duration{}; time < Duration{2.5f}; time += Duration{0.1f}) {
+		animation.update(tree, time);
+		binding.update(time);
+		for (auto const joint : joints) {
+			EXPECT(bound_tree.get(joint).transform.matrix() == tree.get(joint).transform.matrix());
+			EXPECT(bound_tree.global_transform(joint) == tree.global_transform(joint));
+		}
+	}
+
+	// rewind.
+	binding.reset_cursors();
+	animation.update(tree, Duration{0.3f});
+	binding.update(Duration{0.3f});
+	for (auto const joint : joints) { EXPECT(bound_tree.get(joint).transform.matrix() == tree.get(joint).transform.matrix()); }
+}
+} // namespace
@@ -0,0 +1,191 @@
+#include <le/resources/animation_asset.hpp>
+#include <test/test.hpp>
+#include <cmath>
+#include <numbers>
+
+namespace {
+using namespace le;
+using namespace le::graphics;
+
+constexpr std::size_t key_count_v{120};
+constexpr auto key_interval_v{Duration{1.0f / 30.0f}};
+
+auto key_time(std::size_t const index) -> Duration { return static_cast<float>(index) * key_interval_v; }
+
+auto make_animation(Interpolation const interpolation) -> Animation {
+	auto translate = Animation::Translate{};
+	auto rotate = Animation::Rotate{};
+	auto scale = Animation::Scale{};
+	translate.interpolation = rotate.interpolation = scale.interpolation = interpolation;
+	for (std::size_t i = 0; i < key_count_v; ++i) {
+		auto const t = static_cast<float>(i) / static_cast<float>(key_count_v);
+		// curved path, full revolution, constant scale.
+		translate.keyframes.push_back({.value = {10.0f * std::sin(t * 6.0f), -2.0f + 4.0f * t, 0.5f * std::cos(t * 3.0f)}, .timestamp = key_time(i)});
+		auto const angle = t * 2.0f * std::numbers::pi_v<float>;
+		rotate.keyframes.push_back({.value = glm::angleAxis(angle, glm::normalize(glm::vec3{1.0f, t, -0.5f})), .timestamp = key_time(i)});
+		scale.keyframes.push_back({.value = glm::vec3{2.0f}, .timestamp = key_time(i)});
+	}
+	auto ret = Animation{};
+	ret.channels.push_back({.joint_id = 1, .storage = translate});
+	ret.channels.push_back({.joint_id = 2, .storage = rotate});
+	ret.channels.push_back({.joint_id = 3, .storage = scale});
+	return ret;
+}
+
+auto error(glm::vec3 const& a, glm::vec3 const& b) -> float { return glm::length(a - b); }
+
+auto error(glm::quat const& a, glm::quat const& b) -> float {
+	// q and -q represent the same rotation.
+	auto const sign = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w < 0.0f ? -1.0f : 1.0f;
+	return glm::length(glm::vec4{a.x - sign * b.x, a.y - sign * b.y, a.z - sign * b.z, a.w - sign * b.w});
+}
+
+template <typename T>
+auto max_error(Animation::Channel const& lhs, Animation::Channel const& rhs) -> float {
+	auto const* a = std::get_if<T>(&lhs.storage);
+	auto const* b = std::get_if<T>(&rhs.storage);
+	if (a == nullptr || b == nullptr || lhs.joint_id != rhs.joint_id || a->interpolation != b->interpolation) { return 1000.0f; }
+	if (a->duration() != b->duration()) { return 1000.0f; }
+	auto ret = 0.0f;
+	// sample at and between keyframes.
+	for (std::size_t i = 0; i < 2 * key_count_v; ++i) {
+		auto const time = 0.5f * static_cast<float>(i) * key_interval_v;
+		ret = std::max(ret, error(*(*a)(time), *(*b)(time)));
+	}
+	return ret;
+}
+
+template <typename T>
+auto key_count(Animation::Channel const& channel) -> std::size_t {
+	return std::get<T>(channel.storage).keyframes.size();
+}
+
+ADD_TEST(AnimationAssetRawRoundTrip) {
+	auto const animation = make_animation(Interpolation::eLinear);
+	auto bytes = std::vector<std::byte>{};
+	AnimationAsset::bin_pack_to(bytes, animation);
+	auto out = Animation{};
+	ASSERT(AnimationAsset::bin_unpack_from(bytes, out));
+	ASSERT(out.channels.size() == animation.channels.size());
+	EXPECT(max_error<Animation::Translate>(out.channels[0], animation.channels[0]) == 0.0f);
+	EXPECT(max_error<Animation::Rotate>(out.channels[1], animation.channels[1]) == 0.0f);
+	EXPECT(max_error<Animation::Scale>(out.channels[2], animation.channels[2]) == 0.0f);
+}
+
+ADD_TEST(AnimationAssetCompressedRoundTrip) {
+	for (auto const interpolation : {Interpolation::eLinear, Interpolation::eStep}) {
+		auto const animation = make_animation(interpolation);
+		auto raw = std::vector<std::byte>{};
+		AnimationAsset::bin_pack_to(raw, animation);
+		auto const compression = AnimationAsset::Compression{};
+		auto bytes = std::vector<std::byte>{};
+		AnimationAsset::bin_pack_to(bytes, animation, compression);
+		EXPECT(bytes.size() < raw.size() / 2);
+
+		auto out = Animation{};
+		ASSERT(AnimationAsset::bin_unpack_from(bytes, out));
+		ASSERT(out.channels.size() == animation.channels.size());
+		EXPECT(out.duration() == animation.duration());
+
+		// range quantization (16 bits over a ~20 unit extent) plus the reduction tolerance.
+		EXPECT(max_error<Animation::Translate>(out.channels[0], animation.channels[0]) < 0.001f);
+		// smallest three: 15 bits per component.
+		EXPECT(max_error<Animation::Rotate>(out.channels[1], animation.channels[1]) < 0.001f);
+		EXPECT(max_error<Animation::Scale>(out.channels[2], animation.channels[2]) < 0.0001f);
+
+		// constant channels are reduced to their end points.
+		EXPECT(key_count<Animation::Scale>(out.channels[2]) == 2);
+	}
+}
+
+ADD_TEST(AnimationAssetCompressedLinearKeys) {
+	auto translate = Animation::Translate{};
+	auto rotate = Animation::Rotate{};
+	for (std::size_t i = 0; i < key_count_v; ++i) {
+		auto const t = static_cast<float>(i) / static_cast<float>(key_count_v - 1);
+		translate.keyframes.push_back({.value = glm::vec3{-3.0f, 1.0f, 7.0f} * t, .timestamp = key_time(i)});
+		rotate.keyframes.push_back({.value = glm::angleAxis(t * 2.0f, glm::vec3{0.0f, 1.0f, 0.0f}), .timestamp = key_time(i)});
+	}
+	// a single kink in an otherwise linear path.
+	translate.keyframes[60].value.y += 1.0f;
+	auto animation = Animation{};
+	animation.channels.push_back({.joint_id = 1, .storage = translate});
+	animation.channels.push_back({.joint_id = 2, .storage = rotate});
+
+	auto bytes = std::vector<std::byte>{};
+	AnimationAsset::bin_pack_to(bytes, animation, {});
+	auto out = Animation{};
+	ASSERT(AnimationAsset::bin_unpack_from(bytes, out));
+	ASSERT(out.channels.size() == 2);
+	EXPECT(key_count<Animation::Translate>(out.channels[0]) == 5);
+	EXPECT(key_count<Animation::Rotate>(out.channels[1]) == 2);
+	EXPECT(max_error<Animation::Translate>(out.channels[0], animation.channels[0]) < 0.001f);
+	EXPECT(max_error<Animation::Rotate>(out.channels[1], animation.channels[1]) < 0.001f);
+}
+
+ADD_TEST(AnimationAssetCubicSpline) {
+	auto translate = Animation::Translate{};
+	auto rotate = Animation::Rotate{};
+	translate.interpolation = rotate.interpolation = Interpolation::eCubicSpline;
+	for (std::size_t i = 0; i < 8; ++i) {
+		auto const t = static_cast<float>(i);
+		translate.keyframes.push_back({.value = {t, -t, 2.0f * t}, .timestamp = key_time(i * 15)});
+		translate.tangents.push_back({.in = {1.0f, t, 0.0f}, .out = {-1.0f, 0.5f * t, 3.0f}});
+		rotate.keyframes.push_back({.value = glm::angleAxis(0.5f * t, glm::vec3{0.0f, 0.0f, 1.0f}), .timestamp = key_time(i * 15)});
+		rotate.tangents.push_back({.in = glm::quat{0.0f, 0.1f, 0.0f, t}, .out = glm::quat{0.0f, 0.1f, 0.0f, -t}});
+	}
+	auto animation = Animation{};
+	animation.channels.push_back({.joint_id = 1, .storage = translate});
+	animation.channels.push_back({.joint_id = 2, .storage = rotate});
+
+	auto raw = std::vector<std::byte>{};
+	AnimationAsset::bin_pack_to(raw, animation);
+	auto out = Animation{};
+	ASSERT(AnimationAsset::bin_unpack_from(raw, out));
+	ASSERT(out.channels.size() == 2);
+	EXPECT(std::get<Animation::Translate>(out.channels[0].storage).tangents.size() == 8);
+	EXPECT(max_error<Animation::Translate>(out.channels[0], animation.channels[0]) == 0.0f);
+	EXPECT(max_error<Animation::Rotate>(out.channels[1], animation.channels[1]) == 0.0f);
+
+	// all keys are kept, tangents are stored as is.
+	auto bytes = std::vector<std::byte>{};
+	AnimationAsset::bin_pack_to(bytes, animation, {});
+	out = {};
+	ASSERT(AnimationAsset::bin_unpack_from(bytes, out));
+	ASSERT(out.channels.size() == 2);
+	EXPECT(key_count<Animation::Translate>(out.channels[0]) == 8);
+	EXPECT(key_count<Animation::Rotate>(out.channels[1]) == 8);
+	EXPECT(max_error<Animation::Translate>(out.channels[0], animation.channels[0]) < 0.001f);
+	EXPECT(max_error<Animation::Rotate>(out.channels[1], animation.channels[1]) < 0.001f);
+}
+
+ADD_TEST(AnimationAssetCubicSplineNegative) {
+	// largest component (w) is negative: the smallest three encoding must preserve the sign for tangents to apply.
+	auto rotate = Animation::Rotate{};
+	rotate.interpolation = Interpolation::eCubicSpline;
+	for (std::size_t i = 0; i < 8; ++i) {
+		auto const t = static_cast<float>(i);
+		auto const value = -glm::angleAxis(0.2f * t, glm::vec3{0.0f, 1.0f, 0.0f});
+		rotate.keyframes.push_back({.value = value, .timestamp = key_time(i * 15)});
+		rotate.tangents.push_back({.in = glm::quat{-0.5f, 0.0f, 0.2f, 0.0f}, .out = glm::quat{-0.5f, 0.0f, 0.2f, 0.0f}});
+	}
+	ASSERT(rotate.keyframes.front().value.w < -0.9f);
+	auto animation = Animation{};
+	animation.channels.push_back({.joint_id = 1, .storage = rotate});
+
+	auto bytes = std::vector<std::byte>{};
+	AnimationAsset::bin_pack_to(bytes, animation, {});
+	auto out = Animation{};
+	ASSERT(AnimationAsset::bin_unpack_from(bytes, out));
+	ASSERT(out.channels.size() == 1);
+	EXPECT(max_error<Animation::Rotate>(out.channels[0], animation.channels[0]) < 0.001f);
+}
+
+ADD_TEST(AnimationAssetCompressedInvalid) {
+	auto bytes = std::vector<std::byte>{};
+	AnimationAsset::bin_pack_to(bytes, make_animation(Interpolation::eLinear), {});
+	bytes.resize(bytes.size() / 2);
+	auto out = Animation{};
+	EXPECT(!AnimationAsset::bin_unpack_from(bytes, out));
+}
+} // namespace
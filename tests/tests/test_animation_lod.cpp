@@ -0,0 +1,59 @@
+#include <le/graphics/animation/animation_lod.hpp>
+#include <test/test.hpp>
+#include <array>
+
+namespace {
+using namespace le;
+using namespace le::graphics;
+
+auto make_lod() -> AnimationLod {
+	auto ret = AnimationLod{};
+	ret.tiers = {{10.0f, 1}, {20.0f, 2}, {40.0f, 4}};
+	ret.origin = {5.0f, 0.0f, 0.0f};
+	ret.enabled = true;
+	return ret;
+}
+
+ADD_TEST(AnimationLodTiers) {
+	EXPECT(AnimationLod{}.get_interval({500.0f, 0.0f, 0.0f}) == 1);
+
+	auto lod = make_lod();
+	EXPECT(lod.get_interval({5.0f, 0.0f, 0.0f}) == 1);
+	EXPECT(lod.get_interval({5.0f, 10.0f, 0.0f}) == 1);
+	EXPECT(lod.get_interval({5.0f, 0.0f, -15.0f}) == 2);
+	EXPECT(lod.get_interval({30.0f, 0.0f, 0.0f}) == 4);
+	EXPECT(lod.get_interval({50.0f, 0.0f, 0.0f}) == 0);
+
+	// scaled tier distances.
+	EXPECT(lod.get_interval({30.0f, 0.0f, 0.0f}, 3.0f) == 1);
+	EXPECT(lod.get_interval({5.0f, 0.0f, 8.0f}, 0.5f) == 2);
+
+	lod.enabled = false;
+	EXPECT(lod.get_interval({500.0f, 0.0f, 0.0f}) == 1);
+	lod.enabled = true;
+	lod.tiers.clear();
+	EXPECT(lod.get_interval({5.0f, 0.0f, 0.0f}) == 0);
+}
+
+ADD_TEST(AnimationLodUpdateFrames) {
+	constexpr std::uint32_t interval_v{4};
+	constexpr std::size_t frames_v{64};
+	auto lod = make_lod();
+	auto counts = std::array<std::size_t, interval_v>{};
+	for (std::size_t frame = 0; frame < frames_v; ++frame) {
+		EXPECT(lod.is_update_frame(1, frame));
+		EXPECT(!lod.is_update_frame(0, frame));
+		auto updates = std::size_t{};
+		for (std::uint64_t phase = 0; phase < interval_v; ++phase) {
+			if (!lod.is_update_frame(interval_v, phase)) { continue; }
+			++counts.at(phase);
+			++updates;
+		}
+		// phases are staggered: exactly one of every interval animators updates each frame.
+		EXPECT(updates == 1);
+		lod.next_frame();
+	}
+	for (auto const count : counts) { EXPECT(count == frames_v / interval_v); }
+	EXPECT(lod.get_frame() == frames_v);
+}
+} // namespace
@@ -0,0 +1,54 @@
+#include <le/core/flat_hash_map.hpp>
+#include <test/test.hpp>
+#include <string>
+
+namespace {
+using namespace le;
+
+struct ConstantHasher {
+	auto operator()(std::string const& /*key*/) const -> std::uint64_t { return 42; }
+};
+
+ADD_TEST(FlatHashMapInsertFind) {
+	auto map = FlatHashMap<int, std::string>{};
+	EXPECT(map.is_empty());
+	EXPECT(map.find(1) == nullptr);
+	for (int i = 0; i < 1000; ++i) { map.insert_or_assign(i, std::to_string(i)); }
+	ASSERT(map.size() == 1000);
+	for (int i = 0; i < 1000; ++i) {
+		auto const* value = map.find(i);
+		ASSERT(value != nullptr);
+		EXPECT(*value == std::to_string(i));
+	}
+	EXPECT(!map.contains(1000));
+
+	map.insert_or_assign(7, "seven");
+	EXPECT(map.size() == 1000);
+	EXPECT(*map.find(7) == "seven");
+	// entries are dense and in insertion order.
+	EXPECT(map.entries()[7].key == 7 && map.entries()[7].value == "seven");
+
+	map.clear();
+	EXPECT(map.is_empty() && !map.contains(7));
+	map.insert_or_assign(7, "again");
+	EXPECT(*map.find(7) == "again");
+}
+
+ADD_TEST(FlatHashMapCollisions) {
+	auto map = FlatHashMap<std::string, int, ConstantHasher>{};
+	for (int i = 0; i < 100; ++i) { map.insert_or_assign(std::to_string(i), i); }
+	ASSERT(map.size() == 100);
+	for (int i = 0; i < 100; ++i) {
+		auto const* value = map.find(std::to_string(i));
+		ASSERT(value != nullptr);
+		EXPECT(*value == i);
+	}
+	EXPECT(!map.contains("100"));
+
+	// heterogeneous lookup: hash + predicate, no KeyT constructed.
+	auto const* value = map.find(42, [](std::string const& key) { return key == "57"; });
+	ASSERT(value != nullptr);
+	EXPECT(*value == 57);
+	EXPECT(map.find(43, [](std::string const& key) { return key == "57"; }) == nullptr);
+}
+} // namespace
@@ -0,0 +1,60 @@
+#include <glm/gtc/matrix_transform.hpp>
+#include <le/graphics/frustum.hpp>
+#include <test/test.hpp>
+#include <limits>
+#include <random>
+
+namespace {
+using namespace le;
+using namespace le::graphics;
+
+auto make_frustum() -> Frustum {
+	// camera at origin looking down -Z.
+	auto const projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+	auto const view = glm::lookAt(glm::vec3{}, glm::vec3{0.0f, 0.0f, -1.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+	return Frustum::from(projection * view);
+}
+
+ADD_TEST(FrustumIntersects) {
+	auto const frustum = make_frustum();
+	EXPECT(frustum.intersects(Sphere{.centre = {0.0f, 0.0f, -10.0f}, .radius = 1.0f}));
+	EXPECT(!frustum.intersects(Sphere{.centre = {0.0f, 0.0f, 10.0f}, .radius = 1.0f})); // behind
+	EXPECT(!frustum.intersects(Sphere{.centre = {0.0f, 0.0f, -200.0f}, .radius = 1.0f})); // beyond far
+	EXPECT(!frustum.intersects(Sphere{.centre = {50.0f, 0.0f, -10.0f}, .radius = 1.0f})); // right
+	EXPECT(frustum.intersects(Sphere{.centre = {10.5f, 0.0f, -10.0f}, .radius = 1.0f})); // straddling right plane
+	EXPECT(frustum.intersects(Sphere{.centre = {0.0f, 0.0f, 10.0f}, .radius = std::numeric_limits<float>::infinity()}));
+
+	auto const ortho = Frustum::from(glm::ortho(-5.0f, 5.0f, -5.0f, 5.0f, -10.0f, 10.0f));
+	EXPECT(ortho.intersects(Sphere{.centre = {4.0f, -4.0f, 0.0f}, .radius = 0.5f}));
+	EXPECT(!ortho.intersects(Sphere{.centre = {7.0f, 0.0f, 0.0f}, .radius = 1.0f}));
+}
+
+ADD_TEST(FrustumCullerMatchesScalar) {
+	auto const frustum = make_frustum();
+	auto engine = std::mt19937{42};
+	auto position = std::uniform_real_distribution<float>{-150.0f, 150.0f};
+	auto radius = std::uniform_real_distribution<float>{0.0f, 20.0f};
+
+	auto culler = FrustumCuller{};
+	static constexpr std::size_t count_v{1001}; // not a multiple of the SIMD width
+	for (std::size_t i = 0; i < count_v; ++i) { culler.push(Sphere{.centre = {position(engine), position(engine), position(engine)}, .radius = radius(engine)}); }
+	ASSERT(culler.size() == count_v);
+
+	auto simd = std::vector<std::uint8_t>(count_v, 0xff);
+	auto scalar = std::vector<std::uint8_t>(count_v, 0xff);
+	auto const simd_visible = culler.cull(frustum, simd);
+	auto const scalar_visible = culler.cull_scalar(frustum, scalar);
+	EXPECT(simd_visible == scalar_visible);
+	EXPECT(simd == scalar);
+	EXPECT(simd_visible > 0 && simd_visible < count_v);
+}
+
+ADD_TEST(BoundsFromVertices) {
+	auto const vertices = std::vector<Vertex>{{.position = {-1.0f, 0.0f, 0.0f}}, {.position = {3.0f, 2.0f, 0.0f}}, {.position = {1.0f, 1.0f, 4.0f}}};
+	auto const bounds = Bounds::from(vertices);
+	EXPECT(bounds.is_bounded());
+	EXPECT(bounds.centre == glm::vec3(1.0f, 1.0f, 2.0f));
+	EXPECT(bounds.half_extent == glm::vec3(2.0f, 1.0f, 2.0f));
+	EXPECT(!Bounds::from({}).is_bounded());
+}
+} // namespace
@@ -0,0 +1,111 @@
+#include <le/graphics/animation/interpolator.hpp>
+#include <test/test.hpp>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+namespace {
+using namespace le;
+using namespace le::graphics;
+
+auto make_interpolator(Interpolation const interpolation) -> Interpolator<glm::vec3> {
+	auto ret = Interpolator<glm::vec3>{.interpolation = interpolation};
+	// includes a duplicate timestamp.
+	constexpr auto timestamps_v = std::array{0.5f, 1.0f, 1.25f, 1.25f, 2.0f, 3.0f, 3.5f, 4.0f, 6.0f, 7.0f, 7.5f, 9.0f};
+	for (std::size_t i = 0; i < timestamps_v.size(); ++i) {
+		auto const value = static_cast<float>(i);
+		ret.keyframes.push_back({.value = {value, value * 0.5f, -value}, .timestamp = Duration{timestamps_v.at(i)}});
+		ret.tangents.push_back({.in = {1.0f, -value, 0.5f}, .out = {-1.0f, value, 2.0f}});
+	}
+	return ret;
+}
+
+// results must be bit-identical, not just close.
+auto same_bits(std::optional<glm::vec3> const& a, std::optional<glm::vec3> const& b) -> bool {
+	if (a.has_value() != b.has_value()) { return false; }
+	return !a || std::memcmp(&*a, &*b, sizeof(glm::vec3)) == 0;
+}
+
+auto matches_uncached(Interpolator<glm::vec3> const& interpolator, KeyframeCursor& cursor, Duration const time) -> bool {
+	if (interpolator.index_for(time, cursor) != interpolator.index_for(time)) { return false; }
+	return same_bits(interpolator(time, cursor), interpolator(time));
+}
+
+ADD_TEST(InterpolatorCursorForward) {
+	for (auto const interpolation : {Interpolation::eLinear, Interpolation::eStep, Interpolation::eCubicSpline}) {
+		auto const interpolator = make_interpolator(interpolation);
+		auto cursor = KeyframeCursor{};
+		for (auto time = Duration{}; time < Duration{10.0f}; time += Duration{0.05f}) { EXPECT(matches_uncached(interpolator, cursor, time)); }
+		// exactly on keyframes.
+		cursor = {};
+		for (auto const& keyframe : interpolator.keyframes) { EXPECT(matches_uncached(interpolator, cursor, keyframe.timestamp)); }
+	}
+}
+
+ADD_TEST(InterpolatorCursorJumps) {
+	auto const interpolator = make_interpolator(Interpolation::eLinear);
+	auto cursor = KeyframeCursor{};
+	// backwards, large forward skips, past the end, and a stale cursor.
+	constexpr auto times_v = std::array{8.0f, 0.1f, 8.5f, 1.25f, 1.1f, 20.0f, 3.0f, 0.0f, 6.5f, 6.4f, 9.0f};
+	for (auto const time : times_v) { EXPECT(matches_uncached(interpolator, cursor, Duration{time})); }
+	cursor.index = 100;
+	EXPECT(matches_uncached(interpolator, cursor, Duration{2.5f}));
+
+	auto const empty = Interpolator<glm::vec3>{};
+	cursor = {};
+	EXPECT(!empty(Duration{1.0f}, cursor));
+}
+
+ADD_TEST(InterpolatorCubicSpline) {
+	// Hermite splines reproduce cubic polynomials exactly: f(x) = x^3 - 2x^2 + 3, f'(x) = 3x^2 - 4x.
+	auto const f = [](float const x) { return x * x * x - 2.0f * x * x + 3.0f; };
+	auto const df = [](float const x) { return 3.0f * x * x - 4.0f * x; };
+	auto interpolator = Interpolator<glm::vec3>{.interpolation = Interpolation::eCubicSpline};
+	for (auto const x : {0.5f, 2.0f, 2.5f}) {
+		interpolator.keyframes.push_back({.value = glm::vec3{f(x)}, .timestamp = Duration{x}});
+		interpolator.tangents.push_back({.in = glm::vec3{df(x)}, .out = glm::vec3{df(x)}});
+	}
+	for (auto x = 0.5f; x <= 2.5f; x += 0.05f) {
+		auto const value = interpolator(Duration{x});
+		ASSERT(value.has_value());
+		EXPECT(std::abs(value->y - f(x)) < 0.0001f);
+	}
+	for (auto const& keyframe : interpolator.keyframes) { EXPECT(same_bits(interpolator(keyframe.timestamp), keyframe.value)); }
+
+	// without tangents, cubic splines are sampled linearly.
+	interpolator.tangents.clear();
+	auto linear = interpolator;
+	linear.interpolation = Interpolation::eLinear;
+	EXPECT(same_bits(interpolator(Duration{1.3f}), linear(Duration{1.3f})));
+}
+
+ADD_TEST(InterpolatorCubicSplineSparse) {
+	// one period of a sine: 9 cubic keys are as accurate as ~70 linear ones.
+	constexpr std::size_t cubic_keys_v{9};
+	constexpr std::size_t linear_keys_v{70};
+	constexpr auto period_v{2.0f * std::numbers::pi_v<float>};
+	auto const make = [&](std::size_t const count, Interpolation const interpolation) {
+		auto ret = Interpolator<glm::vec3>{.interpolation = interpolation};
+		for (std::size_t i = 0; i < count; ++i) {
+			auto const x = period_v * static_cast<float>(i) / static_cast<float>(count - 1);
+			ret.keyframes.push_back({.value = {0.0f, std::sin(x), 0.0f}, .timestamp = Duration{x}});
+			ret.tangents.push_back({.in = {0.0f, std::cos(x), 0.0f}, .out = {0.0f, std::cos(x), 0.0f}});
+		}
+		return ret;
+	};
+	auto const max_error = [&](Interpolator<glm::vec3> const& interpolator) {
+		auto ret = 0.0f;
+		for (auto x = 0.0f; x <= period_v; x += 0.01f) {
+			auto const value = interpolator(Duration{x});
+			if (!value) { return 1.0f; }
+			ret = std::max(ret, std::abs(value->y - std::sin(x)));
+		}
+		return ret;
+	};
+	auto const cubic = max_error(make(cubic_keys_v, Interpolation::eCubicSpline));
+	auto const linear = max_error(make(linear_keys_v, Interpolation::eLinear));
+	EXPECT(cubic < 0.002f);
+	EXPECT(cubic < linear);
+}
+} // namespace
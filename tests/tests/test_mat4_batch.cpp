@@ -0,0 +1,99 @@
+#include <le/core/mat4_batch.hpp>
+#include <le/core/transform.hpp>
+#include <le/node/node_tree.hpp>
+#include <test/test.hpp>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+using namespace le;
+
+auto make_matrices(std::size_t const count, std::uint32_t const seed) -> std::vector<glm::mat4> {
+	auto engine = std::mt19937{seed};
+	auto position = std::uniform_real_distribution<float>{-100.0f, 100.0f};
+	auto angle = std::uniform_real_distribution<float>{-3.0f, 3.0f};
+	auto scale = std::uniform_real_distribution<float>{0.1f, 4.0f};
+	auto ret = std::vector<glm::mat4>{};
+	ret.reserve(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		auto transform = Transform{};
+		transform.set_position({position(engine), position(engine), position(engine)});
+		transform.set_orientation(glm::angleAxis(angle(engine), glm::normalize(glm::vec3{position(engine), position(engine), 1.0f})));
+		transform.set_scale({scale(engine), scale(engine), scale(engine)});
+		ret.push_back(transform.matrix());
+	}
+	return ret;
+}
+
+// results must be bit-identical, not just close.
+auto same_bits(std::span<glm::mat4 const> a, std::span<glm::mat4 const> b) -> bool {
+	return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size_bytes()) == 0;
+}
+
+ADD_TEST(Mat4BatchMultiply) {
+	static constexpr std::size_t count_v{257};
+	auto const lhs = make_matrices(count_v, 1);
+	auto const rhs = make_matrices(count_v, 2);
+	auto expected = std::vector<glm::mat4>{};
+	for (std::size_t i = 0; i < count_v; ++i) { expected.push_back(lhs[i] * rhs[i]); }
+
+	auto out = std::vector<glm::mat4>(count_v);
+	mat4_batch::multiply(lhs, rhs, out);
+	EXPECT(same_bits(out, expected));
+	mat4_batch::multiply_scalar(lhs, rhs, out);
+	EXPECT(same_bits(out, expected));
+
+	// in place, aliasing either operand.
+	auto in_place = lhs;
+	mat4_batch::multiply(in_place, rhs, in_place);
+	EXPECT(same_bits(in_place, expected));
+	in_place = rhs;
+	mat4_batch::multiply(lhs, in_place, in_place);
+	EXPECT(same_bits(in_place, expected));
+}
+
+ADD_TEST(Mat4BatchConcatenate) {
+	static constexpr std::size_t count_v{300};
+	auto const locals = make_matrices(count_v, 3);
+	auto engine = std::mt19937{4};
+	auto parents = std::vector<std::uint32_t>{mat4_batch::root_v};
+	auto indices = std::vector<std::uint32_t>{0};
+	for (std::uint32_t i = 1; i < count_v; ++i) {
+		// a few extra roots, otherwise any preceding node.
+		parents.push_back(i % 50 == 0 ? mat4_batch::root_v : std::uniform_int_distribution<std::uint32_t>{0, i - 1}(engine));
+		indices.push_back(i);
+	}
+
+	auto expected = std::vector<glm::mat4>(count_v);
+	for (std::size_t i = 0; i < count_v; ++i) { expected[i] = parents[i] == mat4_batch::root_v ? locals[i] : expected[parents[i]] * locals[i]; }
+
+	auto out = std::vector<glm::mat4>(count_v);
+	mat4_batch::concatenate(locals, parents, indices, out);
+	EXPECT(same_bits(out, expected));
+	auto scalar = std::vector<glm::mat4>(count_v);
+	mat4_batch::concatenate_scalar(locals, parents, indices, scalar);
+	EXPECT(same_bits(scalar, expected));
+}
+
+ADD_TEST(Mat4BatchNodeTree) {
+	// update_transforms() (batched) must match lazily resolved global_transform() (scalar) exactly.
+	auto const locals = make_matrices(64, 5);
+	auto tree = NodeTree{};
+	auto ids = std::vector<Id<Node>>{};
+	for (std::size_t i = 0; i < locals.size(); ++i) {
+		auto const parent = i == 0 ? std::optional<Id<Node>>{} : ids[(i - 1) / 2];
+		auto& node = tree.add({.parent = parent});
+		node.transform.set_position(glm::vec3{locals[i][3]});
+		node.transform.set_scale(glm::vec3{1.0f + 0.01f * static_cast<float>(i)});
+		ids.push_back(node.id());
+	}
+	auto lazy = NodeTree{tree};
+	tree.update_transforms();
+	auto batched = std::vector<glm::mat4>(ids.size());
+	auto expected = std::vector<glm::mat4>(ids.size());
+	tree.global_transforms(ids, batched);
+	lazy.global_transforms(ids, expected);
+	EXPECT(same_bits(batched, expected));
+}
+} // namespace
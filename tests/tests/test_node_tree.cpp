@@ -0,0 +1,157 @@
+#include <le/node/node_tree.hpp>
+#include <test/test.hpp>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace {
+using namespace le;
+
+// reference implementation: recurse up the parent chain on every call.
+// NOLINTNEXTLINE(misc-no-recursion)
+auto uncached(NodeTree const& tree, Node const& node) -> glm::mat4 {
+	if (!node.parent()) { return node.transform.matrix(); }
+	return uncached(tree, tree.get(*node.parent())) * node.transform.matrix();
+}
+
+auto make_transform(glm::vec3 const position) -> Transform {
+	auto ret = Transform{};
+	ret.set_position(position).set_orientation(glm::angleAxis(0.5f, glm::vec3{0.0f, 1.0f, 0.0f}));
+	return ret;
+}
+
+ADD_TEST(NodeTreeGlobalTransformCache) {
+	auto tree = NodeTree{};
+	auto& root = tree.add({.transform = make_transform({1.0f, 0.0f, 0.0f})});
+	auto const root_id = root.id();
+	auto const child_id = tree.add({.transform = make_transform({0.0f, 2.0f, 0.0f}), .parent = root_id}).id();
+	auto const leaf_id = tree.add({.transform = make_transform({0.0f, 0.0f, 3.0f}), .parent = child_id}).id();
+	EXPECT(tree.global_transform(leaf_id) == uncached(tree, tree.get(leaf_id)));
+
+	// modifying an ancestor must invalidate descendants.
+	tree.get(root_id).transform.set_position({-5.0f, 0.0f, 0.0f});
+	EXPECT(tree.global_transform(leaf_id) == uncached(tree, tree.get(leaf_id)));
+
+	// as must assigning a transform directly.
+	tree.get(child_id).transform = make_transform({0.0f, -1.0f, 0.0f});
+	tree.update_transforms();
+	EXPECT(tree.global_transform(leaf_id) == uncached(tree, tree.get(leaf_id)));
+
+	// and reparenting.
+	auto const other_id = tree.add({.transform = make_transform({7.0f, 7.0f, 7.0f})}).id();
+	tree.reparent(tree.get(leaf_id), other_id);
+	EXPECT(tree.global_transform(leaf_id) == uncached(tree, tree.get(leaf_id)));
+	tree.reparent(tree.get(leaf_id), {});
+	EXPECT(tree.global_transform(leaf_id) == tree.get(leaf_id).transform.matrix());
+}
+
+// every node must be preceded by its parent in dense storage.
+auto is_sorted(NodeTree const& tree) -> bool {
+	auto seen = std::vector<Id<Node>>{};
+	for (auto const& node : tree.nodes()) {
+		if (node.parent() && std::ranges::find(seen, *node.parent()) == seen.end()) { return false; }
+		seen.push_back(node.id());
+	}
+	return true;
+}
+
+ADD_TEST(NodeTreeDenseOrder) {
+	auto tree = NodeTree{};
+	auto const a = tree.add({.transform = make_transform({1.0f, 0.0f, 0.0f})}).id();
+	auto const b = tree.add({.transform = make_transform({0.0f, 1.0f, 0.0f})}).id();
+	auto const a0 = tree.add({.transform = make_transform({0.0f, 0.0f, 1.0f}), .parent = a}).id();
+	auto const a00 = tree.add({.transform = make_transform({2.0f, 0.0f, 0.0f}), .parent = a0}).id();
+	EXPECT(is_sorted(tree));
+
+	// b is stored after a: parenting a under b must reorder.
+	tree.reparent(tree.get(a), b);
+	EXPECT(is_sorted(tree));
+	ASSERT(tree.find(a00) != nullptr);
+	EXPECT(tree.global_transform(a00) == uncached(tree, tree.get(a00)));
+	EXPECT(tree.roots().size() == 1 && tree.roots().front() == b);
+
+	// parenting a node under its own descendant is rejected.
+	tree.reparent(tree.get(a), a00);
+	EXPECT(tree.get(a).parent() == b);
+
+	auto removed = std::vector<Id<Node>>{};
+	tree.remove(a0, [&removed](Node const& node) { removed.push_back(node.id()); });
+	EXPECT((removed == std::vector<Id<Node>>{a00, a0}));
+	EXPECT(tree.size() == 2 && tree.find(a0) == nullptr && tree.find(a00) == nullptr);
+	EXPECT(tree.get(a).children().empty());
+	EXPECT(is_sorted(tree));
+	EXPECT(tree.global_transform(a) == uncached(tree, tree.get(a)));
+
+	auto const c = tree.add({.parent = a}).id();
+	tree.update_transforms();
+	EXPECT(tree.global_transform(c) == uncached(tree, tree.get(c)));
+	tree.remove(std::vector<Id<Node>>{b, c}, [](Node const&) {});
+	EXPECT(tree.size() == 0 && tree.roots().empty());
+}
+
+ADD_TEST(NodeTreeNameIndex) {
+	auto tree = NodeTree{};
+	auto const a = tree.add({.name = "joint"}).id();
+	auto const b = tree.add({.name = "joint", .parent = a}).id();
+	auto const c = tree.add({.name = "other", .parent = b}).id();
+	EXPECT(tree.find_by_name("joint") == a);
+	EXPECT(tree.find_all_by_name("joint").size() == 2);
+	EXPECT(tree.find_by_name("other") == c);
+	EXPECT(!tree.find_by_name("missing"));
+	EXPECT(!tree.find_by_name(""));
+
+	tree.rename(tree.get(a), "root");
+	EXPECT(tree.find_by_name("root") == a);
+	EXPECT(tree.find_by_name("joint") == b);
+	EXPECT(tree.get(a).name() == "root");
+
+	// reassigning renames too.
+	tree.insert_or_assign(c, {.name = "leaf", .parent = b});
+	EXPECT(!tree.find_by_name("other"));
+	EXPECT(tree.find_by_name("leaf") == c);
+
+	tree.remove(b);
+	EXPECT(!tree.find_by_name("joint"));
+	EXPECT(!tree.find_by_name("leaf"));
+	EXPECT(tree.find_by_name("root") == a);
+
+	tree.clear();
+	EXPECT(!tree.find_by_name("root"));
+}
+
+ADD_TEST(NodeTreeNameIndexBatchRemove) {
+	auto tree = NodeTree{};
+	auto ids = std::vector<Id<Node>>{};
+	for (int i = 0; i < 8; ++i) { ids.push_back(tree.add({.name = "spawned"}).id()); }
+	auto const other = tree.add({.name = "other", .parent = ids[1]}).id();
+
+	auto const removed = std::array{ids[1], ids[4], ids[6]};
+	tree.remove(removed, [](Node const&) {});
+	auto const expected = std::array{ids[0], ids[2], ids[3], ids[5], ids[7]};
+	EXPECT(std::ranges::equal(tree.find_all_by_name("spawned"), expected));
+	EXPECT(!tree.find_by_name("other"));
+	EXPECT(tree.find(other) == nullptr);
+
+	tree.remove(expected, [](Node const&) {});
+	EXPECT(tree.find_all_by_name("spawned").empty());
+}
+
+ADD_TEST(NodeTreeGlobalTransformsBatch) {
+	auto tree = NodeTree{};
+	auto ids = std::array<Id<Node>, 4>{0, 0, 0, 0};
+	auto parent = std::optional<Id<Node>>{};
+	for (auto& id : ids) {
+		id = tree.add({.transform = make_transform({1.0f, 0.5f, 0.0f}), .parent = parent}).id();
+		parent = id;
+	}
+	tree.update_transforms();
+	tree.get(ids[1]).transform.set_scale(glm::vec3{2.0f});
+
+	auto const queried = std::array<Id<Node>, 3>{ids[3], ids[0], 100};
+	auto out = std::array<glm::mat4, 3>{};
+	tree.global_transforms(queried, out);
+	EXPECT(out[0] == uncached(tree, tree.get(ids[3])));
+	EXPECT(out[1] == tree.get(ids[0]).transform.matrix());
+	EXPECT(out[2] == glm::identity<glm::mat4>());
+}
+} // namespace
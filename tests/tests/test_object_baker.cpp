@@ -0,0 +1,187 @@
+#include <glm/gtc/matrix_transform.hpp>
+#include <le/graphics/material.hpp>
+#include <le/graphics/object_baker.hpp>
+#include <test/null_primitive.hpp>
+#include <test/test.hpp>
+#include <cstring>
+
+namespace {
+using namespace le;
+using namespace le::graphics;
+using test::NullPrimitive;
+
+struct Fixture {
+	UnlitMaterial material{};
+	NullPrimitive primitive{};
+	std::vector<RenderInstance> instances{};
+	std::vector<glm::mat4> joints{};
+	std::vector<RenderObject> objects{};
+
+	explicit Fixture(std::size_t const count) {
+		instances.resize(3);
+		for (std::size_t i = 0; i < instances.size(); ++i) {
+			instances[i].transform.set_position(glm::vec3{static_cast<float>(i)});
+			instances[i].tint = Rgba::from(glm::vec4{1.0f, 0.5f, 0.25f, 1.0f});
+		}
+		joints.resize(5, glm::mat4{2.0f});
+		objects.reserve(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			auto object = RenderObject{.material = &material, .primitive = &primitive};
+			object.parent = glm::translate(glm::mat4{1.0f}, glm::vec3{static_cast<float>(i), 0.0f, 0.0f});
+			if (i % 2 == 0) { object.instances = instances; }
+			if (i % 3 == 0) { object.joints = joints; }
+			objects.push_back(object);
+		}
+	}
+};
+
+ADD_TEST(ObjectBakerLayout) {
+	auto const fixture = Fixture{16};
+	auto baker = ObjectBaker{};
+	baker.batching = false;
+	baker.set_alignment(64);
+	baker.push(fixture.objects);
+	auto const entries = baker.get_entries();
+	ASSERT(entries.size() == fixture.objects.size());
+	for (std::size_t i = 0; i < entries.size(); ++i) {
+		auto const& entry = entries[i];
+		EXPECT(entry.instances.offset % 64 == 0);
+		EXPECT(entry.instance_count == (i % 2 == 0 ? 3u : 1u));
+		EXPECT(entry.instances.size == entry.instance_count * sizeof(ObjectBaker::Std430Instance));
+		if (i % 3 == 0) {
+			EXPECT(entry.joints.offset % 64 == 0);
+			EXPECT(entry.joints.size == fixture.joints.size() * sizeof(glm::mat4));
+		} else {
+			EXPECT(entry.joints.size == 0);
+		}
+		EXPECT(entry.instances.offset + entry.instances.size <= baker.size_bytes());
+	}
+}
+
+ADD_TEST(ObjectBakerParallelIdentical) {
+	auto const fixture = Fixture{1000};
+	auto baker = ObjectBaker{};
+	baker.min_chunk = 1;
+	baker.batching = false;
+	baker.push(fixture.objects);
+
+	auto serial = std::vector<std::byte>(baker.size_bytes());
+	auto parallel = std::vector<std::byte>(baker.size_bytes());
+	baker.write(serial);
+	auto pool = ThreadPool{4};
+	baker.write(parallel, &pool);
+
+	ASSERT(serial.size() == parallel.size());
+	EXPECT(std::memcmp(serial.data(), parallel.data(), serial.size()) == 0);
+}
+
+ADD_TEST(ObjectBakerBatching) {
+	auto const lit = LitMaterial{};
+	auto blend = LitMaterial{};
+	blend.alpha_mode = AlphaMode::eBlend;
+	auto fixture = Fixture{0};
+	auto const primitive_b = NullPrimitive{};
+	// opaque objects merge across the list, blended ones only when adjacent, skinned ones never.
+	auto const make = [&](Material const& material, Primitive const& primitive, bool instanced, bool skinned) {
+		auto ret = RenderObject{.material = &material, .primitive = &primitive};
+		ret.parent = glm::translate(glm::mat4{1.0f}, glm::vec3{static_cast<float>(fixture.objects.size())});
+		if (instanced) { ret.instances = fixture.instances; }
+		if (skinned) { ret.joints = fixture.joints; }
+		fixture.objects.push_back(ret);
+	};
+	fixture.objects.reserve(8);
+	make(lit, fixture.primitive, true, false);	  // entry 0
+	make(blend, fixture.primitive, false, false); // entry 1
+	make(blend, fixture.primitive, true, false);  // entry 1 (adjacent)
+	make(lit, fixture.primitive, false, false);	  // entry 0
+	make(blend, fixture.primitive, false, false); // entry 2 (not adjacent)
+	make(lit, primitive_b, false, false);		  // entry 3
+	make(lit, fixture.primitive, false, true);	  // entry 4 (skinned)
+	make(lit, fixture.primitive, false, true);	  // entry 5 (skinned)
+
+	auto batched = ObjectBaker{};
+	EXPECT(batched.push(fixture.objects) == 6);
+	ASSERT(batched.get_entries().size() == 6);
+	EXPECT(batched.merged_count() == 2);
+	auto const entries = batched.get_entries();
+	EXPECT(entries[0].instance_count == 4 && entries[0].objects.size == 2);
+	EXPECT(entries[1].instance_count == 4 && entries[1].objects.size == 2);
+	EXPECT(entries[2].instance_count == 1 && entries[3].instance_count == 1);
+	EXPECT(entries[4].joints.size > 0 && entries[5].joints.size > 0);
+
+	// batched instance data must match the unbatched data of its objects, in order.
+	auto unbatched = ObjectBaker{};
+	unbatched.batching = false;
+	unbatched.push(fixture.objects);
+	auto batched_bytes = std::vector<std::byte>(batched.size_bytes());
+	auto unbatched_bytes = std::vector<std::byte>(unbatched.size_bytes());
+	batched.write(batched_bytes);
+	unbatched.write(unbatched_bytes);
+	auto const unbatched_entries = unbatched.get_entries();
+	auto const expect_match = [&](ObjectBaker::Entry const& entry, std::initializer_list<std::size_t> indices) {
+		auto offset = entry.instances.offset;
+		for (auto const index : indices) {
+			auto const& source = unbatched_entries[index].instances;
+			EXPECT(std::memcmp(batched_bytes.data() + offset, unbatched_bytes.data() + source.offset, source.size) == 0);
+			offset += source.size;
+		}
+	};
+	expect_match(entries[0], {0, 3});
+	expect_match(entries[1], {1, 2});
+	expect_match(entries[2], {4});
+}
+
+ADD_TEST(ObjectBakerBatchKey) {
+	auto const lit = LitMaterial{};
+	auto const primitive = NullPrimitive{};
+	auto objects = std::vector<RenderObject>(4, RenderObject{.material = &lit, .primitive = &primitive});
+	objects[1].layer = 1;
+	objects[2].pipeline_state.topology = vk::PrimitiveTopology::eLineList;
+
+	// objects differing only in layer or pipeline state are never merged.
+	auto baker = ObjectBaker{};
+	EXPECT(baker.push(objects) == 3);
+	auto const entries = baker.get_entries();
+	ASSERT(entries.size() == 3);
+	EXPECT(entries[0].objects.size == 2 && entries[0].object->layer == 0);
+	EXPECT(entries[1].object->layer == 1);
+	EXPECT(entries[2].object->pipeline_state.topology == vk::PrimitiveTopology::eLineList);
+}
+
+ADD_TEST(ObjectBakerPasses) {
+	auto const fixture = Fixture{4};
+	auto const lit = LitMaterial{};
+	auto objects = fixture.objects;
+	for (auto& object : objects) {
+		object.material = &lit;
+		object.joints = {};
+	}
+	auto pointers = std::vector<Ptr<RenderObject const>>{};
+	for (auto const& object : objects) { pointers.push_back(&object); }
+	auto const passes = std::vector<ObjectBaker::PassMask>{0b01, 0b11, 0b01, 0b10};
+
+	// objects are only merged with others drawn in the same passes.
+	auto baker = ObjectBaker{};
+	EXPECT(baker.push(pointers, passes) == 3);
+	auto const entries = baker.get_entries();
+	ASSERT(entries.size() == 3);
+	EXPECT(entries[0].passes == 0b01 && entries[0].objects.size == 2 && entries[0].object == &objects[0]);
+	EXPECT(entries[1].passes == 0b11 && entries[1].object == &objects[1]);
+	EXPECT(entries[2].passes == 0b10 && entries[2].object == &objects[3]);
+
+	// pointers lay out the same data as the objects they point to.
+	auto unbatched = ObjectBaker{};
+	unbatched.batching = false;
+	unbatched.push(objects);
+	auto by_pointer = ObjectBaker{};
+	by_pointer.batching = false;
+	by_pointer.push(pointers, passes);
+	ASSERT(unbatched.size_bytes() == by_pointer.size_bytes());
+	auto lhs = std::vector<std::byte>(unbatched.size_bytes());
+	auto rhs = std::vector<std::byte>(by_pointer.size_bytes());
+	unbatched.write(lhs);
+	by_pointer.write(rhs);
+	EXPECT(std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0);
+	EXPECT(unbatched.get_entries().front().passes == ObjectBaker::all_passes_v);
+}
+} // namespace
@@ -0,0 +1,124 @@
+#include <glm/gtc/quaternion.hpp>
+#include <le/core/random.hpp>
+#include <le/graphics/particle.hpp>
+#include <test/test.hpp>
+#include <cmath>
+#include <numbers>
+
+namespace {
+using namespace le;
+using namespace le::graphics;
+
+constexpr auto all_modifiers_v = Particle::Modifiers{Particle::eTranslate | Particle::eRotate | Particle::eScale | Particle::eTint};
+
+auto near(float const a, float const b, float const epsilon = 1e-4f) -> bool { return std::abs(a - b) <= epsilon; }
+
+auto make_emitter(std::size_t const count, std::uint64_t const seed) -> Particle::Emitter {
+	auto ret = Particle::Emitter{};
+	ret.config.count = count;
+	ret.config.ttl = {0.5s, 2s};
+	ret.config.velocity.angular = {Degrees{-720.0f}, Degrees{720.0f}};
+	ret.modifiers = all_modifiers_v;
+	ret.seed(seed);
+	return ret;
+}
+
+ADD_TEST(Xoshiro128Sequence) {
+	// reference output of xoshiro128++ for state {1, 2, 3, 4}.
+	auto random = Xoshiro128{std::array<std::uint32_t, 4>{1, 2, 3, 4}};
+	EXPECT(random() == 641);
+
+	auto lhs = Xoshiro128{42};
+	auto rhs = Xoshiro128{42};
+	for (int i = 0; i < 16; ++i) { EXPECT(lhs() == rhs()); }
+	EXPECT(Xoshiro128{42}() != Xoshiro128{43}());
+}
+
+ADD_TEST(Xoshiro128Distribution) {
+	static constexpr std::size_t count_v{100000};
+	auto random = Xoshiro128{7};
+	auto sum = 0.0;
+	for (std::size_t i = 0; i < count_v; ++i) {
+		auto const value = random.next_float();
+		ASSERT(value >= 0.0f && value < 1.0f);
+		sum += value;
+	}
+	EXPECT(std::abs(sum / count_v - 0.5) < 0.01);
+
+	for (std::size_t i = 0; i < 100; ++i) {
+		auto const value = random.in_range(-3.0f, 5.0f);
+		EXPECT(value >= -3.0f && value <= 5.0f);
+	}
+}
+
+ADD_TEST(ParticleEmitterMatchesScalar) {
+	static constexpr std::size_t count_v{1001}; // not a multiple of the SIMD width
+	auto const view = glm::angleAxis(0.5f, glm::vec3{0.0f, 1.0f, 0.0f});
+	auto simd = make_emitter(count_v, 42);
+	auto scalar = make_emitter(count_v, 42);
+	simd.respawn_all(view);
+	scalar.respawn_all(view);
+	for (int frame = 0; frame < 120; ++frame) {
+		simd.update(view, Duration{1.0f / 60.0f});
+		scalar.update_scalar(view, Duration{1.0f / 60.0f});
+	}
+
+	ASSERT(simd.active_particles() == count_v && scalar.active_particles() == count_v);
+	auto const lhs = simd.get_instances();
+	auto const rhs = scalar.get_instances();
+	ASSERT(lhs.size() == rhs.size());
+	for (std::size_t i = 0; i < lhs.size(); ++i) {
+		auto const& a = lhs[i].transform;
+		auto const& b = rhs[i].transform;
+		EXPECT(near(a.position().x, b.position().x) && near(a.position().y, b.position().y) && near(a.position().z, b.position().z));
+		EXPECT(near(std::abs(glm::dot(a.orientation(), b.orientation())), 1.0f));
+		EXPECT(near(a.scale().x, b.scale().x) && near(a.scale().y, b.scale().y));
+		EXPECT(lhs[i].tint.channels == rhs[i].tint.channels);
+	}
+}
+
+ADD_TEST(ParticleEmitterOrientation) {
+	auto const view = glm::angleAxis(1.2f, glm::normalize(glm::vec3{1.0f, 2.0f, -0.5f}));
+	auto emitter = make_emitter(64, 1);
+	emitter.modifiers = Particle::eRotate;
+	emitter.config.ttl = {10s, 10s};
+	emitter.config.initial.rotation = {Degrees{90.0f}, Degrees{90.0f}};
+	emitter.config.velocity.angular = {Degrees{360.0f}, Degrees{360.0f}};
+	emitter.respawn_all(view);
+
+	// 1s at 360 deg/s: 450 deg, wrapped back to 90 deg.
+	for (int i = 0; i < 4; ++i) { emitter.update(view, Duration{0.25f}); }
+	auto const expected = glm::inverse(view) * glm::angleAxis(std::numbers::pi_v<float> * 0.5f, glm::vec3{0.0f, 0.0f, 1.0f});
+	for (auto const& instance : emitter.get_instances()) {
+		auto const orientation = instance.transform.orientation();
+		EXPECT(near(std::abs(glm::dot(orientation, expected)), 1.0f));
+		EXPECT(near(glm::length(orientation), 1.0f));
+	}
+}
+
+ADD_TEST(ParticleEmitterExpiry) {
+	auto const view = glm::identity<glm::quat>();
+	auto emitter = make_emitter(100, 3);
+	emitter.config.ttl = {1s, 3s};
+	emitter.config.respawn = false;
+	emitter.respawn_all(view);
+	EXPECT(emitter.active_particles() == 100);
+
+	emitter.update(view, 2s);
+	auto const remaining = emitter.active_particles();
+	emitter.update(view, {});
+	// expired particles are removed on the next update.
+	EXPECT(emitter.active_particles() < remaining);
+	EXPECT(emitter.active_particles() > 0);
+	// survivors are at least two thirds through their lifetimes.
+	for (auto const& instance : emitter.get_instances()) { EXPECT(instance.tint.channels.w < 0x60); }
+
+	emitter.update(view, 2s);
+	emitter.update(view, {});
+	EXPECT(emitter.active_particles() == 0);
+
+	emitter.config.respawn = true;
+	emitter.update(view, {});
+	EXPECT(emitter.active_particles() == 100);
+}
+} // namespace
@@ -0,0 +1,40 @@
+#include <le/perf_capture.hpp>
+#include <test/test.hpp>
+
+namespace {
+using namespace le;
+
+ADD_TEST(PerfCaptureWarmupAndSummary) {
+	auto capture = PerfCapture{100, 5};
+	auto profile = FrameProfile{};
+	profile.frame_time = 1s;
+	for (int i = 0; i < 5; ++i) { EXPECT(!capture.push(profile)); }
+	EXPECT(capture.get_profiles().empty());
+
+	for (int i = 0; i < 100; ++i) {
+		profile.frame_time = Duration{static_cast<float>(i + 1)};
+		profile.profile[FrameProfile::Type::eTick] = Duration{static_cast<float>(100 - i)};
+		profile.gpu_profile[FrameProfile::Type::eRenderScene] = Duration{static_cast<float>(i + 1)};
+		EXPECT(capture.push(profile) == (i == 99));
+	}
+	ASSERT(capture.is_complete());
+	EXPECT(capture.push(profile));
+	EXPECT(capture.get_profiles().size() == 100);
+
+	auto const frame_time = capture.summarize_frame_time();
+	EXPECT(frame_time.median == Duration{51.0f});
+	EXPECT(frame_time.p99 == Duration{99.0f});
+	EXPECT(frame_time.max == Duration{100.0f});
+
+	auto const tick = capture.summarize(FrameProfile::Type::eTick);
+	EXPECT(tick.median == Duration{51.0f});
+	EXPECT(tick.max == Duration{100.0f});
+	EXPECT(capture.summarize(FrameProfile::Type::eRenderImGui).max == Duration{});
+
+	auto const gpu_scene = capture.summarize_gpu(FrameProfile::Type::eRenderScene);
+	EXPECT(gpu_scene.median == Duration{51.0f});
+	EXPECT(gpu_scene.p99 == Duration{99.0f});
+	EXPECT(capture.summarize_gpu(FrameProfile::Type::eRenderShadowMap).max == Duration{});
+	EXPECT(FrameProfile::has_gpu_time(FrameProfile::Type::eRenderScene) && !FrameProfile::has_gpu_time(FrameProfile::Type::eTick));
+}
+} // namespace
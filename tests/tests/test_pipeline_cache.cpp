@@ -0,0 +1,90 @@
+#include <le/graphics/cache/pipeline_cache.hpp>
+#include <test/test.hpp>
+
+namespace {
+using namespace le;
+using namespace le::graphics;
+using DiskHeader = PipelineCache::DiskHeader;
+using Key = PipelineCache::Key;
+
+auto make_header() -> DiskHeader {
+	auto properties = vk::PhysicalDeviceProperties{};
+	properties.vendorID = 0x10de;
+	properties.deviceID = 42;
+	properties.driverVersion = 7;
+	properties.pipelineCacheUUID[3] = 0xab;
+	auto device_uuid = std::array<std::uint8_t, VK_UUID_SIZE>{};
+	device_uuid[0] = 0xcd;
+	return DiskHeader::make(properties, device_uuid);
+}
+
+auto serialize(DiskHeader header, std::size_t data_size) -> std::vector<std::byte> {
+	header.data_size = data_size;
+	auto ret = std::vector<std::byte>{};
+	header.write_to(ret);
+	ret.resize(ret.size() + data_size, std::byte{0x5a});
+	return ret;
+}
+
+ADD_TEST(PipelineCacheDiskHeaderRoundTrip) {
+	auto const header = make_header();
+	auto const bytes = serialize(header, 100);
+	auto const read = DiskHeader::read(bytes);
+	ASSERT(read.has_value());
+	EXPECT(read->data_size == 100);
+	EXPECT(read->device_uuid[0] == 0xcd && read->cache_uuid[3] == 0xab);
+	EXPECT(read->is_compatible(header));
+}
+
+ADD_TEST(PipelineCacheDiskHeaderRejects) {
+	auto const header = make_header();
+	auto bytes = serialize(header, 16);
+
+	// truncated data.
+	EXPECT(!DiskHeader::read(std::span{bytes}.first(bytes.size() - 1)));
+	EXPECT(!DiskHeader::read({}));
+
+	// bad magic.
+	auto corrupt = bytes;
+	corrupt[0] = std::byte{'X'};
+	EXPECT(!DiskHeader::read(corrupt));
+
+	// different driver / device.
+	auto other = header;
+	other.driver_version = 8;
+	EXPECT(!DiskHeader::read(serialize(other, 16))->is_compatible(header));
+	other = header;
+	other.device_uuid[0] = 0;
+	EXPECT(!DiskHeader::read(serialize(other, 16))->is_compatible(header));
+	other = header;
+	other.cache_uuid[3] = 0;
+	EXPECT(!DiskHeader::read(serialize(other, 16))->is_compatible(header));
+}
+
+ADD_TEST(PipelineCacheKeyEquality) {
+	auto const format = PipelineFormat{.colour = vk::Format::eR8G8B8A8Srgb, .depth = vk::Format::eD32Sfloat};
+	auto const shader = Shader{.vertex = "shaders/lit.vert", .fragment = "shaders/lit.frag"};
+	auto const key = Key{format, shader, {}, vk::PolygonMode::eFill};
+
+	// line width is dynamic state.
+	auto const wide = Key{format, shader, PipelineState{.line_width = 5.0f}, vk::PolygonMode::eFill};
+	EXPECT(wide.hash() == key.hash());
+	EXPECT(wide == key);
+	EXPECT(key.matches(format, shader, PipelineState{.line_width = 3.0f}, vk::PolygonMode::eFill));
+
+	// shaders must contribute to the hash.
+	auto const unlit = Key{format, Shader{.vertex = "shaders/lit.vert", .fragment = "shaders/unlit.frag"}, {}, vk::PolygonMode::eFill};
+	EXPECT(unlit.hash() != key.hash());
+	EXPECT(Key{format, shader, {}, vk::PolygonMode::eLine}.hash() != key.hash());
+
+	// equal hashes must not imply equal keys.
+	auto collision = unlit;
+	collision.cached_hash = key.hash();
+	EXPECT(!(collision == key));
+	auto state = PipelineState{};
+	state.depth_compare = vk::CompareOp::eLessOrEqual;
+	collision = Key{format, shader, state, vk::PolygonMode::eFill};
+	collision.cached_hash = key.hash();
+	EXPECT(!(collision == key));
+}
+} // namespace
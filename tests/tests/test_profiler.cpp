@@ -0,0 +1,72 @@
+#include <le/core/profiler.hpp>
+#include <test/test.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+
+namespace {
+using namespace le;
+
+auto find(std::vector<Profiler::Event> const& events, std::string_view const name) -> Profiler::Event const* {
+	auto const it = std::ranges::find_if(events, [name](Profiler::Event const& event) { return event.name == name; });
+	return it == events.end() ? nullptr : &*it;
+}
+
+ADD_TEST(ProfilerDisabled) {
+	Profiler::set_enabled(false);
+	[[maybe_unused]] auto const stale = Profiler::collect();
+	{ LE_PROFILE_SCOPE("disabled"); }
+	EXPECT(Profiler::collect().empty());
+}
+
+ADD_TEST(ProfilerNestedScopes) {
+	[[maybe_unused]] auto const stale = Profiler::collect();
+	Profiler::set_enabled(true);
+	{
+		LE_PROFILE_SCOPE("outer");
+		{ LE_PROFILE_SCOPE("inner"); }
+		auto thread = std::thread{[] { LE_PROFILE_SCOPE("worker"); }};
+		thread.join();
+	}
+	Profiler::set_enabled(false);
+
+	auto const events = Profiler::collect();
+	ASSERT(events.size() == 3);
+	auto const* outer = find(events, "outer");
+	auto const* inner = find(events, "inner");
+	auto const* worker = find(events, "worker");
+	ASSERT(outer && inner && worker);
+	EXPECT(outer->depth == 0 && inner->depth == 1 && worker->depth == 0);
+	EXPECT(inner->start_ns >= outer->start_ns && inner->start_ns + inner->duration_ns <= outer->start_ns + outer->duration_ns);
+	EXPECT(outer->thread == inner->thread && worker->thread != outer->thread);
+	EXPECT(outer->thread == Profiler::thread_id());
+	EXPECT(Profiler::collect().empty());
+}
+
+ADD_TEST(ProfilerDropsWhenFull) {
+	[[maybe_unused]] auto const stale = Profiler::collect();
+	Profiler::drain_dropped();
+	Profiler::set_enabled(true);
+	for (std::size_t i = 0; i < Profiler::thread_capacity_v + 10; ++i) { LE_PROFILE_SCOPE("overflow"); }
+	Profiler::set_enabled(false);
+	EXPECT(Profiler::collect().size() == Profiler::thread_capacity_v);
+	EXPECT(Profiler::drain_dropped() == 10);
+}
+
+ADD_TEST(ProfilerCapture) {
+	ASSERT(!Profiler::start_capture(0, "profile_trace_test.json"));
+	ASSERT(Profiler::start_capture(2, "profile_trace_test.json"));
+	EXPECT(!Profiler::start_capture(2, "profile_trace_test.json"));
+	EXPECT(!Profiler::is_enabled());
+	Profiler::next_frame();
+	EXPECT(Profiler::is_enabled());
+	{ LE_PROFILE_SCOPE("frame_0"); }
+	Profiler::next_frame();
+	EXPECT(Profiler::is_capturing());
+	{ LE_PROFILE_SCOPE("frame_1"); }
+	Profiler::next_frame();
+	EXPECT(!Profiler::is_capturing());
+	EXPECT(!Profiler::is_enabled());
+	EXPECT(std::filesystem::remove("profile_trace_test.json"));
+}
+} // namespace
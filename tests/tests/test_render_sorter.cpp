@@ -0,0 +1,68 @@
+#include <glm/gtc/matrix_transform.hpp>
+#include <le/graphics/render_sorter.hpp>
+#include <test/null_primitive.hpp>
+#include <test/test.hpp>
+
+namespace {
+using namespace le;
+using namespace le::graphics;
+using test::NullPrimitive;
+
+auto make_object(Material const& material, Primitive const& primitive, float z, std::int32_t layer = 0) -> RenderObject {
+	auto ret = RenderObject{.material = &material, .primitive = &primitive, .layer = layer};
+	ret.parent = glm::translate(glm::mat4{1.0f}, glm::vec3{0.0f, 0.0f, z});
+	return ret;
+}
+
+ADD_TEST(RenderSorterOrder) {
+	auto const opaque = LitMaterial{};
+	auto blend = LitMaterial{};
+	blend.alpha_mode = AlphaMode::eBlend;
+	auto const primitive = NullPrimitive{};
+
+	auto const objects = std::vector<RenderObject>{
+		make_object(blend, primitive, 1.0f), // 0
+		make_object(opaque, primitive, 5.0f), // 1
+		make_object(opaque, primitive, 2.0f, 1), // 2: higher layer
+		make_object(blend, primitive, 9.0f), // 3
+		make_object(opaque, primitive, 3.0f), // 4
+		make_object(opaque, primitive, 1.0f, -1), // 5: lower layer
+	};
+
+	auto sorter = RenderSorter{};
+	auto const sorted = sorter.sort(objects, glm::vec3{});
+	ASSERT(sorted.size() == objects.size());
+	auto const expect_z = [&](std::size_t index, float z, std::int32_t layer) {
+		EXPECT(sorted[index]->layer == layer);
+		EXPECT(sorted[index]->parent[3].z == z);
+	};
+	expect_z(0, 1.0f, -1);
+	expect_z(1, 3.0f, 0); // opaque: front to back
+	expect_z(2, 5.0f, 0);
+	expect_z(3, 9.0f, 0); // blended: after opaque, back to front
+	expect_z(4, 1.0f, 0);
+	expect_z(5, 2.0f, 1);
+
+	sorter.mode = RenderSorter::Mode::eLayer;
+	auto const layered = sorter.sort(objects, glm::vec3{});
+	EXPECT(layered[0]->layer == -1 && layered[5]->layer == 1);
+	EXPECT(layered[1]->parent[3].z == 1.0f && layered[2]->parent[3].z == 5.0f); // stable within a layer
+
+	sorter.mode = RenderSorter::Mode::eNone;
+	auto const submitted = sorter.sort(objects, glm::vec3{});
+	ASSERT(submitted.size() == objects.size());
+	for (std::size_t i = 0; i < objects.size(); ++i) { EXPECT(submitted[i] == &objects[i]); }
+}
+
+ADD_TEST(RenderSorterBindlessKey) {
+	auto const lit_a = LitMaterial{};
+	auto const lit_b = LitMaterial{};
+	auto const primitive = NullPrimitive{};
+	auto const a = make_object(lit_a, primitive, 1.0f);
+	auto const b = make_object(lit_b, primitive, 1.0f);
+
+	// keys are built from the shader that will be bound: lit_bindless.frag instead of lit.frag.
+	EXPECT(RenderSorter::make_key(a, {}, true).pipeline != RenderSorter::make_key(a, {}).pipeline);
+	EXPECT(RenderSorter::make_key(a, {}, true).pipeline == RenderSorter::make_key(b, {}, true).pipeline);
+}
+} // namespace
@@ -0,0 +1,54 @@
+#include <glm/gtc/matrix_transform.hpp>
+#include <le/graphics/geometry.hpp>
+#include <test/test.hpp>
+#include <array>
+#include <cmath>
+
+namespace {
+using namespace le;
+using namespace le::graphics;
+
+auto near(glm::vec3 const& a, glm::vec3 const& b) -> bool {
+	static constexpr auto epsilon_v{1e-5f};
+	return std::abs(a.x - b.x) < epsilon_v && std::abs(a.y - b.y) < epsilon_v && std::abs(a.z - b.z) < epsilon_v;
+}
+
+auto const z_axis_v = glm::vec3{0.0f, 0.0f, 1.0f};
+
+ADD_TEST(SkinVertexSingleJoint) {
+	auto const joints = std::array{
+		glm::mat4{1.0f},
+		glm::rotate(glm::translate(glm::mat4{1.0f}, glm::vec3{0.0f, 2.0f, 0.0f}), glm::radians(90.0f), z_axis_v),
+	};
+	auto const vertex = Vertex{.position = {1.0f, 0.0f, 0.0f}, .rgba = {0.5f, 0.5f, 0.5f, 1.0f}, .normal = {1.0f, 0.0f, 0.0f}, .uv = {0.25f, 0.75f}};
+
+	auto skinned = skin_vertex(vertex, Bone{.joint = {0, 0, 0, 0}, .weight = {1.0f, 0.0f, 0.0f, 0.0f}}, joints);
+	EXPECT(near(skinned.position, vertex.position));
+	EXPECT(near(skinned.normal, vertex.normal));
+
+	skinned = skin_vertex(vertex, Bone{.joint = {1, 0, 0, 0}, .weight = {1.0f, 0.0f, 0.0f, 0.0f}}, joints);
+	EXPECT(near(skinned.position, glm::vec3{0.0f, 3.0f, 0.0f}));
+	// normals are rotated, not translated.
+	EXPECT(near(skinned.normal, glm::vec3{0.0f, 1.0f, 0.0f}));
+	EXPECT(skinned.rgba == vertex.rgba && skinned.uv == vertex.uv);
+}
+
+ADD_TEST(SkinVertexBlend) {
+	auto const joints = std::array{
+		glm::translate(glm::mat4{1.0f}, glm::vec3{1.0f, 0.0f, 0.0f}),
+		glm::translate(glm::mat4{1.0f}, glm::vec3{0.0f, 2.0f, 0.0f}),
+		glm::rotate(glm::mat4{1.0f}, glm::radians(90.0f), z_axis_v),
+	};
+	auto const vertex = Vertex{.position = {0.0f, 0.0f, 1.0f}, .normal = {1.0f, 0.0f, 0.0f}};
+
+	auto skinned = skin_vertex(vertex, Bone{.joint = {0, 1, 0, 0}, .weight = {0.5f, 0.5f, 0.0f, 0.0f}}, joints);
+	EXPECT(near(skinned.position, glm::vec3{0.5f, 1.0f, 1.0f}));
+	EXPECT(near(skinned.normal, vertex.normal));
+
+	// blended normals are renormalized.
+	skinned = skin_vertex(vertex, Bone{.joint = {0, 2, 0, 0}, .weight = {0.5f, 0.5f, 0.0f, 0.0f}}, joints);
+	auto const expected = glm::normalize(glm::vec3{1.0f, 1.0f, 0.0f});
+	EXPECT(near(skinned.normal, expected));
+	EXPECT(near(skinned.position, glm::vec3{0.5f, 0.0f, 1.0f}));
+}
+} // namespace
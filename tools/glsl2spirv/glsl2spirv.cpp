@@ -30,7 +30,7 @@ struct Compiler {
 	auto compile(fs::path const& glsl, Result& out) const -> void {
 		auto filename = glsl.filename();
 		auto const extension = filename.extension();
-		if (extension != ".vert" && extension != ".frag") {
+		if (extension != ".vert" && extension != ".frag" && extension != ".comp") {
 			if (g_verbose) { std::cout << std::format("-- ignoring file [{}]\n", filename.string()); }
 			return;
 		}
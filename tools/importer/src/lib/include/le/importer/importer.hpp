@@ -12,6 +12,7 @@ struct Input {
 	fs::path data_root{fs::current_path()};
 	bool verbose{};
 	bool force{};
+	bool raw_animations{};
 };
 
 struct MeshList {
@@ -146,7 +146,7 @@ struct Traverse {
 
 [[nodiscard]] constexpr auto to_interpolation(gltf2cpp::Interpolation in) -> graphics::Interpolation {
 	switch (in) {
-	case gltf2cpp::Interpolation::eCubicSpline: std::cout << "CubicSpline interpolation not supported\n"; return graphics::Interpolation::eLinear;
+	case gltf2cpp::Interpolation::eCubicSpline: return graphics::Interpolation::eCubicSpline;
 	default:
 	case gltf2cpp::Interpolation::eLinear: return graphics::Interpolation::eLinear;
 	case gltf2cpp::Interpolation::eStep: return graphics::Interpolation::eStep;
@@ -156,10 +156,20 @@ struct Traverse {
 template <typename T>
 [[nodiscard]] auto to_interpolator(std::span<float const> times, std::span<T const> values, gltf2cpp::Interpolation interpolation)
 	-> graphics::Interpolator<T> {
-	assert(times.size() == values.size());
 	auto ret = graphics::Interpolator<T>{};
-	for (auto [t, v] : zip_ranges(times, values)) { ret.keyframes.push_back({v, Duration{t}}); }
 	ret.interpolation = to_interpolation(interpolation);
+	if (interpolation == gltf2cpp::Interpolation::eCubicSpline) {
+		// each key is an (in-tangent, value, out-tangent) triplet.
+		assert(times.size() * 3 == values.size());
+		for (auto const [t, index] : enumerate(times)) {
+			auto const triplet = values.subspan(index * 3, 3);
+			ret.keyframes.push_back({triplet[1], Duration{t}});
+			ret.tangents.push_back({triplet[0], triplet[2]});
+		}
+		return ret;
+	}
+	assert(times.size() == values.size());
+	for (auto [t, v] : zip_ranges(times, values)) { ret.keyframes.push_back({v, Duration{t}}); }
 	return ret;
 }
 
@@ -173,6 +183,7 @@ struct Exporter {
 	// NOLINTNEXTLINE
 	gltf2cpp::Root const& root;
 	bool force{};
+	bool compress_animations{};
 
 	[[nodiscard]] static auto make_filename(std::string_view name, std::string_view fallback, NestedIndex index, std::string_view suffix = {}) -> std::string {
 		if (name.empty() || name == "(Unnamed)") { name = fallback; }
@@ -394,7 +405,11 @@ struct Exporter {
 		auto dst = fs::path{};
 		if (should_skip(uri, dst)) { return uri; }
 		auto bytes = std::vector<std::byte>{};
-		AnimationAsset::bin_pack_to(bytes, out_animation);
+		if (compress_animations) {
+			AnimationAsset::bin_pack_to(bytes, out_animation, AnimationAsset::Compression{});
+		} else {
+			AnimationAsset::bin_pack_to(bytes, out_animation);
+		}
 		if (!write_file(bytes, dst)) { throw Error{std::format("failed to export animation [{}]", index)}; }
 
 		std::cout << exported(uri);
@@ -559,7 +574,7 @@ auto Importer::import_mesh(std::size_t mesh_id) -> std::optional<Uri> {
 	}
 
 	fs::create_directories(m_input.data_root / m_export_prefix);
-	auto const exporter = Exporter{m_input.data_root, m_export_prefix, m_gltf_dir, m_root, m_input.force};
+	auto const exporter = Exporter{m_input.data_root, m_export_prefix, m_gltf_dir, m_root, m_input.force, !m_input.raw_animations};
 	auto const* node = Ptr<gltf2cpp::Node const>{};
 	if (std::ranges::find(m_mesh_list.skinned_meshes, mesh_id) != m_mesh_list.skinned_meshes.end()) {
 		for (auto const& in_node : m_root.nodes) {
@@ -17,6 +17,7 @@ auto main(int argc, char** argv) -> int {
 		.unmatched(meshes, "[mesh]")
 		.flag(list, "l,list", "list (exportable) assets")
 		.flag(input.force, "f,force", "force export (remove existing assets)")
+		.flag(input.raw_animations, "r,raw-animations", "export uncompressed animations")
 		.flag(input.verbose, "v,verbose", "verbose mode");
 
 	auto const result = options.parse(argc, argv);